@@ -6,6 +6,8 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory_resource>
+#include <vector>
 #include "JsonItem.hpp"
 
 namespace Yson
@@ -18,12 +20,21 @@ namespace Yson
     class YSON_API ArrayItem
     {
     public:
-        using iterator = std::vector<JsonItem>::const_iterator;
+        using iterator = std::pmr::vector<JsonItem>::const_iterator;
 
         explicit ArrayItem(std::vector<JsonItem> values);
 
+        explicit ArrayItem(std::pmr::vector<JsonItem> values);
+
+        /**
+         * @brief Returns a copy of the array's values, use pmrValues()
+         *  to avoid the copy.
+         */
+        [[nodiscard]]
+        std::vector<JsonItem> values() const;
+
         [[nodiscard]]
-        const std::vector<JsonItem>& values() const;
+        const std::pmr::vector<JsonItem>& pmrValues() const;
 
         [[nodiscard]] size_t empty() const;
 
@@ -33,6 +44,6 @@ namespace Yson
 
         [[nodiscard]] iterator end() const;
     private:
-        std::vector<JsonItem> m_Values;
+        std::pmr::vector<JsonItem> m_Values;
     };
 }
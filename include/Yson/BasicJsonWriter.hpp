@@ -0,0 +1,594 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <exception>
+#include <limits>
+#include <memory_resource>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include "Writer.hpp"
+#include "YsonException.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief The language extensions that can be enabled in
+     *  BasicJsonWriter.
+     *
+     * The extensions have the same effect, and the same values, as the
+     * corresponding language extensions in JsonWriter. Multiline strings
+     * aren't supported by BasicJsonWriter.
+     */
+    enum JsonExtensions : int
+    {
+        NO_JSON_EXTENSIONS = 0,
+        /// Write NaN, Infinity and -Infinity instead of throwing an
+        /// exception.
+        JSON_NON_FINITE_FLOATS = 1,
+        /// Write non-finite floating point values as strings. Implies
+        /// JSON_NON_FINITE_FLOATS.
+        JSON_QUOTED_NON_FINITE_FLOATS = 2,
+        /// Don't put quotes around keys that are valid JavaScript
+        /// identifiers.
+        JSON_UNQUOTED_VALUE_NAMES = 8,
+        /// Escape all characters outside the ASCII range.
+        JSON_ESCAPE_NON_ASCII_CHARACTERS = 16
+    };
+
+    namespace detail
+    {
+        constexpr size_t BASIC_JSON_WRITER_BUFFER_SIZE = 64 * 1024;
+
+        /**
+         * @brief Returns true for the characters that might have to be
+         *  escaped.
+         *
+         * All non-ASCII characters are included, the escape functions
+         * determine if they actually must be escaped.
+         */
+        constexpr bool mightNeedEscaping(char c)
+        {
+            const auto u = static_cast<unsigned char>(c);
+            return u < 32 || u >= 127 || c == '"' || c == '\\';
+        }
+
+        YSON_API void appendEscaped(std::pmr::string& buffer,
+                                    std::string_view str,
+                                    bool escapeNonAscii);
+
+        YSON_API void appendFloat(std::pmr::string& buffer,
+                                  double value, int precision);
+
+        [[nodiscard]]
+        YSON_API bool isUnquotedKey(std::string_view key);
+
+        [[nodiscard]]
+        YSON_API std::string toUtf8(std::wstring_view str);
+
+        [[nodiscard]]
+        YSON_API std::string toBase64String(const void* data, size_t size);
+    }
+
+    /**
+     * @brief A JSON writer where the formatting and language extensions
+     *  are fixed at compile time.
+     *
+     * BasicJsonWriter produces the same output as a JsonWriter with the
+     * same formatting and language extensions, but it doesn't check
+     * options at runtime and most of its functions are inlined. It is
+     * intended for programs that write large amounts of JSON with a
+     * fixed configuration, JsonWriter remains the writer to use when the
+     * configuration is decided at runtime.
+     *
+     * Unlike JsonWriter, the formatting can't be changed for individual
+     * arrays and objects. beginArray and beginObject throw YsonException
+     * if they are given StructureParameters that ask for a different
+     * formatting or more than one value per line. Indentation is always
+     * two spaces.
+     *
+     * @tparam Formatting JsonFormatting::NONE, JsonFormatting::FLAT or
+     *  JsonFormatting::FORMAT.
+     * @tparam Extensions A combination of the flags in JsonExtensions.
+     */
+    template <JsonFormatting Formatting, int Extensions = NO_JSON_EXTENSIONS>
+    class BasicJsonWriter final : public Writer
+    {
+    public:
+        static_assert(Formatting != JsonFormatting::DEFAULT,
+                      "BasicJsonWriter needs an explicit formatting.");
+        static_assert((Extensions & ~(JSON_NON_FINITE_FLOATS
+                                      | JSON_QUOTED_NON_FINITE_FLOATS
+                                      | JSON_UNQUOTED_VALUE_NAMES
+                                      | JSON_ESCAPE_NON_ASCII_CHARACTERS))
+                      == 0,
+                      "BasicJsonWriter doesn't support these extensions.");
+
+        /**
+         * @brief Creates a writer that writes to an internal buffer.
+         *
+         * @param memoryResource The memory resource the writer allocates
+         *  its buffer and internal state from. nullptr means
+         *  std::pmr::get_default_resource().
+         */
+        explicit BasicJsonWriter(
+                std::pmr::memory_resource* memoryResource = nullptr)
+            : m_Buffer(getResource(memoryResource)),
+              m_Scopes(getResource(memoryResource))
+        {}
+
+        /**
+         * @brief Creates a writer that writes to @a stream.
+         */
+        explicit BasicJsonWriter(
+                std::ostream& stream,
+                std::pmr::memory_resource* memoryResource = nullptr)
+            : BasicJsonWriter(memoryResource)
+        {
+            m_Stream = &stream;
+            m_Buffer.reserve(detail::BASIC_JSON_WRITER_BUFFER_SIZE);
+        }
+
+        BasicJsonWriter(const BasicJsonWriter&) = delete;
+
+        BasicJsonWriter& operator=(const BasicJsonWriter&) = delete;
+
+        ~BasicJsonWriter() override
+        {
+            BasicJsonWriter::flush();
+        }
+
+        std::ostream* stream() override
+        {
+            flush();
+            return m_Stream;
+        }
+
+        [[nodiscard]]
+        std::pair<const void*, size_t> buffer() const override
+        {
+            if (m_Stream)
+                return {nullptr, 0};
+            return {m_Buffer.data(), m_Buffer.size()};
+        }
+
+        /**
+         * @brief Returns a copy of the current buffer as a string.
+         *
+         * This function returns an empty string if the writer writes to a
+         * stream.
+         */
+        [[nodiscard]]
+        std::string str() const
+        {
+            return std::string(pmrStr());
+        }
+
+        /**
+         * @brief Returns the current buffer, allocated from the writer's
+         *  memory resource.
+         *
+         * This function returns an empty string if the writer writes to a
+         * stream.
+         */
+        [[nodiscard]]
+        const std::pmr::string& pmrStr() const
+        {
+            static const std::pmr::string EMPTY;
+            if (m_Stream)
+                return EMPTY;
+            return m_Buffer;
+        }
+
+        [[nodiscard]]
+        const std::string& key() const override
+        {
+            return m_Key;
+        }
+
+        BasicJsonWriter& key(std::string key) override
+        {
+            for (auto c : key)
+            {
+                if (detail::mightNeedEscaping(c))
+                {
+                    std::pmr::string escaped;
+                    detail::appendEscaped(escaped, key, ESCAPE_NON_ASCII);
+                    m_Key.assign(escaped);
+                    return *this;
+                }
+            }
+            m_Key = std::move(key);
+            return *this;
+        }
+
+        BasicJsonWriter& beginArray() override
+        {
+            return beginStructure('[', ']');
+        }
+
+        BasicJsonWriter& beginArray(
+                const StructureParameters& parameters) override
+        {
+            checkParameters(parameters.jsonParameters);
+            return beginStructure('[', ']');
+        }
+
+        BasicJsonWriter& endArray() override
+        {
+            return endStructure(']');
+        }
+
+        BasicJsonWriter& beginObject() override
+        {
+            return beginStructure('{', '}');
+        }
+
+        BasicJsonWriter& beginObject(
+                const StructureParameters& parameters) override
+        {
+            checkParameters(parameters.jsonParameters);
+            return beginStructure('{', '}');
+        }
+
+        BasicJsonWriter& endObject() override
+        {
+            return endStructure('}');
+        }
+
+        BasicJsonWriter& null() override
+        {
+            return rawValue("null");
+        }
+
+        BasicJsonWriter& boolean(bool value) override
+        {
+            return rawValue(value ? "true" : "false");
+        }
+
+        BasicJsonWriter& value(char value) override
+        {
+            return writeInteger(int(value));
+        }
+
+        BasicJsonWriter& value(signed char value) override
+        {
+            return writeInteger(int(value));
+        }
+
+        BasicJsonWriter& value(short value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(int value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(long value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(long long value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(unsigned char value) override
+        {
+            return writeInteger(unsigned(value));
+        }
+
+        BasicJsonWriter& value(unsigned short value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(unsigned value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(unsigned long value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(unsigned long long value) override
+        {
+            return writeInteger(value);
+        }
+
+        BasicJsonWriter& value(float value) override
+        {
+            return writeFloat(value);
+        }
+
+        BasicJsonWriter& value(double value) override
+        {
+            return writeFloat(value);
+        }
+
+        BasicJsonWriter& value(std::string_view value) override
+        {
+            beginValue();
+            m_Buffer.push_back('"');
+            appendString(value);
+            m_Buffer.push_back('"');
+            return endValue();
+        }
+
+        BasicJsonWriter& value(std::wstring_view value) override
+        {
+            return BasicJsonWriter::value(
+                std::string_view(detail::toUtf8(value)));
+        }
+
+        /**
+         * @brief Writes @a data encoded as BASE64.
+         */
+        BasicJsonWriter& binary(const void* data, size_t size) override
+        {
+            return base64(data, size);
+        }
+
+        BasicJsonWriter& base64(const void* data, size_t size) override
+        {
+            beginValue();
+            m_Buffer.push_back('"');
+            m_Buffer.append(detail::toBase64String(data, size));
+            m_Buffer.push_back('"');
+            return endValue();
+        }
+
+        /**
+         * @brief Writes @a value as-is, without quotation marks or
+         *  escaped characters.
+         */
+        BasicJsonWriter& rawValue(std::string_view value)
+        {
+            beginValue();
+            m_Buffer.append(value);
+            return endValue();
+        }
+
+        BasicJsonWriter& write(const JsonItem& item) override
+        {
+            Writer::write(item);
+            return *this;
+        }
+
+        /**
+         * @brief Returns the floating point precision.
+         */
+        [[nodiscard]]
+        int floatingPointPrecision() const
+        {
+            return m_FloatingPointPrecision;
+        }
+
+        /**
+         * @brief Sets the floating point precision.
+         */
+        BasicJsonWriter& setFloatingPointPrecision(int value)
+        {
+            m_FloatingPointPrecision = std::max(value, 1);
+            return *this;
+        }
+
+        BasicJsonWriter& flush() override
+        {
+            if (m_Stream && !m_Buffer.empty())
+            {
+                m_Stream->write(m_Buffer.data(),
+                                std::streamsize(m_Buffer.size()));
+                m_Buffer.clear();
+            }
+            return *this;
+        }
+    private:
+        static constexpr bool ESCAPE_NON_ASCII =
+            (Extensions & JSON_ESCAPE_NON_ASCII_CHARACTERS) != 0;
+
+        static std::pmr::memory_resource*
+        getResource(std::pmr::memory_resource* resource)
+        {
+            return resource ? resource : std::pmr::get_default_resource();
+        }
+
+        static void checkParameters(const JsonParameters& parameters)
+        {
+            if (parameters.formatting != JsonFormatting::DEFAULT
+                && parameters.formatting != Formatting)
+            {
+                YSON_THROW("BasicJsonWriter can't change the formatting"
+                           " of individual arrays and objects.");
+            }
+            if (parameters.valuesPerLine > 1)
+            {
+                YSON_THROW("BasicJsonWriter doesn't support multiple"
+                           " values per line.");
+            }
+        }
+
+        void writeIndentation()
+        {
+            m_Buffer.append(m_Scopes.size() * 2, ' ');
+        }
+
+        void beginValue()
+        {
+            if (m_HasValues)
+            {
+                if constexpr (Formatting == JsonFormatting::NONE)
+                {
+                    m_Buffer.push_back(',');
+                }
+                else if constexpr (Formatting == JsonFormatting::FLAT)
+                {
+                    m_Buffer.append(", ");
+                }
+                else
+                {
+                    m_Buffer.append(",\n");
+                    writeIndentation();
+                }
+            }
+            else if constexpr (Formatting == JsonFormatting::FORMAT)
+            {
+                if (!m_Scopes.empty())
+                {
+                    m_Buffer.push_back('\n');
+                    writeIndentation();
+                }
+            }
+
+            if (!m_Scopes.empty() && m_Scopes.back() == '}')
+                writeKey();
+        }
+
+        void writeKey()
+        {
+            if constexpr ((Extensions & JSON_UNQUOTED_VALUE_NAMES) != 0)
+            {
+                if (detail::isUnquotedKey(m_Key))
+                {
+                    m_Buffer.append(m_Key);
+                    m_Buffer.push_back(':');
+                    if constexpr (Formatting != JsonFormatting::NONE)
+                        m_Buffer.push_back(' ');
+                    return;
+                }
+            }
+
+            m_Buffer.push_back('"');
+            m_Buffer.append(m_Key);
+            m_Buffer.append("\":");
+            if constexpr (Formatting != JsonFormatting::NONE)
+                m_Buffer.push_back(' ');
+        }
+
+        BasicJsonWriter& endValue()
+        {
+            m_HasValues = true;
+            if (m_Stream
+                && m_Buffer.size() >= detail::BASIC_JSON_WRITER_BUFFER_SIZE)
+            {
+                flush();
+            }
+            return *this;
+        }
+
+        void appendString(std::string_view str)
+        {
+            for (auto c : str)
+            {
+                if (detail::mightNeedEscaping(c))
+                {
+                    detail::appendEscaped(m_Buffer, str, ESCAPE_NON_ASCII);
+                    return;
+                }
+            }
+            m_Buffer.append(str);
+        }
+
+        BasicJsonWriter& beginStructure(char startChar, char endChar)
+        {
+            beginValue();
+            m_Buffer.push_back(startChar);
+            m_Scopes.push_back(endChar);
+            m_HasValues = false;
+            return *this;
+        }
+
+        BasicJsonWriter& endStructure(char endChar)
+        {
+            if (m_Scopes.empty() || m_Scopes.back() != endChar)
+            {
+                // See JsonWriter::endStructure.
+                if (std::uncaught_exceptions())
+                    return *this;
+
+                YSON_THROW(std::string("Incorrect position for '")
+                    + endChar + "'");
+            }
+
+            m_Scopes.pop_back();
+            if constexpr (Formatting == JsonFormatting::FORMAT)
+            {
+                if (m_HasValues)
+                {
+                    m_Buffer.push_back('\n');
+                    writeIndentation();
+                }
+            }
+            m_Buffer.push_back(endChar);
+            return endValue();
+        }
+
+        template <typename T>
+        BasicJsonWriter& writeInteger(T number)
+        {
+            beginValue();
+            char buffer[24];
+            auto result = std::to_chars(std::begin(buffer), std::end(buffer),
+                                        number);
+            m_Buffer.append(buffer, result.ptr);
+            return endValue();
+        }
+
+        template <typename T>
+        BasicJsonWriter& writeFloat(T number)
+        {
+            if (std::isfinite(number))
+            {
+                beginValue();
+                detail::appendFloat(
+                    m_Buffer, number,
+                    std::min(m_FloatingPointPrecision,
+                             std::numeric_limits<T>::digits10));
+                return endValue();
+            }
+
+            constexpr auto NON_FINITE = JSON_NON_FINITE_FLOATS
+                                        | JSON_QUOTED_NON_FINITE_FLOATS;
+            if constexpr ((Extensions & NON_FINITE) == 0)
+            {
+                YSON_THROW(std::string("Illegal floating point value '")
+                    + std::to_string(number) + "'");
+            }
+            else
+            {
+                std::string_view text = std::isnan(number) ? "NaN"
+                                        : number < 0 ? "-Infinity"
+                                        : "Infinity";
+                if constexpr ((Extensions & JSON_QUOTED_NON_FINITE_FLOATS) != 0)
+                    return BasicJsonWriter::value(text);
+                else
+                    return rawValue(text);
+            }
+        }
+
+        std::pmr::string m_Buffer;
+        std::pmr::string m_Scopes;
+        std::string m_Key;
+        std::ostream* m_Stream = nullptr;
+        int m_FloatingPointPrecision = 9;
+        bool m_HasValues = false;
+    };
+
+    /**
+     * @brief A JSON writer without any whitespace or language extensions.
+     */
+    using CompactJsonWriter = BasicJsonWriter<JsonFormatting::NONE>;
+}
@@ -0,0 +1,62 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <iosfwd>
+#include <memory>
+#include "YsonDefinitions.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief The compression formats the readers and writers can handle
+     *  transparently.
+     *
+     * GZIP and ZLIB require that Yson is built with zlib, ZSTD requires
+     * that it is built with zstd. Use isCompressionSupported to check.
+     */
+    enum class Compression
+    {
+        /// The input or output is not compressed.
+        NONE,
+        /// Determine the compression from the first bytes of the input.
+        AUTO,
+        GZIP,
+        ZLIB,
+        ZSTD
+    };
+
+    /**
+     * @brief Returns true if this build of Yson can read and write
+     *  @a compression.
+     *
+     * Always returns true for NONE and AUTO.
+     */
+    [[nodiscard]]
+    YSON_API bool isCompressionSupported(Compression compression);
+
+    /**
+     * @brief Returns a stream that compresses everything that is written
+     *  to it and writes the result to @a stream.
+     *
+     * The compressed data is completed when the returned stream is
+     * destroyed, it must therefore be destroyed after the writer that
+     * uses it has been flushed or destroyed.
+     *
+     * The JsonWriter and UBJsonWriter constructors that take a file name
+     * use this function automatically when the file name ends with
+     * ".gz" (GZIP), ".zz" (ZLIB) or ".zst" (ZSTD).
+     *
+     * @param compression GZIP, ZLIB or ZSTD.
+     * @param level The compression level, or -1 for the format's
+     *  default level.
+     * @throw YsonException if @a compression isn't supported.
+     */
+    YSON_API std::unique_ptr<std::ostream>
+    makeCompressingStream(std::ostream& stream, Compression compression,
+                          int level = -1);
+}
@@ -0,0 +1,108 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <string>
+#include "JsonWriter.hpp"
+#include "UBJsonWriter.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief Assembles an array or object from fragments that are written
+     *  independently, e.g. by different threads.
+     *
+     * Each fragment is a single array element or object member value,
+     * written with its own writer to its own buffer. When all fragments
+     * have been written, writeArray or writeObject writes them in index
+     * order to the target writer, with the commas and indentation of the
+     * target's formatting, or the container count for UBJSON.
+     *
+     * @code
+     *  FragmentWriter fragments(writer, values.size());
+     *  // Can run in parallel.
+     *  for (size_t i = 0; i < values.size(); ++i)
+     *      writeValue(fragments.fragment(i), values[i]);
+     *  fragments.writeArray();
+     * @endcode
+     *
+     * fragment() can be called concurrently for different indexes, and
+     * the writers it returns can be used concurrently. All other functions
+     * must be called from one thread after the fragments are finished.
+     */
+    class YSON_API FragmentWriter
+    {
+    public:
+        /**
+         * @brief Creates a FragmentWriter that writes to @a writer.
+         *
+         * The fragment writers get the formatting, indentation and
+         * language extensions that values in a new array or object at
+         * @a writer's current position have.
+         */
+        FragmentWriter(JsonWriter& writer, size_t fragmentCount);
+
+        /**
+         * @brief Creates a FragmentWriter that writes to @a writer.
+         */
+        FragmentWriter(UBJsonWriter& writer, size_t fragmentCount);
+
+        FragmentWriter(const FragmentWriter&) = delete;
+
+        FragmentWriter(FragmentWriter&&) noexcept;
+
+        ~FragmentWriter();
+
+        FragmentWriter& operator=(const FragmentWriter&) = delete;
+
+        FragmentWriter& operator=(FragmentWriter&&) noexcept;
+
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Returns the writer for the fragment at @a index.
+         *
+         * The writer is created the first time the fragment is requested.
+         * Exactly one value must be written to it.
+         */
+        Writer& fragment(size_t index);
+
+        /**
+         * @brief Returns the writer for the fragment at @a index and sets
+         *  the key the fragment gets when it is written as an object
+         *  member.
+         */
+        Writer& fragment(size_t index, std::string key);
+
+        /**
+         * @brief Writes the fragments as the elements of an array.
+         *
+         * @throws YsonException if a fragment is missing, empty or
+         *  doesn't contain exactly one complete value. Nothing is
+         *  written in that case.
+         */
+        Writer& writeArray();
+
+        /**
+         * @brief Writes the fragments as the members of an object, using
+         *  the keys given to fragment().
+         *
+         * @throws YsonException if a fragment is missing, empty or
+         *  doesn't contain exactly one complete value. Nothing is
+         *  written in that case.
+         */
+        Writer& writeObject();
+    private:
+        struct Members;
+
+        Writer& writeStructure(bool isObject);
+
+        std::unique_ptr<Members> m_Members;
+    };
+}
@@ -8,9 +8,13 @@
 #pragma once
 
 #include "Reader.hpp"
+#include "ReaderOptions.hpp"
 
 #include <iosfwd>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
 #include "JsonItem.hpp"
 
 namespace Yson
@@ -31,15 +35,19 @@ namespace Yson
     public:
         JsonReader();
 
-        explicit JsonReader(std::istream& stream);
+        explicit JsonReader(std::istream& stream,
+                            const ReaderOptions& options = {});
 
-        explicit JsonReader(const std::filesystem::path& fileName);
+        explicit JsonReader(const std::filesystem::path& fileName,
+                            const ReaderOptions& options = {});
 
-        JsonReader(const char* buffer, size_t bufferSize);
+        JsonReader(const char* buffer, size_t bufferSize,
+                   const ReaderOptions& options = {});
 
         JsonReader(std::istream& stream,
                    const char* buffer,
-                   size_t bufferSize);
+                   size_t bufferSize,
+                   const ReaderOptions& options = {});
 
         JsonReader(const JsonReader&) = delete;
 
@@ -51,6 +59,72 @@ namespace Yson
 
         JsonReader& operator=(JsonReader&&) noexcept;
 
+        /**
+         * @brief Creates a reader in push mode, where the input is
+         *  supplied with feed() as it becomes available.
+         *
+         * When a push mode reader runs out of input, nextValue(),
+         * nextKey(), nextDocument() and readArray() return false and
+         * needsMoreData() returns true. leave() returns without leaving.
+         * Either way the reader is left as it was before the call, which
+         * can be repeated once more data has been fed. tryReadItem()
+         * returns std::nullopt, but keeps the part of the item it has
+         * already read (readItem() does the same, but throws). A token
+         * that arrives in several pieces is scanned incrementally, it
+         * isn't scanned from its start again when a call is repeated.
+         * Call finishFeed() after the final feed() to make the reader
+         * treat the end of the data as the end of the input.
+         *
+         * Multiline strings are not supported in push mode.
+         */
+        explicit JsonReader(const ReaderOptions& options);
+
+        /**
+         * @brief Prepares the reader for reading a new document from
+         *  @a buffer.
+         *
+         * The reader's internal buffers and other storage are reused,
+         * making this considerably cheaper than constructing a new reader
+         * when many small documents are to be read.
+         */
+        void reset(const char* buffer, size_t bufferSize);
+
+        /**
+         * @brief Prepares the reader for reading a new document from
+         *  @a stream.
+         *
+         * The reader's internal buffers and other storage are reused.
+         */
+        void reset(std::istream& stream);
+
+        /**
+         * @brief Prepares the reader for reading a new document in
+         *  push mode.
+         */
+        void reset();
+
+        /**
+         * @brief Adds @a size bytes from @a data to the input of a reader
+         *  in push mode.
+         *
+         * The data is copied and @a data can be discarded as soon as the
+         * function returns.
+         */
+        void feed(const char* data, size_t size);
+
+        /**
+         * @brief Tells a reader in push mode that there is no more data.
+         */
+        void finishFeed();
+
+        /**
+         * @brief Returns true if the previous call to nextValue(),
+         *  nextKey(), nextDocument(), leave(), readArray(), readItem() or
+         *  tryReadItem() failed because the reader needs more data.
+         */
+        [[nodiscard]]
+        bool needsMoreData() const;
+
         bool nextDocument() override;
 
         bool nextKey() override;
@@ -115,8 +189,144 @@ namespace Yson
 
         bool readBinary(void* buffer, size_t& size) override;
 
+        /**
+         * @brief Reads the current string in chunks.
+         *
+         * Makes it possible to read strings that are too large to be kept
+         * in memory. Strings that are longer than ReaderOptions::chunkSize
+         * are read from the input one chunk at a time, and each call sets
+         * @a chunk to the unescaped contents of the next chunk. Shorter
+         * strings are read as a single chunk. Skipping a long string with
+         * nextValue or nextKey doesn't read all of it into memory either.
+         *
+         * Once a string has been read in chunks, it can't be read with any
+         * of the other read functions.
+         *
+         * @return false if the entire string has been read, or the
+         *  current token isn't a string or a value.
+         */
+        bool readStringChunk(std::string& chunk);
+
+        /**
+         * @brief Reads the current base64-encoded string in chunks and
+         *  sets @a chunk to the decoded bytes of the next chunk.
+         *
+         * @see readStringChunk
+         */
+        bool readBase64Chunk(std::vector<char>& chunk);
+
+        /**
+         * @brief Calls @a callback with a std::string_view of each chunk
+         *  of the current string.
+         *
+         * @see readStringChunk
+         * @return false if the current token isn't a string or a value.
+         */
+        template <typename Callback>
+        bool readStringChunks(Callback callback)
+        {
+            assertStateIsKeyOrValue();
+            if (!currentTokenIsValueOrString())
+                return false;
+            std::string chunk;
+            while (readStringChunk(chunk))
+                callback(std::string_view(chunk));
+            return true;
+        }
+
+        /**
+         * @brief Calls @a callback with a std::span<const char> of the
+         *  decoded bytes of each chunk of the current base64-encoded
+         *  string.
+         *
+         * @see readStringChunk
+         * @return false if the current token isn't a string.
+         */
+        template <typename Callback>
+        bool readBase64Chunks(Callback callback)
+        {
+            assertStateIsKeyOrValue();
+            if (!currentTokenIsString())
+                return false;
+            std::vector<char> chunk;
+            while (readBase64Chunk(chunk))
+                callback(std::span<const char>(chunk));
+            return true;
+        }
+
+        /**
+         * @brief Reads all the values in the array at the current position.
+         *
+         * The array is entered, its values are parsed in a single loop
+         * without the per-value overhead of nextValue() and read(), and
+         * the array is left again. @a values is cleared first, also
+         * when the current value isn't an array.
+         *
+         * @throw YsonException if the reader isn't at a value.
+         * @return false if the current value isn't an array, or if one
+         *  of its values isn't a number that fits in the value type. In
+         *  the latter case @a values contains the values that preceded
+         *  the failing value, and the reader is left inside the array
+         *  with the failing value as its current value, making it
+         *  possible to continue with nextValue() and read() and
+         *  eventually call leave().
+         */
+        bool readArray(std::vector<int32_t>& values);
+
+        bool readArray(std::vector<int64_t>& values);
+
+        bool readArray(std::vector<uint32_t>& values);
+
+        bool readArray(std::vector<uint64_t>& values);
+
+        bool readArray(std::vector<float>& values);
+
+        bool readArray(std::vector<double>& values);
+
+        /**
+         * @brief Reads all the values in the array at the current position
+         *  into @a buffer.
+         *
+         * Takes a pointer and an in-out size rather than a std::span to
+         * match UBJsonReader::readOptimizedArray, and because the number
+         * of values read has to be returned also when the function
+         * fails.
+         *
+         * @param size Must be set to the number of values that fit in
+         *  @a buffer. It is set to the number of values that were read.
+         * @return false if the current value isn't an array, if one of its
+         *  values isn't a number, or if @a buffer is too small. Like the
+         *  vector version, the reader is then left inside the array with
+         *  the first value that wasn't read as its current value.
+         */
+        bool readArray(int32_t* buffer, size_t& size);
+
+        bool readArray(int64_t* buffer, size_t& size);
+
+        bool readArray(uint32_t* buffer, size_t& size);
+
+        bool readArray(uint64_t* buffer, size_t& size);
+
+        bool readArray(float* buffer, size_t& size);
+
+        bool readArray(double* buffer, size_t& size);
+
         JsonItem readItem() override;
 
+        /**
+         * @brief Reads the current item like readItem(), but returns
+         *  std::nullopt instead of throwing when a reader in push mode
+         *  needs more data.
+         *
+         * The part of the item that has already been read is kept by the
+         * reader, and the next call to tryReadItem() or readItem()
+         * continues where this one stopped. No other function may be
+         * called on the reader in between, except feed() and
+         * finishFeed().
+         */
+        [[nodiscard]]
+        std::optional<JsonItem> tryReadItem();
+
         [[nodiscard]]
         std::string fileName() const override;
 
@@ -144,10 +354,7 @@ namespace Yson
         bool currentTokenIsValue() const;
 
         [[nodiscard]]
-        JsonItem readArray();
-
-        [[nodiscard]]
-        JsonItem readObject();
+        std::optional<JsonItem> readItemImpl();
 
         template <typename T>
         bool readInteger(T& value) const;
@@ -155,6 +362,21 @@ namespace Yson
         template <typename T>
         bool readFloatingPoint(T& value) const;
 
+        [[nodiscard]]
+        bool enterNumericArray();
+
+        [[nodiscard]]
+        bool nextNumericArrayValue();
+
+        template <typename T>
+        bool readArrayImpl(std::vector<T>& values);
+
+        template <typename T>
+        bool readArrayImpl(T* buffer, size_t& size);
+
+        template <typename Func>
+        bool resumable(Func func);
+
         struct Members;
         std::unique_ptr<Members> m_Members;
     };
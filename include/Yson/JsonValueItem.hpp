@@ -6,23 +6,33 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory_resource>
 #include "ValueItem.hpp"
 
 namespace Yson
 {
-    enum class JsonTokenType;
+    enum class JsonTokenType : char;
 
     /**
      * @brief A class holding JSON values, as opposed to objects and arrays.
      *
      * This is one of the four types of items that are the constituents of
      * JsonItem.
+     *
+     * Numbers are parsed and strings are unescaped when the item is
+     * created, so reading the same item repeatedly doesn't parse it
+     * again. The price is a slower readItem() and eight more bytes per
+     * item for the decoded number. Strings with invalid escape sequences
+     * are kept as they are, and reading them as strings or chars throws
+     * YsonException.
      */
     class YSON_API JsonValueItem : public ValueItem
     {
     public:
         JsonValueItem(std::string value, JsonTokenType tokenType);
 
+        JsonValueItem(std::pmr::string value, JsonTokenType tokenType);
+
         [[nodiscard]]
         ValueType valueType() const final;
 
@@ -66,7 +76,37 @@ namespace Yson
 
         bool getBinary(void* buffer, size_t& size) const final;
     private:
-        std::string m_Value;
+        friend class JsonWriter;
+
+        enum class NumberType : uint8_t
+        {
+            NONE,
+            INT64,
+            UINT64,
+            DOUBLE
+        };
+
+        template <typename T>
+        bool getInteger(T& value) const;
+
+        template <typename T>
+        bool getFloatingPoint(T& value) const;
+
+        std::pmr::string m_Value;
+        union
+        {
+            int64_t m_Int64 = 0;
+            uint64_t m_UInt64;
+            double m_Double;
+        };
+        // The members below fit in the eight bytes after the union.
+        ValueType m_ValueType = ValueType::INVALID;
         JsonTokenType m_Type;
+        NumberType m_NumberType = NumberType::NONE;
+        // True if m_Value is an integer in base 10, which means that
+        // converting m_Int64 or m_UInt64 to a floating point value gives
+        // the same result as parsing m_Value.
+        bool m_IsDecimalInteger = false;
+        bool m_HasInvalidEscapes = false;
     };
 }
@@ -10,8 +10,11 @@
 #include <filesystem>
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
 #include "Writer.hpp"
+#include "WriterStats.hpp"
 
 namespace Yson
 {
@@ -27,26 +30,42 @@ namespace Yson
          * The buffer can be retrieved with the buffer() function.
          *
          * @param formatting the automatic formatting that will be used.
+         * @param memoryResource The memory resource the writer allocates
+         *  its buffer and internal state from. nullptr means
+         *  std::pmr::get_default_resource().
          */
-        explicit JsonWriter(JsonFormatting formatting = JsonFormatting::FORMAT);
+        explicit JsonWriter(JsonFormatting formatting = JsonFormatting::FORMAT,
+                            std::pmr::memory_resource* memoryResource = nullptr);
 
         /**
          * @brief Creates a JSON writer that creates and writes to a file
          *      named @a fileName.
+         *
+         * The output is compressed if the file name ends with ".gz",
+         * ".zz" or ".zst", see makeCompressingStream.
+         *
          * @param fileName The UTF-8 encoded name of the file.
          * @param formatting the automatic formatting that will be used.
+         * @param memoryResource The memory resource the writer allocates
+         *  its buffer and internal state from. nullptr means
+         *  std::pmr::get_default_resource().
          */
         explicit JsonWriter(const std::filesystem::path& fileName,
-                            JsonFormatting formatting = JsonFormatting::FORMAT);
+                            JsonFormatting formatting = JsonFormatting::FORMAT,
+                            std::pmr::memory_resource* memoryResource = nullptr);
 
         /**
          * @brief Creates a JSON writer that writes to the specified stream.
          *
          * @param stream The stream to write to.
          * @param formatting the automatic formatting that will be used.
+         * @param memoryResource The memory resource the writer allocates
+         *  its buffer and internal state from. nullptr means
+         *  std::pmr::get_default_resource().
          */
         explicit JsonWriter(std::ostream& stream,
-                            JsonFormatting formatting = JsonFormatting::FORMAT);
+                            JsonFormatting formatting = JsonFormatting::FORMAT,
+                            std::pmr::memory_resource* memoryResource = nullptr);
 
         ~JsonWriter() override;
 
@@ -234,6 +253,17 @@ namespace Yson
          */
         JsonWriter& rawValue(std::string_view value);
 
+        /**
+         * @brief Writes @a item, including the values in any arrays and
+         *  objects it contains.
+         *
+         * Numbers, true, false and null read by JsonReader are written
+         * as they appeared in the input if they are valid JSON. Strings
+         * are only escaped if they contain characters that must be
+         * escaped.
+         */
+        JsonWriter& write(const JsonItem& item) override;
+
         ///@}
 
         /**
@@ -259,13 +289,23 @@ namespace Yson
         std::pair<const void*, size_t> buffer() const override;
 
         /**
-         * @brief Returns the current buffer as a string.
+         * @brief Returns a copy of the current buffer as a string.
+         *
+         * This function returns an empty string if the writer writes to a
+         * stream.
+         */
+        [[nodiscard]]
+        std::string str() const;
+
+        /**
+         * @brief Returns the current buffer, allocated from the writer's
+         *  memory resource.
          *
          * This function returns an empty string if the writer writes to a
          * stream.
          */
         [[nodiscard]]
-        const std::string& str() const;
+        const std::pmr::string& pmrStr() const;
 
         /**
          * @brief Flushes the internal buffer to the stream if there
@@ -276,6 +316,20 @@ namespace Yson
          */
         JsonWriter& flush() override;
 
+        /**
+         * @brief Returns the counters set with setStats, or nullptr.
+         */
+        [[nodiscard]]
+        WriterStats* stats() const;
+
+        /**
+         * @brief Makes the writer update the counters in @a stats.
+         *
+         * The writer doesn't take ownership of @a stats. Pass nullptr
+         * to stop updating the counters.
+         */
+        JsonWriter& setStats(WriterStats* stats);
+
         ///@}
 
         /**
@@ -518,12 +572,26 @@ namespace Yson
         JsonWriter& setFormattingEnabled(bool value);
 
         ///@}
+    protected:
+        void writeValueItem(const ValueItem& item) override;
     private:
+        friend class FragmentWriter;
+
         struct Members;
 
         [[nodiscard]]
         Members& members() const;
 
+        [[nodiscard]]
+        std::unique_ptr<JsonWriter> makeFragmentWriter() const;
+
+        /**
+         * @brief Returns true if exactly one value has been written and
+         *  all arrays and objects have been closed.
+         */
+        [[nodiscard]]
+        bool isCompleteFragment() const;
+
         void write(std::string_view s);
 
         void write(const char* s, size_t size);
@@ -534,7 +602,8 @@ namespace Yson
 
         JsonWriter(std::unique_ptr<std::ostream> streamPtr,
                    std::ostream* stream,
-                   JsonFormatting formatting = JsonFormatting::NONE);
+                   JsonFormatting formatting,
+                   std::pmr::memory_resource* memoryResource);
 
         void beginValue();
 
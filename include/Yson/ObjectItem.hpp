@@ -7,6 +7,8 @@
 //****************************************************************************
 #pragma once
 #include <deque>
+#include <memory_resource>
+#include <string>
 #include <unordered_map>
 #include "JsonItem.hpp"
 
@@ -15,16 +17,41 @@ namespace Yson
     class YSON_API ObjectItem
     {
     public:
-        using iterator = std::unordered_map<std::string_view, JsonItem>::const_iterator;
+        using iterator = std::pmr::unordered_map<std::string_view, JsonItem>::const_iterator;
 
+        /**
+         * @brief Creates an object with the values in @a values, whose
+         *  keys refer to the strings in @a keys.
+         */
         ObjectItem(std::deque<std::string> keys,
                    std::unordered_map<std::string_view, JsonItem> values);
 
+        ObjectItem(std::pmr::deque<std::pmr::string> keys,
+                   std::pmr::unordered_map<std::string_view, JsonItem> values);
+
+        /**
+         * @brief Returns a copy of the object's keys in the order they
+         *  appeared in the input, use pmrKeys() to avoid the copy.
+         */
+        [[nodiscard]]
+        std::deque<std::string> keys() const;
+
+        [[nodiscard]]
+        const std::pmr::deque<std::pmr::string>& pmrKeys() const;
+
+        /**
+         * @brief Returns a copy of the object's values, use pmrValues()
+         *  to avoid the copy.
+         *
+         * The keys in the returned map refer to the strings in the
+         * object, not in the map.
+         */
         [[nodiscard]]
-        const std::deque<std::string>& keys() const;
+        std::unordered_map<std::string_view, JsonItem> values() const;
 
         [[nodiscard]]
-        const std::unordered_map<std::string_view, JsonItem>& values() const;
+        const std::pmr::unordered_map<std::string_view, JsonItem>&
+        pmrValues() const;
 
         [[nodiscard]] size_t empty() const;
 
@@ -34,7 +61,7 @@ namespace Yson
 
         [[nodiscard]] iterator end() const;
     private:
-        std::deque<std::string> m_Keys;
-        std::unordered_map<std::string_view, JsonItem> m_Values;
+        std::pmr::deque<std::pmr::string> m_Keys;
+        std::pmr::unordered_map<std::string_view, JsonItem> m_Values;
     };
 }
@@ -15,6 +15,7 @@
 #include "DetailedValueType.hpp"
 #include "JsonItem.hpp"
 #include "ObjectItem.hpp"
+#include "ReaderOptions.hpp"
 #include "ReaderState.hpp"
 #include "ValueType.hpp"
 #include "YsonReaderException.hpp"
@@ -148,23 +149,27 @@ namespace Yson
      *      creates the corresponding instance of Reader.
      * @param stream a stream positioned at the start of a JSON or UBJSON
      *      document.
+     * @param options options that are passed on to the created reader.
      * @return an instance of either JsonReader or UBJsonReader.
      * @throws YsonException if @a stream contains neither JSON nor UBJSON.
      */
     YSON_API std::unique_ptr<Reader>
-    makeReader(std::istream& stream);
+    makeReader(std::istream& stream, const ReaderOptions& options = {});
 
     /**
      * @brief Auto-detects whether @a fileName has JSON or UBJSON contents and
      *      creates the corresponding instance of Reader.
      * @param fileName the name of file.
+     * @param options options that are passed on to the created reader.
      * @return an instance of either JsonReader or UBJsonReader.
      * @throws YsonException if the given file contains neither JSON
      *      nor UBJSON.
      */
     YSON_API std::unique_ptr<Reader>
-    makeReader(const std::filesystem::path& fileName);
+    makeReader(const std::filesystem::path& fileName,
+               const ReaderOptions& options = {});
 
     YSON_API std::unique_ptr<Reader>
-    makeReader(const char* buffer, size_t bufferSize);
+    makeReader(const char* buffer, size_t bufferSize,
+               const ReaderOptions& options = {});
 }
@@ -0,0 +1,428 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include "JsonReader.hpp"
+#include "ReaderIterators.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief A lazy, single-pass range of values produced by a coroutine.
+     *
+     * Each increment of the iterator resumes the coroutine until it
+     * yields its next value. Exceptions thrown by the coroutine are
+     * rethrown from begin() or operator++.
+     *
+     * @tparam T The type of the values. If T is a reference type the
+     *  generator yields references, otherwise it yields const references
+     *  to values that are valid until the iterator is incremented.
+     */
+    template <typename T>
+    class Generator
+    {
+    public:
+        using value_type = std::remove_cvref_t<T>;
+        using reference = std::conditional_t<std::is_reference_v<T>,
+                                             T, const value_type&>;
+        using pointer = std::add_pointer_t<reference>;
+
+        struct promise_type
+        {
+            pointer value = nullptr;
+            std::exception_ptr exception;
+
+            Generator get_return_object()
+            {
+                return Generator(Handle::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always final_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_always yield_value(reference v) noexcept
+            {
+                value = std::addressof(v);
+                return {};
+            }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception()
+            {
+                exception = std::current_exception();
+            }
+
+            /// Generators are synchronous, use AsyncGenerator to await
+            /// input.
+            template <typename U>
+            std::suspend_never await_transform(U&&) = delete;
+        };
+
+        using Handle = std::coroutine_handle<promise_type>;
+
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Generator::value_type;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Generator::pointer;
+            using reference = Generator::reference;
+
+            iterator() = default;
+
+            explicit iterator(Handle handle)
+                : m_Handle(handle)
+            {}
+
+            [[nodiscard]]
+            reference operator*() const
+            {
+                return static_cast<reference>(*m_Handle.promise().value);
+            }
+
+            [[nodiscard]]
+            pointer operator->() const
+            {
+                return m_Handle.promise().value;
+            }
+
+            iterator& operator++()
+            {
+                m_Handle.resume();
+                Generator::rethrow(m_Handle);
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            friend bool operator==(const iterator& it,
+                                   std::default_sentinel_t)
+            {
+                return !it.m_Handle || it.m_Handle.done();
+            }
+        private:
+            Handle m_Handle;
+        };
+
+        Generator(Generator&& rhs) noexcept
+            : m_Handle(std::exchange(rhs.m_Handle, {}))
+        {}
+
+        Generator& operator=(Generator&& rhs) noexcept
+        {
+            std::swap(m_Handle, rhs.m_Handle);
+            return *this;
+        }
+
+        ~Generator()
+        {
+            if (m_Handle)
+                m_Handle.destroy();
+        }
+
+        /**
+         * @brief Runs the coroutine until it yields its first value.
+         *
+         * Can only be called once.
+         */
+        [[nodiscard]]
+        iterator begin()
+        {
+            m_Handle.resume();
+            rethrow(m_Handle);
+            return iterator(m_Handle);
+        }
+
+        [[nodiscard]]
+        std::default_sentinel_t end() const noexcept
+        {
+            return {};
+        }
+    private:
+        explicit Generator(Handle handle)
+            : m_Handle(handle)
+        {}
+
+        static void rethrow(Handle handle)
+        {
+            if (handle.promise().exception)
+                std::rethrow_exception(handle.promise().exception);
+        }
+
+        Handle m_Handle;
+    };
+
+    /**
+     * @brief A lazy sequence of values produced by a coroutine that can
+     *  co_await other operations, e.g. reads from an asynchronous source.
+     *
+     * The consumer must itself be a coroutine:
+     * @code
+     *  while (auto value = co_await generator.next())
+     *      process(*value);
+     * @endcode
+     *
+     * @tparam T The type of the values.
+     */
+    template <typename T>
+    class AsyncGenerator
+    {
+    public:
+        struct promise_type;
+        using Handle = std::coroutine_handle<promise_type>;
+
+        /// Transfers control back to the coroutine that awaits next().
+        struct ResumeConsumer
+        {
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(Handle handle) noexcept
+            {
+                return handle.promise().consumer;
+            }
+
+            void await_resume() noexcept
+            {}
+        };
+
+        struct promise_type
+        {
+            const T* value = nullptr;
+            std::coroutine_handle<> consumer;
+            std::exception_ptr exception;
+
+            AsyncGenerator get_return_object()
+            {
+                return AsyncGenerator(Handle::from_promise(*this));
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            ResumeConsumer final_suspend() noexcept
+            {
+                value = nullptr;
+                return {};
+            }
+
+            ResumeConsumer yield_value(const T& v) noexcept
+            {
+                value = std::addressof(v);
+                return {};
+            }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception()
+            {
+                exception = std::current_exception();
+            }
+        };
+
+        struct NextAwaiter
+        {
+            Handle handle;
+
+            bool await_ready() noexcept
+            {
+                return handle.done();
+            }
+
+            std::coroutine_handle<>
+            await_suspend(std::coroutine_handle<> consumer) noexcept
+            {
+                handle.promise().consumer = consumer;
+                return handle;
+            }
+
+            /// Returns a pointer to the next value, or nullptr if the
+            /// generator has finished. The value is valid until next()
+            /// is awaited again.
+            const T* await_resume()
+            {
+                auto& promise = handle.promise();
+                if (promise.exception)
+                    std::rethrow_exception(std::exchange(promise.exception,
+                                                         {}));
+                return handle.done() ? nullptr : promise.value;
+            }
+        };
+
+        AsyncGenerator(AsyncGenerator&& rhs) noexcept
+            : m_Handle(std::exchange(rhs.m_Handle, {}))
+        {}
+
+        AsyncGenerator& operator=(AsyncGenerator&& rhs) noexcept
+        {
+            std::swap(m_Handle, rhs.m_Handle);
+            return *this;
+        }
+
+        ~AsyncGenerator()
+        {
+            if (m_Handle)
+                m_Handle.destroy();
+        }
+
+        [[nodiscard]]
+        NextAwaiter next()
+        {
+            return {m_Handle};
+        }
+    private:
+        explicit AsyncGenerator(Handle handle)
+            : m_Handle(handle)
+        {}
+
+        Handle m_Handle;
+    };
+
+    /**
+     * @brief Returns a generator that yields each value in an array.
+     *
+     * Like ArrayValueIterator, the generator skips the array's opening
+     * bracket and stops after the closing bracket. If the loop over the
+     * generator is exited early, the reader is left inside the array.
+     *
+     * @tparam T The type of the values. Use JsonItem to read each element
+     *  (including objects and arrays) in full, or Reader& to get the reader
+     *  positioned at each element.
+     * @param reader An instance of Reader positioned at the opening bracket
+     *  of an array, or a reader that hasn't been read from yet.
+     */
+    template <typename T>
+    Generator<T> elements(Reader& reader)
+    {
+        if (!detail::initialize(reader))
+            co_return;
+
+        while (reader.nextValue())
+        {
+            if constexpr (std::is_same_v<T, Reader&>)
+                co_yield reader;
+            else if constexpr (std::is_same_v<T, JsonItem>)
+                co_yield reader.readItem();
+            else
+                co_yield read<T>(reader);
+        }
+        reader.leave();
+    }
+
+    /**
+     * @brief Returns a generator that yields @a reader positioned at the
+     *  top-level value of each document in its input.
+     *
+     * The reader must be back at the top level, i.e. any objects or
+     * arrays that have been entered must have been left, when the
+     * generator is advanced to the next document.
+     */
+    inline Generator<Reader&> documents(Reader& reader)
+    {
+        do
+        {
+            if (reader.nextValue())
+                co_yield reader;
+        } while (reader.nextDocument());
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        std::optional<T> readResumable(JsonReader& reader)
+        {
+            // tryReadItem keeps the part of the item it has read when it
+            // runs out of data, and continues from there the next time.
+            if constexpr (std::is_same_v<T, JsonItem>)
+                return reader.tryReadItem();
+            else
+                return read<T>(reader);
+        }
+    }
+
+    /**
+     * @brief Returns an asynchronous generator that yields each value in
+     *  an array while the input is read from an asynchronous source.
+     *
+     * @a reader must be a push-mode JsonReader (see
+     * JsonReader(const ReaderOptions&)). Whenever the reader needs more
+     * data, the generator calls @a source and co_awaits the result, which
+     * must be a contiguous container of chars (e.g. std::string or
+     * std::vector<char>). An empty container signals the end of the input.
+     *
+     * @tparam T The type of the values, JsonItem reads each element in full.
+     */
+    template <typename T, typename Source>
+    AsyncGenerator<T> asyncElements(JsonReader& reader, Source source)
+    {
+        enum class Step {INITIALIZE, NEXT, READ, LEAVE};
+        auto step = Step::INITIALIZE;
+        while (true)
+        {
+            switch (step)
+            {
+            case Step::INITIALIZE:
+                if (detail::initialize(reader))
+                    step = Step::NEXT;
+                else if (!reader.needsMoreData())
+                    co_return;
+                break;
+            case Step::NEXT:
+                if (reader.nextValue())
+                    step = Step::READ;
+                else if (!reader.needsMoreData())
+                    step = Step::LEAVE;
+                break;
+            case Step::READ:
+                if (auto value = detail::readResumable<T>(reader))
+                {
+                    co_yield *value;
+                    step = Step::NEXT;
+                }
+                break;
+            case Step::LEAVE:
+                reader.leave();
+                if (!reader.needsMoreData())
+                    co_return;
+                break;
+            }
+
+            if (reader.needsMoreData())
+            {
+                auto chunk = co_await source();
+                if (std::size(chunk) == 0)
+                    reader.finishFeed();
+                else
+                    reader.feed(std::data(chunk), std::size(chunk));
+            }
+        }
+    }
+}
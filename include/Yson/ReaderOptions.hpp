@@ -0,0 +1,136 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include "Compression.hpp"
+
+namespace Yson
+{
+    struct ReaderStats;
+
+    /**
+     * @brief The text encodings that can be specified for JSON input.
+     */
+    enum class TextEncoding
+    {
+        /// Determine the encoding from the byte order mark or the first
+        /// few characters of the input.
+        UNKNOWN,
+        UTF_8,
+        UTF_16_LE,
+        UTF_16_BE,
+        UTF_32_LE,
+        UTF_32_BE
+    };
+
+    /**
+     * @brief Options that control how JsonReader and UBJsonReader read
+     *  their input.
+     *
+     * A default-constructed ReaderOptions gives the same behavior as the
+     * reader constructors that don't take options.
+     */
+    struct ReaderOptions
+    {
+        /**
+         * @brief The number of bytes that are read from a stream or file
+         *  at a time.
+         *
+         * 0 means the library-wide default, which is 1 MB unless it has
+         * been changed with setDefaultBufferSize.
+         */
+        size_t chunkSize = 0;
+
+        /**
+         * @brief The largest size the chunk size is allowed to grow to.
+         *
+         * When a JSON token doesn't fit in a single chunk, JsonReader
+         * doubles its chunk size, up to this limit, so that huge strings
+         * don't require many small reads and moves. 0 disables growth.
+         */
+        size_t maxChunkSize = 0;
+
+        /**
+         * @brief The encoding of JSON input.
+         *
+         * Setting the encoding skips encoding detection. The input must
+         * not start with a byte order mark. Ignored by UBJsonReader.
+         */
+        TextEncoding encoding = TextEncoding::UNKNOWN;
+
+        /**
+         * @brief The maximum size in bytes of a single token (string,
+         *  number, comment or similar) in the input.
+         *
+         * The readers throw YsonReaderException when they encounter a
+         * larger token. 0 means there is no limit.
+         */
+        size_t maxTokenSize = 0;
+
+        /**
+         * @brief Check that JSON input is valid UTF-8 as it is read.
+         *
+         * JsonReader throws YsonReaderException, with the error's byte
+         * offset in YsonReaderException::offset, when it encounters
+         * malformed UTF-8. Input in UTF-16 or UTF-32 is checked after it
+         * has been converted to UTF-8. Ignored by UBJsonReader.
+         */
+        bool validateUtf8 = false;
+
+        /**
+         * @brief The compression of the input.
+         *
+         * With AUTO, the default, input that starts with the magic number
+         * of a supported compression format is decompressed, and other
+         * input is read as it is. AUTO only applies to std::istream input
+         * if detectStreamCompression is true, otherwise streams are read
+         * as they are unless a specific format is given. Decompression
+         * runs in a background thread that stays ahead of the reader.
+         * zlib and zstd input can only be read when Yson has been built
+         * with them, see isCompressionSupported.
+         */
+        Compression compression = Compression::AUTO;
+
+        /**
+         * @brief Look for the magic numbers of compression formats at the
+         *  start of std::istream input when compression is AUTO.
+         *
+         * This is off by default, because peeking at a stream blocks
+         * until data arrive, which is a problem with sockets and stdin.
+         * Files and buffers are always examined.
+         */
+        bool detectStreamCompression = false;
+
+        /**
+         * @brief Read the input as BJData rather than UBJSON.
+         *
+         * BJData stores multi-byte values in little-endian byte order,
+         * adds the markers for unsigned 16, 32 and 64-bit integers and
+         * 16-bit floats, and allows optimized arrays to specify a vector
+         * of dimensions instead of a count. Ignored by JsonReader.
+         */
+        bool bjdata = false;
+
+        /**
+         * @brief Counters that are updated while the input is read.
+         *
+         * nullptr, the default, disables the counters. See ReaderStats.
+         */
+        ReaderStats* stats = nullptr;
+
+        /**
+         * @brief The memory resource that the reader allocates its buffers
+         *  and the JsonItems returned by readItem from.
+         *
+         * nullptr, the default, means std::pmr::get_default_resource().
+         * The resource must outlive the reader and the items it returns.
+         */
+        std::pmr::memory_resource* memoryResource = nullptr;
+    };
+}
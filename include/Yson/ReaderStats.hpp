@@ -0,0 +1,74 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <chrono>
+#include <cstddef>
+
+namespace Yson
+{
+    /**
+     * @brief Counters that JsonReader and UBJsonReader update while they
+     *  read their input.
+     *
+     * Collecting statistics is opt-in: set ReaderOptions::stats to point
+     * to an instance that outlives the reader. Several readers can share
+     * the same instance. The counters are never reset by the readers,
+     * assign a default-constructed ReaderStats to reset them.
+     *
+     * The counters are updated without synchronization, they should only
+     * be read by the thread that uses the reader.
+     */
+    struct ReaderStats
+    {
+        /// The number of bytes that have been read from the input. For
+        /// JSON in UTF-16 or UTF-32 this is the size after conversion to
+        /// UTF-8.
+        size_t bytesRead = 0;
+
+        /// The number of times more input has been read into the reader's
+        /// buffer.
+        size_t bufferRefills = 0;
+
+        /// The number of bytes that have been moved to the start of the
+        /// buffer to make room for more input.
+        size_t bytesMoved = 0;
+
+        /// The number of times the reader's buffer or its stack of
+        /// objects and arrays had to allocate memory.
+        size_t allocations = 0;
+
+        /// The time spent converting JSON input to UTF-8. Includes the
+        /// time spent passing UTF-8 input from streams and files through
+        /// the converter.
+        std::chrono::nanoseconds conversionTime{0};
+
+        /// The number of objects in the input that have been read or
+        /// skipped.
+        size_t objectTokens = 0;
+
+        /// The number of arrays in the input that have been read or
+        /// skipped.
+        size_t arrayTokens = 0;
+
+        /// The number of strings, including keys, that have been read or
+        /// skipped.
+        size_t stringTokens = 0;
+
+        /// The number of numbers, booleans and nulls that have been read
+        /// or skipped.
+        size_t valueTokens = 0;
+
+        /// The number of JSON strings with escape sequences that have been
+        /// unescaped by the reader's read functions.
+        size_t unescapeCalls = 0;
+
+        /// The maximum number of nested objects and arrays the reader has
+        /// been inside at the same time.
+        size_t maxScopeDepth = 0;
+    };
+}
@@ -0,0 +1,56 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include "JsonReader.hpp"
+#include "JsonWriter.hpp"
+#include "UBJsonReader.hpp"
+#include "UBJsonWriter.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief Writes the value at the reader's current position, including
+     *  all the values in it if it is an object or array, to @a writer.
+     *
+     * If the reader isn't at a value, nextValue() is called first, e.g.
+     * the first value in the input is written if the reader hasn't been
+     * read from yet. Use nextDocument() to move on to the next
+     * document in inputs with multiple documents.
+     *
+     * Uses the specialized overloads below when @a reader and @a writer
+     * are JsonReader and UBJsonWriter or vice versa.
+     *
+     * @return false if there was no value to write.
+     * @throw YsonException if a number can't be read as either a 64-bit
+     *  integer or a double, e.g. 1e400.
+     */
+    YSON_API bool transcode(Reader& reader, Writer& writer);
+
+    /**
+     * @brief Writes the value at the reader's current position to
+     *  @a writer.
+     *
+     * Arrays that contain only integers, or only floating point numbers,
+     * are written as optimized UBJSON arrays with the smallest integer
+     * type that can represent all of their values. The values must be
+     * buffered to determine this, so only arrays of up to 4096 values
+     * are optimized, longer arrays are written value by value. Arrays
+     * that mix integers and floating point numbers, e.g. [1, 2.5], are
+     * never optimized.
+     */
+    YSON_API bool transcode(JsonReader& reader, UBJsonWriter& writer);
+
+    /**
+     * @brief Writes the value at the reader's current position to
+     *  @a writer.
+     *
+     * Optimized numeric arrays of up to 4096 values are read in one go
+     * rather than value by value.
+     */
+    YSON_API bool transcode(UBJsonReader& reader, JsonWriter& writer);
+}
@@ -0,0 +1,96 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "YsonDefinitions.hpp"
+
+namespace Yson
+{
+    class UBJsonReader;
+
+    /**
+     * @brief The offsets of the values in a UBJSON document, used for
+     *  moving a UBJsonReader directly to a value with UBJsonReader::seek.
+     *
+     * Values are identified by JSON Pointer paths (RFC 6901), e.g.
+     * "/records/12/name". The document itself has the path "". Object
+     * keys containing '~' or '/' must be escaped as "~0" and "~1" in
+     * the paths.
+     *
+     * The index can be saved to a sidecar file next to the document it
+     * was built from. It must be rebuilt whenever the document changes.
+     */
+    class YSON_API UBJsonIndex
+    {
+    public:
+        UBJsonIndex() = default;
+
+        /**
+         * @brief Builds an index of the document at the reader's current
+         *  position.
+         *
+         * The index contains the document and the values in its arrays
+         * and objects down to @a maxDepth levels below the document.
+         * The values in optimized arrays and objects with a value type
+         * don't have type markers and aren't indexed, neither are their
+         * children. If a key appears more than once in an object, only
+         * its first value is indexed.
+         *
+         * @a reader must be at the start of a document, e.g. newly
+         * created, and it is at the end of the document when the
+         * function returns.
+         */
+        static UBJsonIndex build(UBJsonReader& reader, size_t maxDepth = 1);
+
+        static UBJsonIndex load(std::istream& stream);
+
+        static UBJsonIndex load(const std::filesystem::path& fileName);
+
+        /**
+         * @brief Writes the index to @a stream as a UBJSON object where
+         *  the keys are the paths and the values are the offsets.
+         */
+        void save(std::ostream& stream) const;
+
+        void save(const std::filesystem::path& fileName) const;
+
+        /**
+         * @brief Adds or replaces the offset of the value at @a path.
+         */
+        void add(std::string path, uint64_t offset);
+
+        /**
+         * @brief Returns the offset of the value at @a path, or nothing
+         *  if it isn't in the index.
+         */
+        [[nodiscard]]
+        std::optional<uint64_t> find(std::string_view path) const;
+
+        [[nodiscard]]
+        size_t size() const;
+
+        [[nodiscard]]
+        bool empty() const;
+
+        /**
+         * @brief Returns the entries sorted by path.
+         */
+        [[nodiscard]]
+        const std::vector<std::pair<std::string, uint64_t>>&
+        entries() const;
+    private:
+        std::vector<std::pair<std::string, uint64_t>> m_Entries;
+    };
+}
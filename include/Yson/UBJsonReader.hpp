@@ -6,28 +6,38 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
 #include "JsonItem.hpp"
 #include "Reader.hpp"
+#include "ReaderOptions.hpp"
 
 namespace Yson
 {
     enum class UBJsonTokenType : char;
+    class UBJsonIndex;
 
     class YSON_API UBJsonReader : public Reader
     {
     public:
         UBJsonReader();
 
-        explicit UBJsonReader(std::istream& stream);
+        explicit UBJsonReader(std::istream& stream,
+                              const ReaderOptions& options = {});
 
-        explicit UBJsonReader(const std::filesystem::path& fileName);
+        explicit UBJsonReader(const std::filesystem::path& fileName,
+                              const ReaderOptions& options = {});
 
-        UBJsonReader(const char* buffer, size_t bufferSize);
+        UBJsonReader(const char* buffer, size_t bufferSize,
+                     const ReaderOptions& options = {});
 
         UBJsonReader(std::istream& stream,
                      const char* buffer,
-                     size_t bufferSize);
+                     size_t bufferSize,
+                     const ReaderOptions& options = {});
 
         UBJsonReader(const UBJsonReader&) = delete;
 
@@ -39,6 +49,56 @@ namespace Yson
 
         UBJsonReader& operator=(UBJsonReader&&) noexcept;
 
+        /**
+         * @brief Prepares the reader for reading a new document from
+         *  @a buffer.
+         *
+         * The reader's internal buffers and other storage are reused,
+         * and options such as expandOptimizedByteArrays are retained.
+         */
+        void reset(const char* buffer, size_t bufferSize);
+
+        /**
+         * @brief Prepares the reader for reading a new document from
+         *  @a stream.
+         *
+         * The reader's internal buffers and other storage are reused,
+         * and options such as expandOptimizedByteArrays are retained.
+         */
+        void reset(std::istream& stream);
+
+        /**
+         * @brief Moves the reader to @a offset in the input, which must be
+         *  the offset of a value's type marker, e.g. one obtained from
+         *  valueOffset().
+         *
+         * The reader then reads the value at @a offset as if it were a
+         * document of its own: the next call to nextValue() selects it,
+         * and it can be entered and read as usual.
+         *
+         * @throw YsonReaderException if the input doesn't support
+         *  seeking, e.g. if it is compressed.
+         */
+        void seek(size_t offset);
+
+        /**
+         * @brief Moves the reader to the value at @a path in @a index, see
+         *  seek(size_t).
+         *
+         * @return false if @a path isn't in @a index.
+         */
+        bool seek(const UBJsonIndex& index, std::string_view path);
+
+        /**
+         * @brief Returns the offset of the current value's type marker in
+         *  the input.
+         *
+         * Values in optimized arrays and objects with a value type don't
+         * have type markers, for them the result is empty.
+         */
+        [[nodiscard]]
+        std::optional<size_t> valueOffset() const;
+
         bool nextValue() override;
 
         bool nextKey() override;
@@ -68,6 +128,18 @@ namespace Yson
         [[nodiscard]]
         std::pair<size_t, DetailedValueType> optimizedArrayProperties() const;
 
+        /**
+         * @brief Returns the dimensions of the current optimized array.
+         *
+         * BJData arrays with a dimension vector have one entry per
+         * dimension, with the values stored in row-major order. Other
+         * optimized arrays have a single entry, the number of values.
+         * The result is empty if the current value isn't an optimized
+         * array, and it is only valid until the reader moves on.
+         */
+        [[nodiscard]]
+        std::span<const size_t> arrayDimensions() const;
+
         [[nodiscard]]
         bool readNull() const override;
 
@@ -113,12 +185,38 @@ namespace Yson
 
         bool readOptimizedArray(uint8_t* buffer, size_t& size);
 
+        bool readOptimizedArray(uint16_t* buffer, size_t& size);
+
+        bool readOptimizedArray(uint32_t* buffer, size_t& size);
+
+        bool readOptimizedArray(uint64_t* buffer, size_t& size);
+
         bool readOptimizedArray(float* buffer, size_t& size);
 
         bool readOptimizedArray(double* buffer, size_t& size);
 
         bool readOptimizedArray(char* buffer, size_t& size);
 
+        /**
+         * @brief Reads the values of the current optimized array of
+         *  fixed-size numbers or characters without converting them.
+         *
+         * @a data is set to the array's payload as it is stored in the
+         * input: big-endian for UBJSON, little-endian for BJData. For
+         * BJData on a little-endian machine, the payload can therefore
+         * be used directly, e.g. by reinterpreting it as an array of
+         * floats after checking its alignment. When the reader reads
+         * from an uncompressed buffer, @a data points into that buffer,
+         * otherwise it points into the reader's internal buffer and is
+         * only valid until the reader moves on.
+         *
+         * @return false if the current value isn't an optimized array of
+         *  fixed-size values.
+         * @throw YsonReaderException if the payload is larger than the
+         *  maximum token size.
+         */
+        bool readArrayData(std::span<const char>& data);
+
         bool readBase64(std::vector<char>& value) const override;
 
         bool readBinary(std::vector<char>& value) override;
@@ -155,6 +253,8 @@ namespace Yson
         [[nodiscard]]
         Scope& currentScope() const;
 
+        void resetScopes();
+
         [[nodiscard]]
         JsonItem readArray(bool expandOptmizedByteArrays);
 
@@ -6,6 +6,7 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory_resource>
 #include "ValueItem.hpp"
 
 namespace Yson
@@ -15,7 +16,19 @@ namespace Yson
     class YSON_API UBJsonValueItem : public ValueItem
     {
     public:
-        UBJsonValueItem(std::string value, UBJsonTokenType type);
+        /**
+         * @param contentType The type of the values if @a type is an
+         *  optimized array of bytes or characters.
+         * @param littleEndian True if a numeric @a value is in BJData's
+         *  little-endian byte order rather than UBJSON's big-endian.
+         */
+        UBJsonValueItem(std::string value, UBJsonTokenType type,
+                        UBJsonTokenType contentType = {},
+                        bool littleEndian = false);
+
+        UBJsonValueItem(std::pmr::string value, UBJsonTokenType type,
+                        UBJsonTokenType contentType = {},
+                        bool littleEndian = false);
 
         [[nodiscard]]
         ValueType valueType() const override;
@@ -61,7 +74,18 @@ namespace Yson
         bool getBinary(void* buffer, size_t& size) const override;
 
     private:
-        std::string m_Value;
+        friend class JsonWriter;
+        friend class UBJsonWriter;
+
+        // Numbers are converted to native byte order when the item is created,
+        // m_Value is empty for numbers and booleans.
+        std::pmr::string m_Value;
+        union
+        {
+            int64_t m_Integer = 0;
+            double m_FloatingPoint;
+        };
         UBJsonTokenType m_Type;
+        UBJsonTokenType m_ContentType;
     };
 }
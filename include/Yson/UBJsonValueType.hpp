@@ -29,7 +29,15 @@ namespace Yson
         INT_8 = 'i',
         INT_16 = 'I',
         INT_32 = 'l',
-        INT_64 = 'L'
+        INT_64 = 'L',
+        /// BJData only.
+        UINT_16 = 'u',
+        /// BJData only.
+        UINT_32 = 'm',
+        /// BJData only.
+        UINT_64 = 'M',
+        /// BJData only.
+        FLOAT_16 = 'h'
     };
 
     YSON_API std::string toString(UBJsonValueType type);
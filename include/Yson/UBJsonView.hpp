@@ -0,0 +1,262 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "UBJsonValueType.hpp"
+#include "ValueType.hpp"
+#include "YsonException.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief A read-only view of a UBJSON value in a buffer.
+     *
+     * The view doesn't parse or copy anything up front. Markers are
+     * decoded when the view's accessors are called, and strings and
+     * the payloads of optimized arrays are returned as views of the
+     * buffer. This makes it possible to look up individual values in
+     * large documents, e.g. memory-mapped files, without reading all of
+     * them first.
+     *
+     * The buffer must outlive the view and all views and iterators
+     * obtained from it. Finding an element by index or key in arrays
+     * and objects that aren't optimized arrays of fixed-size values
+     * requires skipping all the values in front of it.
+     *
+     * @throw YsonException from the accessors if the data are invalid
+     *  UBJSON, or the value has a different type than the accessor
+     *  requires.
+     */
+    class YSON_API UBJsonView
+    {
+    public:
+        class Iterator;
+
+        UBJsonView() = default;
+
+        /**
+         * @brief Creates a view of the first value in @a buffer.
+         */
+        UBJsonView(const char* buffer, size_t bufferSize);
+
+        /**
+         * @brief Returns false if the view was default-constructed.
+         */
+        explicit operator bool() const;
+
+        [[nodiscard]]
+        ValueType valueType() const;
+
+        /**
+         * @brief Returns the value's type marker.
+         *
+         * The marker of values in optimized arrays and objects is the
+         * structure's value type.
+         */
+        [[nodiscard]]
+        UBJsonValueType ubJsonValueType() const;
+
+        /**
+         * @brief Returns the value's key if it is a member of an object.
+         */
+        [[nodiscard]]
+        std::string_view key() const;
+
+        [[nodiscard]]
+        bool isNull() const;
+
+        bool get(bool& value) const;
+
+        bool get(int32_t& value) const;
+
+        bool get(int64_t& value) const;
+
+        bool get(uint32_t& value) const;
+
+        bool get(uint64_t& value) const;
+
+        bool get(float& value) const;
+
+        bool get(double& value) const;
+
+        /**
+         * @brief Gets the contents of strings, high-precision numbers
+         *  and chars.
+         */
+        bool get(std::string_view& value) const;
+
+        /**
+         * @brief Returns the number of values in an array or object.
+         */
+        [[nodiscard]]
+        size_t size() const;
+
+        /**
+         * @brief Returns the payload of an optimized array of fixed-size
+         *  values, e.g. a binary array.
+         *
+         * The values are in big-endian byte order.
+         *
+         * @return The payload, or an empty span if the value isn't an
+         *  optimized array of fixed-size values.
+         */
+        [[nodiscard]]
+        std::span<const char> arrayData() const;
+
+        /**
+         * @throw YsonException if the value isn't an array or @a index
+         *  is too great.
+         */
+        UBJsonView operator[](size_t index) const;
+
+        /**
+         * @throw YsonException if the value isn't an object or it
+         *  doesn't have @a key.
+         */
+        UBJsonView operator[](std::string_view key) const;
+
+        /**
+         * @brief Returns the value at @a index in an array, or nothing
+         *  if @a index is too great.
+         */
+        [[nodiscard]]
+        std::optional<UBJsonView> find(size_t index) const;
+
+        /**
+         * @brief Returns the value of @a key in an object, or nothing
+         *  if the object doesn't have @a key.
+         *
+         * Unlike UBJsonReader::readItem, which keeps the last value,
+         * this returns the first value if @a key appears more than once.
+         */
+        [[nodiscard]]
+        std::optional<UBJsonView> find(std::string_view key) const;
+
+        /**
+         * @brief Returns the number of bytes in the value's encoding,
+         *  not including its type marker.
+         */
+        [[nodiscard]]
+        size_t encodedSize() const;
+
+        /**
+         * @brief Returns an iterator to the first value in an array or
+         *  object.
+         */
+        [[nodiscard]]
+        Iterator begin() const;
+
+        [[nodiscard]]
+        Iterator end() const;
+    private:
+        friend class Iterator;
+
+        UBJsonView(const char* payload, const char* end,
+                   UBJsonValueType valueType, std::string_view key);
+
+        /**
+         * @brief The properties of an array or object that are given
+         *  right after its marker.
+         */
+        struct StructureHeader
+        {
+            const char* firstValue = nullptr;
+            UBJsonValueType valueType = UBJsonValueType::UNKNOWN;
+            int64_t size = -1;
+        };
+
+        [[nodiscard]]
+        StructureHeader structureHeader() const;
+
+        [[nodiscard]]
+        bool isStructure() const;
+
+        const char* m_Payload = nullptr;
+        const char* m_End = nullptr;
+        UBJsonValueType m_ValueType = UBJsonValueType::UNKNOWN;
+        std::string_view m_Key;
+    };
+
+    /**
+     * @brief Iterates over the values in an array or object.
+     */
+    class YSON_API UBJsonView::Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = UBJsonView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const UBJsonView*;
+        using reference = const UBJsonView&;
+
+        Iterator() = default;
+
+        reference operator*() const
+        {
+            return m_Value;
+        }
+
+        pointer operator->() const
+        {
+            return &m_Value;
+        }
+
+        Iterator& operator++();
+
+        Iterator operator++(int)
+        {
+            auto result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b)
+        {
+            return a.m_Position == b.m_Position;
+        }
+
+        friend bool operator!=(const Iterator& a, const Iterator& b)
+        {
+            return !(a == b);
+        }
+    private:
+        friend class UBJsonView;
+
+        Iterator(const char* position, const char* end, bool isObject,
+                 UBJsonValueType valueType, int64_t remaining);
+
+        void readValue();
+
+        UBJsonView m_Value;
+        /// The start of the current value (or its key), or nullptr at
+        /// the end.
+        const char* m_Position = nullptr;
+        const char* m_End = nullptr;
+        bool m_IsObject = false;
+        UBJsonValueType m_StructureValueType = UBJsonValueType::UNKNOWN;
+        /// The number of values left in sized structures, otherwise -1.
+        int64_t m_Remaining = -1;
+    };
+
+    template <typename T>
+    T get(const UBJsonView& view)
+    {
+        T v;
+        if (!view.get(v))
+        {
+            YSON_THROW("get(...) called with incorrect type."
+                       " The actual value type is "
+                       + toString(view.valueType()) + ".");
+        }
+        return v;
+    }
+}
@@ -9,7 +9,10 @@
 #include <filesystem>
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include "Writer.hpp"
+#include "WriterStats.hpp"
 #include "YsonDefinitions.hpp"
 
 namespace Yson
@@ -17,11 +20,28 @@ namespace Yson
     class YSON_API UBJsonWriter : public Writer
     {
     public:
-        UBJsonWriter();
-
-        explicit UBJsonWriter(const std::filesystem::path& fileName);
-
-        explicit UBJsonWriter(std::ostream& stream);
+        /**
+         * @param memoryResource The memory resource the writer allocates
+         *  its buffer and internal state from. nullptr means
+         *  std::pmr::get_default_resource().
+         */
+        explicit UBJsonWriter(
+            std::pmr::memory_resource* memoryResource = nullptr);
+
+        /**
+         * @brief Creates a UBJSON writer that creates and writes to a file
+         *      named @a fileName.
+         *
+         * The output is compressed if the file name ends with ".gz",
+         * ".zz" or ".zst", see makeCompressingStream.
+         */
+        explicit UBJsonWriter(
+            const std::filesystem::path& fileName,
+            std::pmr::memory_resource* memoryResource = nullptr);
+
+        explicit UBJsonWriter(
+            std::ostream& stream,
+            std::pmr::memory_resource* memoryResource = nullptr);
 
         UBJsonWriter(const UBJsonWriter&) = delete;
 
@@ -92,30 +112,146 @@ namespace Yson
 
         UBJsonWriter& base64(const void* data, size_t size) override;
 
+        /**
+         * @brief Writes @a item, including the values in any arrays and
+         *  objects it contains.
+         *
+         * Values read by UBJsonReader are written with the same type
+         * marker and payload as in the input, except inside arrays and
+         * objects with a fixed value type, where they are converted to
+         * that type.
+         */
+        UBJsonWriter& write(const JsonItem& item) override;
+
         UBJsonWriter& noop();
 
         [[nodiscard]] bool isStrictIntegerSizesEnabled() const;
 
         UBJsonWriter& setStrictIntegerSizesEnabled(bool value);
 
+        [[nodiscard]] bool isBJDataEnabled() const;
+
+        /**
+         * @brief Makes the writer write BJData rather than UBJSON.
+         *
+         * BJData stores multi-byte values in little-endian byte order,
+         * and uses its unsigned integer markers for unsigned values that
+         * don't fit in the signed integer of the same size. Read the
+         * output with ReaderOptions::bjdata enabled.
+         */
+        UBJsonWriter& setBJDataEnabled(bool value);
+
+        [[nodiscard]] bool isCompactModeEnabled() const;
+
+        /**
+         * @brief Makes the writer minimize the size of its output.
+         *
+         * Arrays and objects without UBJsonParameters are kept in the
+         * buffer until they are closed. If all their values are numbers,
+         * or all are strings, they are then rewritten as optimized
+         * structures with a value type and a count whenever that is
+         * smaller. The value type is the narrowest one that represents
+         * every value without loss, e.g. 'U' for integers between 0 and
+         * 255, or 'd' for doubles that are exactly representable as
+         * floats. Structures with mixed or nested values, including
+         * integers mixed with floating point numbers, are written as
+         * usual.
+         *
+         * Doubles outside optimized structures are also written as
+         * floats when that doesn't change their value.
+         */
+        UBJsonWriter& setCompactModeEnabled(bool value);
+
+        [[nodiscard]] bool isCountPatchingEnabled() const;
+
+        /**
+         * @brief Makes the writer give arrays and objects without
+         *  UBJsonParameters a count rather than an end marker.
+         *
+         * The count is written as a placeholder int64 when the
+         * structure begins and updated when it ends. Readers can then
+         * preallocate memory for the values, and skip the structure
+         * without parsing them if they have a known size. The writer
+         * must either write to its internal buffer or to a seekable
+         * stream. Structures rewritten by compact mode get their count
+         * from the rewrite.
+         *
+         * @throw YsonException if the writer's stream isn't seekable.
+         */
+        UBJsonWriter& setCountPatchingEnabled(bool value);
+
+        /**
+         * @brief Writes a BJData N-dimensional array whose values are
+         *  stored in row-major order at @a data.
+         *
+         * The values must be in the machine's native byte order, on
+         * little-endian machines they are copied to the output without
+         * conversion. Any fixed-size numeric type can be used, including
+         * FLOAT_16 when @a data holds IEEE 754 half-precision values.
+         *
+         * @throw YsonException if BJData isn't enabled, @a valueType
+         *  isn't a fixed-size numeric or CHAR type, or the current
+         *  structure is optimized with a value type.
+         */
+        UBJsonWriter& ndArray(UBJsonValueType valueType,
+                              std::span<const size_t> dimensions,
+                              const void* data);
+
+        /**
+         * @brief Returns the counters set with setStats, or nullptr.
+         */
+        [[nodiscard]] WriterStats* stats() const;
+
+        /**
+         * @brief Makes the writer update the counters in @a stats.
+         *
+         * The writer doesn't take ownership of @a stats. Pass nullptr
+         * to stop updating the counters.
+         */
+        UBJsonWriter& setStats(WriterStats* stats);
+
         UBJsonWriter& flush() override;
+    protected:
+        void writeValueItem(const ValueItem& item) override;
     private:
+        friend class FragmentWriter;
+
         UBJsonWriter(std::unique_ptr<std::ostream> streamPtr,
-                     std::ostream* stream);
+                     std::ostream* stream,
+                     std::pmr::memory_resource* memoryResource);
 
         struct Members;
 
         [[nodiscard]] Members& members() const;
 
+        [[nodiscard]]
+        std::unique_ptr<UBJsonWriter> makeFragmentWriter() const;
+
+        /**
+         * @brief Returns true if exactly one value has been written and
+         *  all arrays and objects have been closed.
+         */
+        [[nodiscard]]
+        bool isCompleteFragment() const;
+
+        UBJsonWriter& writeFragment(std::string_view data);
+
         UBJsonWriter& beginStructure(UBJsonValueType structureType,
                                      const UBJsonParameters& parameters);
 
         UBJsonWriter& endStructure(UBJsonValueType structureType);
 
+        void patchCount(uint64_t offset, int64_t count);
+
         void beginValue();
 
+        UBJsonWriter& writeText(UBJsonValueType type, std::string_view text);
+
+        UBJsonWriter& writeByteArray(UBJsonValueType type,
+                                     const void* data, size_t size);
+
         template <typename T>
-        UBJsonWriter& writeInteger(T value);
+        UBJsonWriter& writeInteger(T value, bool minimalSize = true);
 
         template <typename T>
         UBJsonWriter& writeFloat(T value);
@@ -0,0 +1,101 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include "ReaderOptions.hpp"
+#include "YsonDefinitions.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief The result of validateJson and validateUBJson.
+     */
+    struct ValidationResult
+    {
+        /// True if the input is well-formed.
+        bool isValid = true;
+        /// The byte offset of the first error. For JSON input that isn't
+        /// UTF-8, the offset is in the UTF-8 text the input is converted to.
+        size_t offset = 0;
+        /// The line number of the first error. Always 0 for UBJSON.
+        size_t line = 0;
+        /// The column number of the first error. For UBJSON this is the
+        /// same as the offset.
+        size_t column = 0;
+        /// A description of the first error.
+        std::string message;
+
+        explicit operator bool() const
+        {
+            return isValid;
+        }
+    };
+
+    /**
+     * @brief Checks that @a buffer contains one or more well-formed JSON
+     *  documents, including the extensions JsonReader supports.
+     *
+     * Checks nesting, separators, string escapes and the syntax of numbers
+     * and other unquoted values without reading any of the values. This
+     * is considerably faster than traversing the input with JsonReader.
+     *
+     * Tokens are checked where they are in the input buffer. Apart from
+     * the error message, memory is only allocated for the input buffer
+     * when reading streams and files, and for tracking scopes in
+     * documents nested more than 1024 levels deep.
+     *
+     * @param options Set validateUtf8 to also check that the input is
+     *  valid UTF-8.
+     */
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateJson(const char* buffer, size_t bufferSize,
+                 const ReaderOptions& options = {});
+
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateJson(std::istream& stream, const ReaderOptions& options = {});
+
+    /**
+     * @throws YsonException if the file can't be opened.
+     */
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateJson(const std::filesystem::path& fileName,
+                 const ReaderOptions& options = {});
+
+    /**
+     * @brief Checks that @a buffer contains one or more well-formed UBJSON
+     *  documents.
+     *
+     * Traverses the documents with a UBJsonReader without reading the
+     * values, so the allocations are those of the reader: its scope
+     * stack and, when reading streams and files, the input buffer that
+     * strings and other tokens are copied into. The validator's own
+     * scope tracking only allocates memory for documents nested more
+     * than 1024 levels deep.
+     */
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateUBJson(const char* buffer, size_t bufferSize,
+                   const ReaderOptions& options = {});
+
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateUBJson(std::istream& stream, const ReaderOptions& options = {});
+
+    /**
+     * @throws YsonException if the file can't be opened.
+     */
+    [[nodiscard]]
+    YSON_API ValidationResult
+    validateUBJson(const std::filesystem::path& fileName,
+                   const ReaderOptions& options = {});
+}
@@ -11,10 +11,14 @@
 #include <string>
 #include <string_view>
 #include "StructureParameters.hpp"
+#include "YsonDefinitions.hpp"
 
 namespace Yson
 {
-    class Writer
+    class JsonItem;
+    class ValueItem;
+
+    class YSON_API Writer
     {
     public:
         virtual ~Writer() = default;
@@ -97,6 +101,28 @@ namespace Yson
 
         virtual Writer& base64(const void* data, size_t size) = 0;
 
+        /**
+         * @brief Writes @a item, including the values in any arrays and
+         *  objects it contains.
+         *
+         * Object members are written in the order they appear in the
+         * document the item was read from. Writers write values that were
+         * read from their own format as-is whenever possible, without
+         * parsing and formatting them again.
+         *
+         * @return A reference to the instance.
+         */
+        virtual Writer& write(const JsonItem& item);
+
         virtual Writer& flush() = 0;
+    protected:
+        /**
+         * @brief Writes a single value from a JsonItem.
+         *
+         * The default implementation writes the value with the overload
+         * of value() (or null(), boolean() or binary()) that matches its
+         * value type.
+         */
+        virtual void writeValueItem(const ValueItem& item);
     };
 }
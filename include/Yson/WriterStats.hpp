@@ -0,0 +1,33 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+
+namespace Yson
+{
+    /**
+     * @brief Counters that JsonWriter and UBJsonWriter update while they
+     *  write their output.
+     *
+     * Collecting statistics is opt-in: pass a pointer to an instance that
+     * outlives the writer to the writer's setStats function. The counters
+     * are updated without synchronization.
+     */
+    struct WriterStats
+    {
+        /// The number of times the writer has written to its stream.
+        size_t flushes = 0;
+
+        /// The number of bytes the writer has written to its stream.
+        size_t bytesFlushed = 0;
+
+        /// The maximum number of nested objects and arrays the writer
+        /// has been inside at the same time.
+        size_t maxScopeDepth = 0;
+    };
+}
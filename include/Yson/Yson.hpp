@@ -7,9 +7,18 @@
 //****************************************************************************
 #pragma once
 
+#include "BasicJsonWriter.hpp"
+#include "Compression.hpp"
+#include "FragmentWriter.hpp"
 #include "JsonReader.hpp"
 #include "JsonWriter.hpp"
+#include "ReaderGenerators.hpp"
 #include "ReaderIterators.hpp"
+#include "ReaderStats.hpp"
+#include "Transcode.hpp"
+#include "UBJsonIndex.hpp"
 #include "UBJsonReader.hpp"
+#include "UBJsonView.hpp"
 #include "UBJsonWriter.hpp"
+#include "Validate.hpp"
 #include "YsonVersion.hpp"
@@ -6,6 +6,7 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <limits>
 #include <stdexcept>
 #include <string>
 #include "YsonException.hpp"
@@ -17,21 +18,34 @@ namespace Yson
     class YsonReaderException : public YsonException
     {
     public:
+        /// The value of offset when the location is unknown.
+        static constexpr size_t UNKNOWN_OFFSET
+            = std::numeric_limits<size_t>::max();
+
         explicit YsonReaderException(const std::string& message,
                                      const std::string& debugLocation,
                                      std::string fileName = std::string(),
                                      size_t line = 0,
-                                     size_t column = 0)
+                                     size_t column = 0,
+                                     size_t offset = UNKNOWN_OFFSET)
             : YsonException(makeLocationString(fileName, line, column)
                             + message, debugLocation),
               fileName(std::move(fileName)),
               line(line),
-              column(column)
+              column(column),
+              offset(offset)
         {}
 
         std::string fileName;
         size_t line;
         size_t column;
+        /**
+         * @brief The byte offset of the error from the start of the input.
+         *
+         * For JSON input that isn't UTF-8, the offset is in the UTF-8
+         * text the input has been converted to.
+         */
+        size_t offset;
     private:
         [[nodiscard]]
         static std::string makeLocationString(const std::string& fileName,
@@ -7,13 +7,25 @@
 //****************************************************************************
 #include "Yson/ArrayItem.hpp"
 
+#include <iterator>
+
 namespace Yson
 {
     ArrayItem::ArrayItem(std::vector<JsonItem> values)
+        : m_Values(std::make_move_iterator(values.begin()),
+                   std::make_move_iterator(values.end()))
+    {}
+
+    ArrayItem::ArrayItem(std::pmr::vector<JsonItem> values)
         : m_Values(std::move(values))
     {}
 
-    const std::vector<JsonItem>& ArrayItem::values() const
+    std::vector<JsonItem> ArrayItem::values() const
+    {
+        return {m_Values.begin(), m_Values.end()};
+    }
+
+    const std::pmr::vector<JsonItem>& ArrayItem::pmrValues() const
     {
         return m_Values;
     }
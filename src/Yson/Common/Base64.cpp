@@ -8,100 +8,307 @@
 #include "Base64.hpp"
 
 #include <cstdint>
+#include <cstring>
 #include "Yson/YsonException.hpp"
 
+// YSON_HAS_SSSE3 is set by the YSON_USE_SSSE3 CMake option. MSVC never
+// defines __SSSE3__, but accepts the intrinsics without any flags.
+#if defined(YSON_HAS_SSSE3) || defined(__SSSE3__)
+#define YSON_BASE64_SSSE3
+#include <tmmintrin.h>
+#endif
+
 namespace Yson
 {
-    const char EncodingTable[] =
-            "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
-            "abcdefghijklmnopqrstuvwxyz"
-            "0123456789"
-            "+/";
-
-    const uint8_t Err = 0xFF;
-    const uint8_t DecodingTable[128] = {
-            Err, Err, Err, Err, Err, Err, Err, Err, // 0x00
-            Err, Err, Err, Err, Err, Err, Err, Err, // 0x08
-            Err, Err, Err, Err, Err, Err, Err, Err, // 0x10
-            Err, Err, Err, Err, Err, Err, Err, Err, // 0x18
-            Err, Err, Err, Err, Err, Err, Err, Err, // 0x20
-            Err, Err, Err,  62, Err, Err, Err,  63, // 0x28
-             52,  53,  54,  55,  56,  57,  58,  59, // 0x30
-             60,  61, Err, Err, Err, Err, Err, Err, // 0x38
-            Err,   0,   1,   2,   3,   4,   5,   6, // 0x40
-              7,   8,   9,  10,  11,  12,  13,  14, // 0x48
-             15,  16,  17,  18,  19,  20,  21,  22, // 0x50
-             23,  24,  25, Err, Err, Err, Err, Err, // 0x58
-            Err,  26,  27,  28,  29,  30,  31,  32, // 0x60
-             33,  34,  35,  36,  37,  38,  39,  40, // 0x68
-             41,  42,  43,  44,  45,  46,  47,  48, // 0x70
-             49,  50,  51, Err, Err, Err, Err, Err, // 0x78
-    };
-
-    constexpr size_t getEncodedSize(size_t decodedSize)
+    namespace
     {
-        return 4 * (decodedSize + 2 / 3);
-    }
+        const char EncodingTable[] =
+                "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                "abcdefghijklmnopqrstuvwxyz"
+                "0123456789"
+                "+/";
 
-    constexpr size_t getDecodedSize(size_t encodedSize)
-    {
-        return (3 * encodedSize) / 4;
-    }
+        const uint8_t Err = 0xFF;
+        const uint8_t DecodingTable[256] = {
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x00
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x08
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x10
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x18
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x20
+                Err, Err, Err,  62, Err, Err, Err,  63, // 0x28
+                 52,  53,  54,  55,  56,  57,  58,  59, // 0x30
+                 60,  61, Err, Err, Err, Err, Err, Err, // 0x38
+                Err,   0,   1,   2,   3,   4,   5,   6, // 0x40
+                  7,   8,   9,  10,  11,  12,  13,  14, // 0x48
+                 15,  16,  17,  18,  19,  20,  21,  22, // 0x50
+                 23,  24,  25, Err, Err, Err, Err, Err, // 0x58
+                Err,  26,  27,  28,  29,  30,  31,  32, // 0x60
+                 33,  34,  35,  36,  37,  38,  39,  40, // 0x68
+                 41,  42,  43,  44,  45,  46,  47,  48, // 0x70
+                 49,  50,  51, Err, Err, Err, Err, Err, // 0x78
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x80
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x88
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x90
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0x98
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xA0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xA8
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xB0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xB8
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xC0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xC8
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xD0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xD8
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xE0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xE8
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xF0
+                Err, Err, Err, Err, Err, Err, Err, Err, // 0xF8
+        };
 
-    uint8_t decodeCharacter(char c)
-    {
-        if (c < 0 || DecodingTable[static_cast<unsigned char>(c)] == Err)
-            YSON_THROW(std::string("Invalid Base64 character: '") + c + "'");
-        return DecodingTable[static_cast<unsigned char>(c)];
+        constexpr size_t getEncodedSize(size_t decodedSize)
+        {
+            return 4 * ((decodedSize + 2) / 3);
+        }
+
+        constexpr size_t getDecodedSize(size_t encodedSize)
+        {
+            return (3 * encodedSize) / 4;
+        }
+
+        [[noreturn]]
+        void throwInvalidCharacter(const char* text, size_t size)
+        {
+            for (size_t i = 0; i < size; ++i)
+            {
+                if (DecodingTable[static_cast<unsigned char>(text[i])] == Err)
+                    YSON_THROW(std::string("Invalid Base64 character: '")
+                               + text[i] + "'");
+            }
+            YSON_THROW("Invalid Base64 string.");
+        }
+
+#ifdef YSON_BASE64_SSSE3
+
+        // The SSSE3 encoder and decoder use the algorithms described by
+        // Wojciech Muła and Daniel Lemire in "Faster Base64 Encoding and
+        // Decoding Using AVX2 Instructions" (2018), scaled down to
+        // 128-bit registers.
+
+        /**
+         * @brief Encodes groups of 12 bytes in @a data as long as there
+         *  are at least 16 bytes left to read.
+         *
+         * @return The number of bytes that were encoded.
+         */
+        size_t encodeSsse3(const uint8_t* data, size_t size, char* out)
+        {
+            const auto shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4,
+                                               7, 6, 8, 7, 10, 9, 11, 10);
+            const auto offsets = _mm_setr_epi8(65, 71, -4, -4, -4, -4, -4, -4,
+                                               -4, -4, -4, -4, -19, -16, 0, 0);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 12)
+            {
+                auto in = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(data + i));
+                // Spread the 6-bit values out over 16 bytes.
+                in = _mm_shuffle_epi8(in, shuffle);
+                const auto t0 = _mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00));
+                const auto t1 = _mm_mulhi_epu16(t0,
+                                                _mm_set1_epi32(0x04000040));
+                const auto t2 = _mm_and_si128(in, _mm_set1_epi32(0x003F03F0));
+                const auto t3 = _mm_mullo_epi16(t2,
+                                                _mm_set1_epi32(0x01000010));
+                const auto values = _mm_or_si128(t1, t3);
+                // Translate the values to characters by adding the offset
+                // of the range each value belongs to.
+                auto ranges = _mm_subs_epu8(values, _mm_set1_epi8(51));
+                ranges = _mm_sub_epi8(
+                    ranges, _mm_cmpgt_epi8(values, _mm_set1_epi8(25)));
+                const auto chars = _mm_add_epi8(
+                    values, _mm_shuffle_epi8(offsets, ranges));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+                out += 16;
+            }
+            return i;
+        }
+
+        /**
+         * @brief Decodes groups of 16 characters in @a text until it
+         *  reaches an invalid character or there are fewer than 16
+         *  characters left.
+         *
+         * @return The number of characters that were decoded.
+         */
+        size_t decodeSsse3(const char* text, size_t size, char* out)
+        {
+            const auto lutLo = _mm_setr_epi8(
+                0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+                0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+            const auto lutHi = _mm_setr_epi8(
+                0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+                0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+            const auto lutRoll = _mm_setr_epi8(
+                0, 16, 19, 4, -65, -65, -71, -71,
+                0, 0, 0, 0, 0, 0, 0, 0);
+            const auto mask2F = _mm_set1_epi8(0x2F);
+            const auto pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9,
+                                            8, 14, 13, 12, -1, -1, -1, -1);
+            size_t i = 0;
+            for (; i + 16 <= size; i += 16)
+            {
+                auto in = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(text + i));
+                const auto hiNibbles = _mm_and_si128(_mm_srli_epi32(in, 4),
+                                                     mask2F);
+                const auto loNibbles = _mm_and_si128(in, mask2F);
+                const auto hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+                const auto lo = _mm_shuffle_epi8(lutLo, loNibbles);
+                // Every byte that isn't a Base64 character has a bit
+                // that is set in both hi and lo.
+                if (_mm_movemask_epi8(_mm_cmpgt_epi8(
+                        _mm_and_si128(lo, hi), _mm_setzero_si128())))
+                {
+                    break;
+                }
+                const auto eq2F = _mm_cmpeq_epi8(in, mask2F);
+                const auto roll = _mm_shuffle_epi8(
+                    lutRoll, _mm_add_epi8(eq2F, hiNibbles));
+                in = _mm_add_epi8(in, roll);
+                // Merge the 6-bit values into 24-bit groups and move the
+                // groups' bytes into big-endian order at the front.
+                const auto merged = _mm_madd_epi16(
+                    _mm_maddubs_epi16(in, _mm_set1_epi32(0x01400140)),
+                    _mm_set1_epi32(0x00011000));
+                const auto bytes = _mm_shuffle_epi8(merged, pack);
+                _mm_storel_epi64(reinterpret_cast<__m128i*>(out), bytes);
+                const auto last = _mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+                memcpy(out + 8, &last, 4);
+                out += 12;
+            }
+            return i;
+        }
+
+#endif
+
+        /**
+         * @brief Decodes @a size characters in @a text, where @a size
+         *  is a multiple of 4, to @a out.
+         *
+         * @throw YsonException if @a text contains invalid characters.
+         */
+        void decodeGroups(const char* text, size_t size, char* out)
+        {
+#ifdef YSON_BASE64_SSSE3
+            const auto decodedSize = decodeSsse3(text, size, out);
+            text += decodedSize;
+            size -= decodedSize;
+            out += getDecodedSize(decodedSize);
+#endif
+
+            for (size_t i = 0; i < size; i += 4)
+            {
+                const uint32_t a = DecodingTable[uint8_t(text[i])];
+                const uint32_t b = DecodingTable[uint8_t(text[i + 1])];
+                const uint32_t c = DecodingTable[uint8_t(text[i + 2])];
+                const uint32_t d = DecodingTable[uint8_t(text[i + 3])];
+                // Valid values are less than 64, a single test is
+                // enough to check all four characters.
+                if ((a | b | c | d) & 0x80)
+                    throwInvalidCharacter(text + i, 4);
+                const uint32_t word = (a << 18) | (b << 12) | (c << 6) | d;
+                out[0] = char(word >> 16);
+                out[1] = char(word >> 8);
+                out[2] = char(word);
+                out += 3;
+            }
+        }
+
+        /**
+         * @brief Decodes the 2 or 3 characters at the end of a string
+         *  whose length isn't a multiple of 4.
+         */
+        void decodeTail(const char* text, size_t size, char* out)
+        {
+            if (size < 2)
+                return;
+            uint32_t values[3] = {};
+            for (size_t i = 0; i < size; ++i)
+            {
+                values[i] = DecodingTable[uint8_t(text[i])];
+                if (values[i] == Err)
+                    throwInvalidCharacter(text, size);
+            }
+            const uint32_t word = (values[0] << 18) | (values[1] << 12)
+                                  | (values[2] << 6);
+            out[0] = char(word >> 16);
+            if (size == 3)
+                out[1] = char(word >> 8);
+        }
+
+        /**
+         * @brief Returns the number of characters in @a text, not
+         *  counting the padding.
+         */
+        size_t getUnpaddedSize(std::string_view text)
+        {
+            auto last = text.find_last_not_of('=');
+            return last == std::string_view::npos ? 0 : last + 1;
+        }
+
+        void decode(std::string_view text, char* out)
+        {
+            const auto tailSize = text.size() % 4;
+            const auto mainSize = text.size() - tailSize;
+            decodeGroups(text.data(), mainSize, out);
+            decodeTail(text.data() + mainSize, tailSize,
+                       out + getDecodedSize(mainSize));
+        }
     }
 
     std::string toBase64(const void* data, size_t size)
     {
-        std::string result;
-        result.reserve(getEncodedSize(size));
+        std::string result(getEncodedSize(size), '=');
+        auto out = result.data();
         auto data8 = static_cast<const uint8_t*>(data);
-        auto tailSize = size % 3;
-        auto mainSize = size - tailSize;
         size_t i = 0;
+#ifdef YSON_BASE64_SSSE3
+        i = encodeSsse3(data8, size, out);
+        out += getEncodedSize(i);
+#endif
+        auto tailSize = (size - i) % 3;
+        auto mainSize = size - tailSize;
         for (; i < mainSize; i += 3)
         {
             uint32_t word = (data8[i] << 16) | (data8[i + 1] << 8)
                             | data8[i + 2];
-            result.push_back(EncodingTable[(word >> 18) & 0x3F]);
-            result.push_back(EncodingTable[(word >> 12) & 0x3F]);
-            result.push_back(EncodingTable[(word >> 6) & 0x3F]);
-            result.push_back(EncodingTable[word & 0x3F]);
+            out[0] = EncodingTable[(word >> 18) & 0x3F];
+            out[1] = EncodingTable[(word >> 12) & 0x3F];
+            out[2] = EncodingTable[(word >> 6) & 0x3F];
+            out[3] = EncodingTable[word & 0x3F];
+            out += 4;
         }
 
+        // The padding is already in place.
         if (tailSize == 1)
         {
             uint32_t word = (data8[i] << 16);
-            result.push_back(EncodingTable[(word >> 18) & 0x3F]);
-            result.push_back(EncodingTable[(word >> 12) & 0x3F]);
-            result.push_back('=');
-            result.push_back('=');
+            out[0] = EncodingTable[(word >> 18) & 0x3F];
+            out[1] = EncodingTable[(word >> 12) & 0x3F];
         }
         else if (tailSize == 2)
         {
             uint32_t word = (data8[i] << 16) | (data8[i + 1] << 8);
-            result.push_back(EncodingTable[(word >> 18) & 0x3F]);
-            result.push_back(EncodingTable[(word >> 12) & 0x3F]);
-            result.push_back(EncodingTable[(word >> 6) & 0x3F]);
-            result.push_back('=');
+            out[0] = EncodingTable[(word >> 18) & 0x3F];
+            out[1] = EncodingTable[(word >> 12) & 0x3F];
+            out[2] = EncodingTable[(word >> 6) & 0x3F];
         }
         return result;
     }
 
     bool fromBase64(std::string_view text, char* buffer, size_t& size)
     {
-        auto last = text.find_last_not_of('=');
-        if (last == std::string_view::npos)
-        {
-            size = 0;
-            return true;
-        }
-        auto encodedSize = last + 1;
-        auto decodedSize = getDecodedSize(encodedSize);
+        text = text.substr(0, getUnpaddedSize(text));
+        auto decodedSize = getDecodedSize(text.size());
         if (!buffer)
         {
             size = decodedSize;
@@ -110,71 +317,16 @@ namespace Yson
         if (size < decodedSize)
             return false;
         size = decodedSize;
-        auto tailSize = encodedSize % 4;
-        auto mainSize = encodedSize - tailSize;
-        size_t i = 0;
-        size_t j = 0;
-        for (; i < mainSize; i += 4)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12)
-                            | (decodeCharacter(text[i + 2]) << 6)
-                            | decodeCharacter(text[i + 3]);
-            buffer[j++] = char(word >> 16);
-            buffer[j++] = char(word >> 8);
-            buffer[j++] = char(word);
-        }
-        if (tailSize == 3)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12)
-                            | (decodeCharacter(text[i + 2]) << 6);
-            buffer[j++] = char(word >> 16);
-            buffer[j++] = char(word >> 8);
-        }
-        else if (tailSize == 2)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12);
-            buffer[j++] = char(word >> 16);
-        }
+        decode(text, buffer);
         return true;
     }
 
     bool fromBase64(std::string_view text, std::vector<char>& buffer)
     {
-        auto last = text.find_last_not_of('=');
-        if (last == std::string_view::npos)
-            return true;
-        auto size = last + 1;
-        buffer.reserve(buffer.size() + getDecodedSize(size));
-        auto tailSize = size % 4;
-        auto mainSize = size - tailSize;
-        size_t i = 0;
-        for (; i < mainSize; i += 4)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12)
-                            | (decodeCharacter(text[i + 2]) << 6)
-                            | decodeCharacter(text[i + 3]);
-            buffer.push_back(char(word >> 16));
-            buffer.push_back(char(word >> 8));
-            buffer.push_back(char(word));
-        }
-        if (tailSize == 3)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12)
-                            | (decodeCharacter(text[i + 2]) << 6);
-            buffer.push_back(char(word >> 16));
-            buffer.push_back(char(word >> 8));
-        }
-        else if (tailSize == 2)
-        {
-            uint32_t word = (decodeCharacter(text[i]) << 18)
-                            | (decodeCharacter(text[i + 1]) << 12);
-            buffer.push_back(char(word >> 16));
-        }
+        text = text.substr(0, getUnpaddedSize(text));
+        auto offset = buffer.size();
+        buffer.resize(offset + getDecodedSize(text.size()));
+        decode(text, buffer.data() + offset);
         return true;
     }
 
@@ -186,4 +338,3 @@ namespace Yson
         YSON_THROW("Not a Base64 string.");
     }
 }
-
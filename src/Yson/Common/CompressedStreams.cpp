@@ -0,0 +1,905 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "CompressedStreams.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <thread>
+#include <vector>
+#include "Yson/YsonException.hpp"
+
+#ifdef YSON_HAS_ZLIB
+    #include <zlib.h>
+#endif
+
+#ifdef YSON_HAS_ZSTD
+    #include <zstd.h>
+#endif
+
+namespace Yson
+{
+    namespace
+    {
+        constexpr size_t INPUT_BLOCK_SIZE = 64 * 1024;
+        constexpr size_t OUTPUT_BLOCK_SIZE = 256 * 1024;
+        /// The number of decompressed blocks: one that is being read,
+        /// and up to two that the background thread fills in advance.
+        constexpr size_t MAX_BLOCKS = 3;
+
+        const char* getName(Compression compression)
+        {
+            switch (compression)
+            {
+            case Compression::GZIP:
+                return "gzip";
+            case Compression::ZLIB:
+                return "zlib";
+            case Compression::ZSTD:
+                return "zstd";
+            default:
+                return "no";
+            }
+        }
+
+        [[noreturn]]
+        void throwUnsupported(Compression compression)
+        {
+            YSON_THROW(std::string("Yson was built without support for ")
+                       + getName(compression) + " compression.");
+        }
+
+        class Decoder
+        {
+        public:
+            virtual ~Decoder() = default;
+
+            /**
+             * @brief Decompresses as much of @a in as fits in @a out, and
+             *  advances both.
+             *
+             * Returns true when the end of a gzip member or zstd frame
+             * has been reached.
+             */
+            virtual bool decode(const char*& in, size_t& inSize,
+                                char*& out, size_t& outSize) = 0;
+
+            /**
+             * @brief Prepares the decoder for another gzip member or zstd
+             *  frame.
+             */
+            virtual void restart() = 0;
+        };
+
+        class Encoder
+        {
+        public:
+            virtual ~Encoder() = default;
+
+            /**
+             * @brief Compresses as much of @a in as possible into @a out,
+             *  and advances both.
+             *
+             * When @a finish is true, the trailer is written after the
+             * input and the function returns true when everything has
+             * been written.
+             */
+            virtual bool encode(const char*& in, size_t& inSize,
+                                char*& out, size_t& outSize,
+                                bool finish) = 0;
+        };
+
+#ifdef YSON_HAS_ZLIB
+        class ZlibDecoder : public Decoder
+        {
+        public:
+            ZlibDecoder()
+            {
+                // 15 + 32: the maximum window size, and automatic
+                // detection of the gzip and zlib headers.
+                if (inflateInit2(&m_Stream, 15 + 32) != Z_OK)
+                    YSON_THROW("Unable to initialize zlib.");
+            }
+
+            ~ZlibDecoder() override
+            {
+                inflateEnd(&m_Stream);
+            }
+
+            bool decode(const char*& in, size_t& inSize,
+                        char*& out, size_t& outSize) override
+            {
+                const auto inChunk = std::min<size_t>(inSize, UINT_MAX);
+                const auto outChunk = std::min<size_t>(outSize, UINT_MAX);
+                m_Stream.next_in = reinterpret_cast<Bytef*>(
+                    const_cast<char*>(in));
+                m_Stream.avail_in = uInt(inChunk);
+                m_Stream.next_out = reinterpret_cast<Bytef*>(out);
+                m_Stream.avail_out = uInt(outChunk);
+                const auto result = inflate(&m_Stream, Z_NO_FLUSH);
+                in += inChunk - m_Stream.avail_in;
+                inSize -= inChunk - m_Stream.avail_in;
+                out += outChunk - m_Stream.avail_out;
+                outSize -= outChunk - m_Stream.avail_out;
+                if (result == Z_STREAM_END)
+                    return true;
+                if (result != Z_OK && result != Z_BUF_ERROR)
+                {
+                    YSON_THROW(std::string("Invalid compressed input: ")
+                               + (m_Stream.msg ? m_Stream.msg
+                                               : "zlib error "
+                                                 + std::to_string(result)));
+                }
+                return false;
+            }
+
+            void restart() override
+            {
+                inflateReset(&m_Stream);
+            }
+        private:
+            z_stream m_Stream = {};
+        };
+
+        class ZlibEncoder : public Encoder
+        {
+        public:
+            ZlibEncoder(Compression compression, int level)
+            {
+                level = level < 0 ? Z_DEFAULT_COMPRESSION
+                                  : std::min(level, 9);
+                // 15 + 16: the maximum window size and a gzip header.
+                const int windowBits = compression == Compression::GZIP
+                                           ? 15 + 16
+                                           : 15;
+                if (deflateInit2(&m_Stream, level, Z_DEFLATED, windowBits,
+                                 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                {
+                    YSON_THROW("Unable to initialize zlib.");
+                }
+            }
+
+            ~ZlibEncoder() override
+            {
+                deflateEnd(&m_Stream);
+            }
+
+            bool encode(const char*& in, size_t& inSize,
+                        char*& out, size_t& outSize, bool finish) override
+            {
+                const auto inChunk = std::min<size_t>(inSize, UINT_MAX);
+                const auto outChunk = std::min<size_t>(outSize, UINT_MAX);
+                m_Stream.next_in = reinterpret_cast<Bytef*>(
+                    const_cast<char*>(in));
+                m_Stream.avail_in = uInt(inChunk);
+                m_Stream.next_out = reinterpret_cast<Bytef*>(out);
+                m_Stream.avail_out = uInt(outChunk);
+                const auto result = deflate(
+                    &m_Stream,
+                    finish && inChunk == inSize ? Z_FINISH : Z_NO_FLUSH);
+                in += inChunk - m_Stream.avail_in;
+                inSize -= inChunk - m_Stream.avail_in;
+                out += outChunk - m_Stream.avail_out;
+                outSize -= outChunk - m_Stream.avail_out;
+                if (result == Z_STREAM_ERROR)
+                    YSON_THROW("zlib compression failed.");
+                return result == Z_STREAM_END;
+            }
+        private:
+            z_stream m_Stream = {};
+        };
+#endif
+
+#ifdef YSON_HAS_ZSTD
+        void checkZstdResult(size_t result)
+        {
+            if (ZSTD_isError(result))
+            {
+                YSON_THROW(std::string("zstd error: ")
+                           + ZSTD_getErrorName(result));
+            }
+        }
+
+        class ZstdDecoder : public Decoder
+        {
+        public:
+            ZstdDecoder()
+                : m_Context(ZSTD_createDCtx())
+            {
+                if (!m_Context)
+                    YSON_THROW("Unable to initialize zstd.");
+            }
+
+            ~ZstdDecoder() override
+            {
+                ZSTD_freeDCtx(m_Context);
+            }
+
+            bool decode(const char*& in, size_t& inSize,
+                        char*& out, size_t& outSize) override
+            {
+                ZSTD_inBuffer input = {in, inSize, 0};
+                ZSTD_outBuffer output = {out, outSize, 0};
+                const auto result = ZSTD_decompressStream(m_Context, &output,
+                                                          &input);
+                checkZstdResult(result);
+                in += input.pos;
+                inSize -= input.pos;
+                out += output.pos;
+                outSize -= output.pos;
+                return result == 0;
+            }
+
+            void restart() override
+            {
+                // A zstd context continues with the next frame on its own.
+            }
+        private:
+            ZSTD_DCtx* m_Context;
+        };
+
+        class ZstdEncoder : public Encoder
+        {
+        public:
+            explicit ZstdEncoder(int level)
+                : m_Context(ZSTD_createCCtx())
+            {
+                if (!m_Context)
+                    YSON_THROW("Unable to initialize zstd.");
+                if (level >= 0)
+                {
+                    checkZstdResult(ZSTD_CCtx_setParameter(
+                        m_Context, ZSTD_c_compressionLevel, level));
+                }
+            }
+
+            ~ZstdEncoder() override
+            {
+                ZSTD_freeCCtx(m_Context);
+            }
+
+            bool encode(const char*& in, size_t& inSize,
+                        char*& out, size_t& outSize, bool finish) override
+            {
+                ZSTD_inBuffer input = {in, inSize, 0};
+                ZSTD_outBuffer output = {out, outSize, 0};
+                const auto result = ZSTD_compressStream2(
+                    m_Context, &output, &input,
+                    finish ? ZSTD_e_end : ZSTD_e_continue);
+                checkZstdResult(result);
+                in += input.pos;
+                inSize -= input.pos;
+                out += output.pos;
+                outSize -= output.pos;
+                return finish && result == 0;
+            }
+        private:
+            ZSTD_CCtx* m_Context;
+        };
+#endif
+
+        std::unique_ptr<Decoder> makeDecoder(Compression compression)
+        {
+            switch (compression)
+            {
+#ifdef YSON_HAS_ZLIB
+            case Compression::GZIP:
+            case Compression::ZLIB:
+                return std::make_unique<ZlibDecoder>();
+#endif
+#ifdef YSON_HAS_ZSTD
+            case Compression::ZSTD:
+                return std::make_unique<ZstdDecoder>();
+#endif
+            default:
+                throwUnsupported(compression);
+            }
+        }
+
+        std::unique_ptr<Encoder> makeEncoder(Compression compression,
+                                             [[maybe_unused]] int level)
+        {
+            switch (compression)
+            {
+#ifdef YSON_HAS_ZLIB
+            case Compression::GZIP:
+            case Compression::ZLIB:
+                return std::make_unique<ZlibEncoder>(compression, level);
+#endif
+#ifdef YSON_HAS_ZSTD
+            case Compression::ZSTD:
+                return std::make_unique<ZstdEncoder>(level);
+#endif
+            default:
+                throwUnsupported(compression);
+            }
+        }
+
+        /**
+         * @brief A stream buffer that decompresses its input in a
+         *  background thread.
+         *
+         * The thread decompresses into blocks of OUTPUT_BLOCK_SIZE bytes
+         * and hands them to underflow, which makes each block the get
+         * area. Only forward seeks relative to the current position, and
+         * tellg, are supported.
+         */
+        class DecompressingStreamBuf : public std::streambuf
+        {
+        public:
+            DecompressingStreamBuf(std::istream* source,
+                                   const char* prefix, size_t prefixSize,
+                                   bool copyPrefix,
+                                   Compression compression)
+                : m_Source(source),
+                  m_Prefix(prefix),
+                  m_PrefixSize(prefixSize),
+                  m_Decoder(makeDecoder(compression))
+            {
+                if (copyPrefix && prefixSize)
+                {
+                    m_PrefixCopy.assign(prefix, prefixSize);
+                    m_Prefix = m_PrefixCopy.data();
+                }
+                m_Thread = std::thread([this] {run();});
+            }
+
+            ~DecompressingStreamBuf() override
+            {
+                {
+                    std::lock_guard lock(m_Mutex);
+                    m_Stopped = true;
+                }
+                m_CanWrite.notify_all();
+                m_Thread.join();
+            }
+        protected:
+            int_type underflow() override
+            {
+                if (gptr() < egptr())
+                    return traits_type::to_int_type(*gptr());
+
+                std::unique_lock lock(m_Mutex);
+                if (m_Current.data)
+                {
+                    m_BlockOffset += m_Current.size;
+                    m_Free.push_back(std::move(m_Current));
+                    m_Current = {};
+                    setg(nullptr, nullptr, nullptr);
+                    m_CanWrite.notify_one();
+                }
+
+                m_CanRead.wait(lock, [this]
+                {
+                    return !m_Filled.empty() || m_Finished;
+                });
+                if (m_Filled.empty())
+                {
+                    if (m_Error)
+                        std::rethrow_exception(m_Error);
+                    return traits_type::eof();
+                }
+
+                m_Current = std::move(m_Filled.front());
+                m_Filled.pop_front();
+                auto* data = m_Current.data.get();
+                setg(data, data, data + m_Current.size);
+                return traits_type::to_int_type(*gptr());
+            }
+
+            pos_type seekoff(off_type offset, std::ios_base::seekdir dir,
+                             std::ios_base::openmode which) override
+            {
+                if (dir != std::ios_base::cur
+                    || !(which & std::ios_base::in)
+                    || offset < 0)
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                while (offset > egptr() - gptr())
+                {
+                    offset -= egptr() - gptr();
+                    setg(eback(), egptr(), egptr());
+                    if (traits_type::eq_int_type(underflow(),
+                                                 traits_type::eof()))
+                    {
+                        return pos_type(off_type(-1));
+                    }
+                }
+                gbump(int(offset));
+                return pos_type(off_type(m_BlockOffset + (gptr() - eback())));
+            }
+        private:
+            struct Block
+            {
+                std::unique_ptr<char[]> data;
+                size_t size = 0;
+            };
+
+            void run()
+            {
+                try
+                {
+                    const char* in = m_Prefix;
+                    size_t inSize = m_PrefixSize;
+                    bool endOfInput = false;
+                    bool endOfFrame = false;
+                    while (!endOfInput)
+                    {
+                        Block block;
+                        if (!takeFreeBlock(block))
+                            return;
+
+                        char* out = block.data.get();
+                        size_t outSize = OUTPUT_BLOCK_SIZE;
+                        while (outSize != 0)
+                        {
+                            if (inSize == 0)
+                            {
+                                inSize = readInput(in);
+                                if (inSize == 0)
+                                {
+                                    endOfInput = true;
+                                    break;
+                                }
+                            }
+                            // Concatenated gzip members and zstd frames
+                            // are decompressed as a single stream.
+                            if (endOfFrame)
+                            {
+                                m_Decoder->restart();
+                                endOfFrame = false;
+                            }
+                            endOfFrame = m_Decoder->decode(in, inSize,
+                                                           out, outSize);
+                        }
+
+                        block.size = OUTPUT_BLOCK_SIZE - outSize;
+                        putFilledBlock(std::move(block));
+                    }
+
+                    if (!endOfFrame)
+                        YSON_THROW("The compressed input is truncated.");
+                    finish(nullptr);
+                }
+                catch (...)
+                {
+                    finish(std::current_exception());
+                }
+            }
+
+            size_t readInput(const char*& in)
+            {
+                if (!m_Source)
+                    return 0;
+                if (!m_Input)
+                    m_Input.reset(new char[INPUT_BLOCK_SIZE]);
+                m_Source->read(m_Input.get(),
+                               std::streamsize(INPUT_BLOCK_SIZE));
+                if (m_Source->bad())
+                    YSON_THROW("Unable to read the compressed input.");
+                in = m_Input.get();
+                return size_t(m_Source->gcount());
+            }
+
+            bool takeFreeBlock(Block& block)
+            {
+                std::unique_lock lock(m_Mutex);
+                m_CanWrite.wait(lock, [this]
+                {
+                    return m_Stopped || !m_Free.empty()
+                           || m_BlockCount < MAX_BLOCKS;
+                });
+                if (m_Stopped)
+                    return false;
+
+                if (!m_Free.empty())
+                {
+                    block = std::move(m_Free.back());
+                    m_Free.pop_back();
+                }
+                else
+                {
+                    ++m_BlockCount;
+                    lock.unlock();
+                    block.data.reset(new char[OUTPUT_BLOCK_SIZE]);
+                }
+                return true;
+            }
+
+            void putFilledBlock(Block block)
+            {
+                {
+                    std::lock_guard lock(m_Mutex);
+                    if (block.size == 0)
+                    {
+                        m_Free.push_back(std::move(block));
+                        return;
+                    }
+                    m_Filled.push_back(std::move(block));
+                }
+                m_CanRead.notify_one();
+            }
+
+            void finish(std::exception_ptr error)
+            {
+                {
+                    std::lock_guard lock(m_Mutex);
+                    m_Error = std::move(error);
+                    m_Finished = true;
+                }
+                m_CanRead.notify_one();
+            }
+
+            std::istream* m_Source;
+            std::string m_PrefixCopy;
+            const char* m_Prefix;
+            size_t m_PrefixSize;
+            std::unique_ptr<Decoder> m_Decoder;
+            std::unique_ptr<char[]> m_Input;
+
+            std::mutex m_Mutex;
+            std::condition_variable m_CanRead;
+            std::condition_variable m_CanWrite;
+            std::deque<Block> m_Filled;
+            std::vector<Block> m_Free;
+            size_t m_BlockCount = 0;
+            bool m_Finished = false;
+            bool m_Stopped = false;
+            std::exception_ptr m_Error;
+
+            // Only used by the reading thread.
+            Block m_Current;
+            size_t m_BlockOffset = 0;
+
+            std::thread m_Thread;
+        };
+
+        class DecompressingStream : public std::istream
+        {
+        public:
+            explicit DecompressingStream(
+                    std::unique_ptr<DecompressingStreamBuf> buffer)
+                : std::istream(buffer.get()),
+                  m_Buffer(std::move(buffer))
+            {
+                // Let decompression errors reach the reader instead of
+                // just setting badbit.
+                exceptions(std::ios_base::badbit);
+            }
+        private:
+            std::unique_ptr<DecompressingStreamBuf> m_Buffer;
+        };
+
+        /**
+         * @brief A stream buffer that compresses everything written to it
+         *  and writes the result to another stream.
+         *
+         * The writers write their whole buffer in a single call when
+         * they flush, and xsputn compresses it directly from there.
+         */
+        class CompressingStreamBuf : public std::streambuf
+        {
+        public:
+            CompressingStreamBuf(std::ostream& target,
+                                 Compression compression, int level)
+                : m_Target(target),
+                  m_Encoder(makeEncoder(compression, level)),
+                  m_Output(new char[OUTPUT_BLOCK_SIZE]),
+                  m_Out(m_Output.get()),
+                  m_OutSize(OUTPUT_BLOCK_SIZE)
+            {}
+
+            ~CompressingStreamBuf() override
+            {
+                try
+                {
+                    finish();
+                }
+                catch (...)
+                {}
+            }
+
+            void finish()
+            {
+                if (m_Finished)
+                    return;
+                m_Finished = true;
+                const char* in = nullptr;
+                size_t inSize = 0;
+                while (!m_Encoder->encode(in, inSize, m_Out, m_OutSize, true))
+                    writeOutput();
+                writeOutput();
+                m_Target.flush();
+            }
+        protected:
+            std::streamsize xsputn(const char* s, std::streamsize n) override
+            {
+                const char* in = s;
+                auto inSize = size_t(n);
+                while (inSize != 0)
+                {
+                    m_Encoder->encode(in, inSize, m_Out, m_OutSize, false);
+                    if (m_OutSize == 0)
+                        writeOutput();
+                }
+                return n;
+            }
+
+            int_type overflow(int_type ch) override
+            {
+                if (traits_type::eq_int_type(ch, traits_type::eof()))
+                    return traits_type::not_eof(ch);
+                const auto c = traits_type::to_char_type(ch);
+                xsputn(&c, 1);
+                return ch;
+            }
+
+            int sync() override
+            {
+                writeOutput();
+                m_Target.flush();
+                return m_Target ? 0 : -1;
+            }
+        private:
+            void writeOutput()
+            {
+                const auto size = OUTPUT_BLOCK_SIZE - m_OutSize;
+                if (size != 0)
+                    m_Target.write(m_Output.get(), std::streamsize(size));
+                m_Out = m_Output.get();
+                m_OutSize = OUTPUT_BLOCK_SIZE;
+            }
+
+            std::ostream& m_Target;
+            std::unique_ptr<Encoder> m_Encoder;
+            std::unique_ptr<char[]> m_Output;
+            char* m_Out;
+            size_t m_OutSize;
+            bool m_Finished = false;
+        };
+
+        class CompressingStream : public std::ostream
+        {
+        public:
+            CompressingStream(std::unique_ptr<std::ostream> target,
+                              std::unique_ptr<CompressingStreamBuf> buffer)
+                : std::ostream(buffer.get()),
+                  m_Target(std::move(target)),
+                  m_Buffer(std::move(buffer))
+            {
+                exceptions(std::ios_base::badbit);
+            }
+
+        private:
+            // The buffer is destroyed first, it writes the end of the
+            // compressed data to the target.
+            std::unique_ptr<std::ostream> m_Target;
+            std::unique_ptr<CompressingStreamBuf> m_Buffer;
+        };
+
+        bool startsWith(const char* data, size_t size,
+                        std::initializer_list<uint8_t> magic)
+        {
+            if (size < 2)
+                return false;
+            size = std::min(size, magic.size());
+            return std::equal(data, data + size, magic.begin(),
+                              [](char a, uint8_t b) {return uint8_t(a) == b;});
+        }
+
+        bool canStartMagicNumber(char c)
+        {
+            return c == '\x1F' || c == '\x28' || c == '\x78';
+        }
+
+        /**
+         * @brief Copies the first two bytes of @a buffer followed by the
+         *  rest of @a stream to @a header, without consuming anything
+         *  from @a stream.
+         *
+         * @return The number of bytes in @a header.
+         */
+        size_t peekHeader(std::istream& stream,
+                          const char* buffer, size_t bufferSize,
+                          char (&header)[2])
+        {
+            using Traits = std::istream::traits_type;
+            size_t size = buffer ? std::min<size_t>(bufferSize, 2) : 0;
+            std::copy_n(buffer, size, header);
+            auto streamBuf = stream.rdbuf();
+            if (size == 2 || !streamBuf)
+                return size;
+
+            auto c = streamBuf->sgetc();
+            if (c == Traits::eof())
+                return size;
+            header[size++] = Traits::to_char_type(c);
+            if (size == 2 || !canStartMagicNumber(header[0]))
+                return size;
+
+            // The second byte can only be examined by reading the first
+            // one and putting it back.
+            streamBuf->sbumpc();
+            c = streamBuf->sgetc();
+            if (streamBuf->sputbackc(header[0]) == Traits::eof())
+                YSON_THROW("Unable to detect the compression of the stream.");
+            if (c != Traits::eof())
+                header[size++] = Traits::to_char_type(c);
+            return size;
+        }
+    }
+
+    bool isCompressionSupported(Compression compression)
+    {
+        switch (compression)
+        {
+        case Compression::NONE:
+        case Compression::AUTO:
+            return true;
+#ifdef YSON_HAS_ZLIB
+        case Compression::GZIP:
+        case Compression::ZLIB:
+            return true;
+#endif
+#ifdef YSON_HAS_ZSTD
+        case Compression::ZSTD:
+            return true;
+#endif
+        default:
+            return false;
+        }
+    }
+
+    std::unique_ptr<std::ostream>
+    makeCompressingStream(std::ostream& stream, Compression compression,
+                          int level)
+    {
+        return std::make_unique<CompressingStream>(
+            nullptr,
+            std::make_unique<CompressingStreamBuf>(stream, compression,
+                                                   level));
+    }
+
+    Compression detectCompression(const char* data, size_t size)
+    {
+        if (size < 2)
+            return Compression::NONE;
+
+        if (startsWith(data, size, {0x1F, 0x8B}))
+            return Compression::GZIP;
+        if (startsWith(data, size, {0x28, 0xB5, 0x2F, 0xFD}))
+            return Compression::ZSTD;
+        // The zlib header is 0x78 (deflate with a 32K window) followed
+        // by a byte that makes the header a multiple of 31.
+        if (uint8_t(data[0]) == 0x78
+            && (0x7800 + uint8_t(data[1])) % 31 == 0)
+        {
+            return Compression::ZLIB;
+        }
+        return Compression::NONE;
+    }
+
+    Compression getStreamCompression(const ReaderOptions& options)
+    {
+        if (options.compression == Compression::AUTO
+            && !options.detectStreamCompression)
+        {
+            return Compression::NONE;
+        }
+        return options.compression;
+    }
+
+    Compression getCompression(const std::filesystem::path& fileName)
+    {
+        const auto extension = fileName.extension();
+        if (extension == ".gz")
+            return Compression::GZIP;
+        if (extension == ".zz")
+            return Compression::ZLIB;
+        if (extension == ".zst")
+            return Compression::ZSTD;
+        return Compression::NONE;
+    }
+
+    std::unique_ptr<std::istream>
+    openDecompressingStream(std::istream& stream,
+                            const char* buffer, size_t bufferSize,
+                            Compression compression)
+    {
+        if (compression == Compression::AUTO)
+        {
+            char header[2];
+            const auto size = peekHeader(stream, buffer, bufferSize, header);
+            compression = detectCompression(header, size);
+        }
+
+        if (compression == Compression::NONE)
+            return {};
+
+        return std::make_unique<DecompressingStream>(
+            std::make_unique<DecompressingStreamBuf>(
+                &stream, buffer, buffer ? bufferSize : 0, true,
+                compression));
+    }
+
+    std::unique_ptr<std::istream>
+    openDecompressingStream(const char* buffer, size_t bufferSize,
+                            Compression compression)
+    {
+        if (compression == Compression::AUTO)
+            compression = detectCompression(buffer, bufferSize);
+
+        if (compression == Compression::NONE)
+            return {};
+
+        return std::make_unique<DecompressingStream>(
+            std::make_unique<DecompressingStreamBuf>(
+                nullptr, buffer, bufferSize, false, compression));
+    }
+
+    std::string decompressStart(const char* buffer, size_t bufferSize,
+                                Compression compression, size_t maxSize)
+    {
+        if (compression == Compression::AUTO)
+            compression = detectCompression(buffer, bufferSize);
+        if (compression == Compression::NONE)
+            return {buffer, std::min(bufferSize, maxSize)};
+
+        auto decoder = makeDecoder(compression);
+        std::string result(maxSize, '\0');
+        const char* in = buffer;
+        size_t inSize = bufferSize;
+        char* out = result.data();
+        size_t outSize = maxSize;
+        bool endOfFrame = false;
+        while (inSize != 0 && outSize != 0)
+        {
+            if (endOfFrame)
+            {
+                decoder->restart();
+                endOfFrame = false;
+            }
+            endOfFrame = decoder->decode(in, inSize, out, outSize);
+        }
+        result.resize(maxSize - outSize);
+        return result;
+    }
+
+    std::unique_ptr<std::ostream>
+    openOutputFile(const std::filesystem::path& fileName, bool binary)
+    {
+        const auto compression = getCompression(fileName);
+        if (compression == Compression::NONE)
+        {
+            return std::make_unique<std::ofstream>(
+                fileName,
+                binary ? std::ios_base::out | std::ios_base::binary
+                       : std::ios_base::out);
+        }
+
+        // Don't create the file if it can't be written.
+        if (!isCompressionSupported(compression))
+            throwUnsupported(compression);
+
+        auto file = std::make_unique<std::ofstream>(
+            fileName, std::ios_base::out | std::ios_base::binary);
+        auto compressor = std::make_unique<CompressingStreamBuf>(
+            *file, compression, -1);
+        return std::make_unique<CompressingStream>(std::move(file),
+                                                   std::move(compressor));
+    }
+}
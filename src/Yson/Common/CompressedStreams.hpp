@@ -0,0 +1,91 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include "Yson/Compression.hpp"
+#include "Yson/ReaderOptions.hpp"
+
+namespace Yson
+{
+    /**
+     * @brief Returns the compression format indicated by the magic number
+     *  at the start of @a data, or NONE.
+     *
+     * @a size can be less than the length of the magic numbers, but at
+     * least two bytes are needed to recognize any of them.
+     */
+    [[nodiscard]]
+    Compression detectCompression(const char* data, size_t size);
+
+    /**
+     * @brief Returns the compression to use for std::istream input
+     *  according to @a options.
+     *
+     * AUTO is replaced with NONE unless options.detectStreamCompression
+     * is true.
+     */
+    [[nodiscard]]
+    Compression getStreamCompression(const ReaderOptions& options);
+
+    /**
+     * @brief Returns the compression format indicated by @a fileName's
+     *  extension: ".gz", ".zz" or ".zst".
+     */
+    [[nodiscard]]
+    Compression getCompression(const std::filesystem::path& fileName);
+
+    /**
+     * @brief Returns a stream that decompresses @a buffer followed by the
+     *  rest of @a stream.
+     *
+     * The decompression runs in a background thread that stays a few
+     * blocks ahead of the reader.
+     *
+     * @a buffer is copied. Returns nullptr if @a compression is NONE, or
+     * if it is AUTO and the input isn't compressed.
+     */
+    [[nodiscard]]
+    std::unique_ptr<std::istream>
+    openDecompressingStream(std::istream& stream,
+                            const char* buffer, size_t bufferSize,
+                            Compression compression);
+
+    /**
+     * @brief Returns a stream that decompresses @a buffer.
+     *
+     * @a buffer is not copied and must outlive the returned stream.
+     * Returns nullptr if @a compression is NONE, or if it is AUTO and
+     * the input isn't compressed.
+     */
+    [[nodiscard]]
+    std::unique_ptr<std::istream>
+    openDecompressingStream(const char* buffer, size_t bufferSize,
+                            Compression compression);
+
+    /**
+     * @brief Decompresses the start of @a buffer, which can be a
+     *  truncated, e.g. the first few kilobytes of a file.
+     *
+     * Returns at most @a maxSize bytes.
+     */
+    [[nodiscard]]
+    std::string decompressStart(const char* buffer, size_t bufferSize,
+                                Compression compression, size_t maxSize);
+
+    /**
+     * @brief Creates the file @a fileName and returns a stream for it,
+     *  which compresses its output if the file name's extension is one of
+     *  those recognized by getCompression.
+     */
+    [[nodiscard]]
+    std::unique_ptr<std::ostream>
+    openOutputFile(const std::filesystem::path& fileName, bool binary);
+}
@@ -8,6 +8,7 @@
 #include "Escape.hpp"
 
 #include <algorithm>
+#include <cctype>
 #include <cstdint>
 #include <iterator>
 #include "Yson/YsonException.hpp"
@@ -356,6 +357,27 @@ namespace Yson
         return end(str) != std::find(begin(str), end(str), '\\');
     }
 
+    size_t findInvalidEscapeSequence(std::string_view str)
+    {
+        auto it = std::find(str.begin(), str.end(), '\\');
+        while (it != str.end())
+        {
+            auto start = it;
+            if (++it == str.end())
+                return size_t(start - str.begin());
+            if (*it++ == 'u')
+            {
+                for (int i = 0; i < 4; ++i, ++it)
+                {
+                    if (it == str.end() || !isxdigit(uint8_t(*it)))
+                        return size_t(start - str.begin());
+                }
+            }
+            it = std::find(it, str.end(), '\\');
+        }
+        return std::string_view::npos;
+    }
+
     bool hasUnescapedCharacters(std::string_view str,
                                 bool escapeNonAscii)
     {
@@ -30,6 +30,12 @@ namespace Yson
       */
     bool hasEscapedCharacters(std::string_view str);
 
+    /** @brief Returns the offset of the first escape sequence in @a str
+      *     that unescape will reject, or std::string_view::npos if there
+      *     is none.
+      */
+    size_t findInvalidEscapeSequence(std::string_view str);
+
     /** @brief Returns true if @a str has characters that will be escaped
       *     if escape is called with the same parameters.
       */
@@ -0,0 +1,112 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "FindInvalidUtf8.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace Yson
+{
+    namespace
+    {
+        constexpr int INCOMPLETE = -1;
+
+        bool isInRange(unsigned char c, unsigned char lo, unsigned char hi)
+        {
+            return lo <= c && c <= hi;
+        }
+
+        /**
+         * @brief Returns the length of the character starting at @a s,
+         *  0 if it is invalid, or INCOMPLETE if it is valid, but
+         *  continues beyond @a end.
+         */
+        int getCharacterLength(const unsigned char* s,
+                               const unsigned char* end)
+        {
+            // The valid ranges of the second byte, the remaining bytes must
+            // be in the range 0x80-0xBF.
+            // See table 3-7 in chapter 3.9 of the Unicode Standard.
+            unsigned char lo = 0x80, hi = 0xBF;
+            int length;
+            auto c = s[0];
+            if (c < 0xC2)
+                return 0;
+            if (c < 0xE0)
+            {
+                length = 2;
+            }
+            else if (c < 0xF0)
+            {
+                length = 3;
+                if (c == 0xE0)
+                    lo = 0xA0;
+                else if (c == 0xED)
+                    hi = 0x9F;
+            }
+            else if (c < 0xF5)
+            {
+                length = 4;
+                if (c == 0xF0)
+                    lo = 0x90;
+                else if (c == 0xF4)
+                    hi = 0x8F;
+            }
+            else
+            {
+                return 0;
+            }
+
+            for (int i = 1; i < length; ++i)
+            {
+                if (s + i == end)
+                    return INCOMPLETE;
+                if (!isInRange(s[i], lo, hi))
+                    return 0;
+                lo = 0x80;
+                hi = 0xBF;
+            }
+            return length;
+        }
+    }
+
+    size_t findInvalidUtf8(std::string_view str, bool& isIncomplete)
+    {
+        isIncomplete = false;
+        auto start = reinterpret_cast<const unsigned char*>(str.data());
+        auto end = start + str.size();
+        auto s = start;
+        while (s != end)
+        {
+            // JSON is usually mostly ASCII, skip eight bytes at a time
+            // while none of them have the high bit set.
+            while (end - s >= 8)
+            {
+                uint64_t word;
+                memcpy(&word, s, sizeof(word));
+                if (word & 0x8080808080808080ULL)
+                    break;
+                s += 8;
+            }
+
+            while (s != end && *s < 0x80)
+                ++s;
+            if (s == end)
+                break;
+
+            auto length = getCharacterLength(s, end);
+            if (length <= 0)
+            {
+                isIncomplete = length == INCOMPLETE;
+                return size_t(s - start);
+            }
+            s += length;
+        }
+        return str.size();
+    }
+}
@@ -0,0 +1,26 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <string_view>
+
+namespace Yson
+{
+    /**
+     * @brief Returns the offset of the first byte in @a str that doesn't
+     *  start a valid UTF-8 character, or the size of @a str if it is all
+     *  valid.
+     *
+     * Overlong encodings, surrogates and code points above U+10FFFF are
+     * invalid.
+     *
+     * @param isIncomplete Set to true if the returned offset is the start
+     *  of a valid multi-byte character that has been cut short by the end
+     *  of @a str, otherwise false.
+     */
+    size_t findInvalidUtf8(std::string_view str, bool& isIncomplete);
+}
@@ -0,0 +1,39 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace Yson
+{
+    /**
+     * @brief Returns the value of the IEEE 754 half-precision float
+     *  whose bits are @a value.
+     */
+    inline float float16ToFloat(uint16_t value)
+    {
+        const uint32_t sign = uint32_t(value & 0x8000u) << 16;
+        const uint32_t exponent = (value >> 10) & 0x1Fu;
+        const uint32_t mantissa = value & 0x3FFu;
+        if (exponent == 0)
+        {
+            // Zero or subnormal.
+            const auto result = std::ldexp(float(mantissa), -24);
+            return sign ? -result : result;
+        }
+        if (exponent == 0x1F)
+        {
+            // Infinity or NaN.
+            return std::bit_cast<float>(sign | 0x7F800000u
+                                        | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23)
+                                    | (mantissa << 13));
+    }
+}
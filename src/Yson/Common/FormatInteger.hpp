@@ -0,0 +1,103 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Yson
+{
+    /**
+     * @brief The maximum number of characters formatInteger writes for
+     *  a 64-bit integer, including the minus sign.
+     */
+    constexpr size_t MAX_INTEGER_CHARACTERS = 20;
+
+    namespace detail
+    {
+        constexpr char DIGIT_PAIRS[] =
+            "0001020304050607080910111213141516171819"
+            "2021222324252627282930313233343536373839"
+            "4041424344454647484950515253545556575859"
+            "6061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+
+        inline size_t countDigits(uint64_t value)
+        {
+            size_t count = 1;
+            while (true)
+            {
+                if (value < 10)
+                    return count;
+                if (value < 100)
+                    return count + 1;
+                if (value < 1000)
+                    return count + 2;
+                if (value < 10000)
+                    return count + 3;
+                value /= 10000;
+                count += 4;
+            }
+        }
+
+        inline char* formatUnsigned(char* dst, uint64_t value)
+        {
+            const auto end = dst + countDigits(value);
+            auto it = end;
+            while (value >= 100)
+            {
+                const auto i = (value % 100) * 2;
+                value /= 100;
+                it -= 2;
+                it[0] = DIGIT_PAIRS[i];
+                it[1] = DIGIT_PAIRS[i + 1];
+            }
+            if (value >= 10)
+            {
+                const auto i = value * 2;
+                it[-2] = DIGIT_PAIRS[i];
+                it[-1] = DIGIT_PAIRS[i + 1];
+            }
+            else
+            {
+                it[-1] = char('0' + value);
+            }
+            return end;
+        }
+    }
+
+    /**
+     * @brief Writes the decimal representation of @a value to @a dst.
+     *
+     * Two digits are produced per division, and the number of digits is
+     * computed up front so the digits can be written directly to their
+     * final positions. @a dst must have room for at least
+     * MAX_INTEGER_CHARACTERS characters.
+     *
+     * @return A pointer to the character after the last digit.
+     */
+    template <typename T>
+    char* formatInteger(char* dst, T value)
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 8);
+        if constexpr (std::is_signed_v<T>)
+        {
+            auto u = static_cast<uint64_t>(static_cast<int64_t>(value));
+            if (value < 0)
+            {
+                *dst++ = '-';
+                u = 0 - u;
+            }
+            return detail::formatUnsigned(dst, u);
+        }
+        else
+        {
+            return detail::formatUnsigned(dst, static_cast<uint64_t>(value));
+        }
+    }
+}
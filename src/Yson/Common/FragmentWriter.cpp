@@ -0,0 +1,141 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/FragmentWriter.hpp"
+
+#include <vector>
+#include "Yson/YsonException.hpp"
+
+namespace Yson
+{
+    struct FragmentWriter::Members
+    {
+        JsonWriter* jsonWriter = nullptr;
+        UBJsonWriter* ubjsonWriter = nullptr;
+        std::vector<std::unique_ptr<Writer>> fragments;
+        std::vector<std::string> keys;
+    };
+
+    FragmentWriter::FragmentWriter(JsonWriter& writer, size_t fragmentCount)
+        : m_Members(std::make_unique<Members>())
+    {
+        m_Members->jsonWriter = &writer;
+        m_Members->fragments.resize(fragmentCount);
+        m_Members->keys.resize(fragmentCount);
+    }
+
+    FragmentWriter::FragmentWriter(UBJsonWriter& writer, size_t fragmentCount)
+        : m_Members(std::make_unique<Members>())
+    {
+        m_Members->ubjsonWriter = &writer;
+        m_Members->fragments.resize(fragmentCount);
+        m_Members->keys.resize(fragmentCount);
+    }
+
+    FragmentWriter::FragmentWriter(FragmentWriter&&) noexcept = default;
+
+    FragmentWriter::~FragmentWriter() = default;
+
+    FragmentWriter&
+    FragmentWriter::operator=(FragmentWriter&&) noexcept = default;
+
+    size_t FragmentWriter::size() const
+    {
+        return m_Members->fragments.size();
+    }
+
+    Writer& FragmentWriter::fragment(size_t index)
+    {
+        auto& fragment = m_Members->fragments.at(index);
+        if (!fragment)
+        {
+            if (m_Members->jsonWriter)
+                fragment = m_Members->jsonWriter->makeFragmentWriter();
+            else
+                fragment = m_Members->ubjsonWriter->makeFragmentWriter();
+        }
+        return *fragment;
+    }
+
+    Writer& FragmentWriter::fragment(size_t index, std::string key)
+    {
+        auto& writer = fragment(index);
+        m_Members->keys[index] = std::move(key);
+        return writer;
+    }
+
+    Writer& FragmentWriter::writeArray()
+    {
+        return writeStructure(false);
+    }
+
+    Writer& FragmentWriter::writeObject()
+    {
+        return writeStructure(true);
+    }
+
+    Writer& FragmentWriter::writeStructure(bool isObject)
+    {
+        auto& m = *m_Members;
+        // Check all the fragments before anything is written, so that
+        // a bad fragment doesn't leave a partial structure in the output.
+        for (size_t i = 0; i < m.fragments.size(); ++i)
+        {
+            const auto& fragment = m.fragments[i];
+            if (!fragment || fragment->buffer().second == 0)
+                YSON_THROW("Fragment " + std::to_string(i) + " is empty.");
+            const bool isComplete =
+                m.jsonWriter
+                    ? static_cast<JsonWriter&>(*fragment).isCompleteFragment()
+                    : static_cast<UBJsonWriter&>(*fragment).isCompleteFragment();
+            if (!isComplete)
+            {
+                YSON_THROW("Fragment " + std::to_string(i)
+                           + " doesn't contain exactly one complete value.");
+            }
+        }
+
+        Writer& writer = m.jsonWriter
+                             ? static_cast<Writer&>(*m.jsonWriter)
+                             : *m.ubjsonWriter;
+        if (m.jsonWriter)
+        {
+            if (isObject)
+                writer.beginObject();
+            else
+                writer.beginArray();
+        }
+        else
+        {
+            // The number of fragments is known, so UBJSON containers
+            // get a count.
+            const StructureParameters params(
+                UBJsonParameters(ptrdiff_t(m.fragments.size())));
+            if (isObject)
+                writer.beginObject(params);
+            else
+                writer.beginArray(params);
+        }
+
+        for (size_t i = 0; i < m.fragments.size(); ++i)
+        {
+            auto& fragment = m.fragments[i];
+            auto [data, size] = fragment->buffer();
+            if (isObject)
+                writer.key(std::move(m.keys[i]));
+            const std::string_view text(static_cast<const char*>(data), size);
+            if (m.jsonWriter)
+                m.jsonWriter->rawValue(text);
+            else
+                m.ubjsonWriter->writeFragment(text);
+            // Release each fragment's memory as soon as it is written.
+            fragment.reset();
+        }
+
+        return isObject ? writer.endObject() : writer.endArray();
+    }
+}
@@ -55,6 +55,10 @@ namespace Yson
             case 'x':
             case 'X':
                 return getHexadecimalValueType(str.substr(i + 1));
+            case '.':
+            case 'e':
+            case 'E':
+                return getFloatingPointValueType(str.substr(i));
             default:
                 return getNumberValueType(str.substr(i));
             }
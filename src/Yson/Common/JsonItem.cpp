@@ -34,7 +34,7 @@ namespace Yson
     {
         if (const auto* obj = std::get_if<std::shared_ptr<ObjectItem>>(&m_Item))
         {
-            const auto& values = (*obj)->values();
+            const auto& values = (*obj)->pmrValues();
             auto it = values.find(key);
             return it != values.end() ? &it->second : nullptr;
         }
@@ -45,7 +45,7 @@ namespace Yson
     {
         if (const auto* obj = std::get_if<std::shared_ptr<ArrayItem>>(&m_Item))
         {
-            const auto& values = (*obj)->values();
+            const auto& values = (*obj)->pmrValues();
             return index < values.size() ? &values[index] : nullptr;
         }
         YSON_THROW("Item isn't an array.");
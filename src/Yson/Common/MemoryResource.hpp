@@ -0,0 +1,22 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory_resource>
+
+namespace Yson
+{
+    /**
+     * @brief Returns @a resource, or the default memory resource if
+     *  @a resource is nullptr.
+     */
+    inline std::pmr::memory_resource*
+    getMemoryResource(std::pmr::memory_resource* resource)
+    {
+        return resource ? resource : std::pmr::get_default_resource();
+    }
+}
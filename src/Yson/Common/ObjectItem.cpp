@@ -11,17 +11,41 @@ namespace Yson
 {
     ObjectItem::ObjectItem(std::deque<std::string> keys,
                            std::unordered_map<std::string_view, JsonItem> values)
+    {
+        // The string views in values refer to the strings in keys, so
+        // the map must be rebuilt with views of the copied keys.
+        m_Values.reserve(values.size());
+        for (auto& key : keys)
+        {
+            const auto& newKey = m_Keys.emplace_back(key);
+            if (auto it = values.find(key); it != values.end())
+                m_Values.emplace(newKey, std::move(it->second));
+        }
+    }
+
+    ObjectItem::ObjectItem(std::pmr::deque<std::pmr::string> keys,
+                           std::pmr::unordered_map<std::string_view, JsonItem> values)
         : m_Keys(std::move(keys)),
           m_Values(std::move(values))
     {}
 
-    const std::deque<std::string>& ObjectItem::keys() const
+    std::deque<std::string> ObjectItem::keys() const
+    {
+        return {m_Keys.begin(), m_Keys.end()};
+    }
+
+    const std::pmr::deque<std::pmr::string>& ObjectItem::pmrKeys() const
     {
         return m_Keys;
     }
 
-    const std::unordered_map<std::string_view, JsonItem>&
-    ObjectItem::values() const
+    std::unordered_map<std::string_view, JsonItem> ObjectItem::values() const
+    {
+        return {m_Values.begin(), m_Values.end()};
+    }
+
+    const std::pmr::unordered_map<std::string_view, JsonItem>&
+    ObjectItem::pmrValues() const
     {
         return m_Values;
     }
@@ -11,6 +11,7 @@
 #include "Yson/JsonReader.hpp"
 #include "Yson/UBJsonReader.hpp"
 #include "Yson/YsonException.hpp"
+#include "CompressedStreams.hpp"
 
 namespace Yson
 {
@@ -92,26 +93,46 @@ namespace Yson
             }
             return ContentType::UNKNOWN;
         }
+
+        /**
+         * @brief Identifies the contents of @a contents, decompressing it
+         *  first if it is compressed.
+         */
+        ContentType identifyContents(const char* contents, size_t size,
+                                     Compression compression)
+        {
+            if (compression == Compression::AUTO)
+                compression = detectCompression(contents, size);
+            if (compression == Compression::NONE)
+                return identifyFile(contents, size);
+
+            const auto decompressed = decompressStart(contents, size,
+                                                      compression, 1024);
+            return identifyFile(decompressed.data(), decompressed.size());
+        }
     }
 
-    std::unique_ptr<Reader> makeReader(std::istream& stream)
+    std::unique_ptr<Reader> makeReader(std::istream& stream,
+                                       const ReaderOptions& options)
     {
         std::vector<char> buffer(1024);
         stream.read(buffer.data(),
                     static_cast<std::streamsize>(buffer.size()));
         buffer.resize(stream.gcount());
-        const auto contentType = identifyFile(buffer.data(), buffer.size());
+        const auto contentType = identifyContents(
+            buffer.data(), buffer.size(), getStreamCompression(options));
         if (contentType == ContentType::JSON)
             return std::make_unique<JsonReader>(stream, buffer.data(),
-                                                buffer.size());
+                                                buffer.size(), options);
         if (contentType == ContentType::UBJSON)
             return std::make_unique<UBJsonReader>(stream, buffer.data(),
-                                                  buffer.size());
+                                                  buffer.size(), options);
 
         YSON_THROW("Stream contents appear to be neither JSON nor UBJSON.");
     }
 
-    std::unique_ptr<Reader> makeReader(const std::filesystem::path& fileName)
+    std::unique_ptr<Reader> makeReader(const std::filesystem::path& fileName,
+                                       const ReaderOptions& options)
     {
         std::ifstream file(fileName, std::ios_base::binary);
         if (!file)
@@ -120,24 +141,28 @@ namespace Yson
         file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
         buffer.resize(file.gcount());
         file.close();
-        const auto contentType = identifyFile(buffer.data(), buffer.size());
+        const auto contentType = identifyContents(buffer.data(),
+                                                  buffer.size(),
+                                                  options.compression);
         if (contentType == ContentType::JSON)
-            return std::make_unique<JsonReader>(fileName);
+            return std::make_unique<JsonReader>(fileName, options);
 
         if (contentType == ContentType::UBJSON)
-            return std::make_unique<UBJsonReader>(fileName);
+            return std::make_unique<UBJsonReader>(fileName, options);
 
         YSON_THROW("File contents appear to be neither JSON nor UBJSON.");
     }
 
-    std::unique_ptr<Reader> makeReader(const char* buffer, size_t bufferSize)
+    std::unique_ptr<Reader> makeReader(const char* buffer, size_t bufferSize,
+                                       const ReaderOptions& options)
     {
-        const auto contentType = identifyFile(buffer, bufferSize);
+        const auto contentType = identifyContents(buffer, bufferSize,
+                                                  options.compression);
         if (contentType == ContentType::JSON)
-            return std::make_unique<JsonReader>(buffer, bufferSize);
+            return std::make_unique<JsonReader>(buffer, bufferSize, options);
 
         if (contentType == ContentType::UBJSON)
-            return std::make_unique<UBJsonReader>(buffer, bufferSize);
+            return std::make_unique<UBJsonReader>(buffer, bufferSize, options);
 
         YSON_THROW("Buffer contents appear to be neither JSON nor UBJSON.");
     }
@@ -0,0 +1,72 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace Yson
+{
+    /**
+     * @brief A stack of object and array scopes that stores one bit per
+     *  scope.
+     *
+     * The first INLINE_DEPTH scopes are stored in the object itself, so
+     * memory is only allocated for documents that are nested deeper than
+     * that.
+     */
+    class ScopeStack
+    {
+    public:
+        static constexpr size_t INLINE_DEPTH = 1024;
+
+        [[nodiscard]]
+        bool empty() const
+        {
+            return m_Size == 0;
+        }
+
+        [[nodiscard]]
+        bool isObject() const
+        {
+            assert(m_Size != 0);
+            const auto i = m_Size - 1;
+            if (i < INLINE_DEPTH)
+                return (m_Inline[i / 64] >> (i % 64)) & 1u;
+            return m_Overflow.back();
+        }
+
+        void push(bool isObject)
+        {
+            const auto i = m_Size++;
+            if (i >= INLINE_DEPTH)
+            {
+                m_Overflow.push_back(isObject);
+                return;
+            }
+
+            const auto bit = uint64_t(1) << (i % 64);
+            if (isObject)
+                m_Inline[i / 64] |= bit;
+            else
+                m_Inline[i / 64] &= ~bit;
+        }
+
+        void pop()
+        {
+            assert(m_Size != 0);
+            if (--m_Size >= INLINE_DEPTH)
+                m_Overflow.pop_back();
+        }
+    private:
+        std::array<uint64_t, INLINE_DEPTH / 64> m_Inline = {};
+        std::vector<bool> m_Overflow;
+        size_t m_Size = 0;
+    };
+}
@@ -0,0 +1,376 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Transcode.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "Yson/YsonException.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        enum class ArrayResult
+        {
+            /// The array hasn't been touched.
+            NOT_WRITTEN,
+            /// The entire array has been written.
+            WRITTEN,
+            /// The reader and writer are inside the array, and the
+            /// reader is at a value that has not been written yet.
+            ENTERED_AT_VALUE
+        };
+
+        /// The maximum number of values that are buffered to find out if
+        /// an array can be written as an optimized array.
+        constexpr size_t MAX_BUFFERED_VALUES = 4096;
+
+        struct NoArrayHandler
+        {
+            ArrayResult operator()(Reader&, Writer&)
+            {
+                return ArrayResult::NOT_WRITTEN;
+            }
+        };
+
+        void writeScalar(Reader& reader, Writer& writer, std::string& buffer)
+        {
+            switch (reader.valueType())
+            {
+            case ValueType::NULL_VALUE:
+                writer.null();
+                return;
+            case ValueType::BOOLEAN:
+                writer.boolean(read<bool>(reader));
+                return;
+            case ValueType::INTEGER:
+                if (int64_t i; reader.read(i))
+                {
+                    writer.value(i);
+                    return;
+                }
+                if (uint64_t u; reader.read(u))
+                {
+                    writer.value(u);
+                    return;
+                }
+                [[fallthrough]];
+            case ValueType::FLOAT:
+                if (double d; reader.read(d))
+                {
+                    writer.value(d);
+                    return;
+                }
+                YSON_THROW("Can't convert the number to a value the writer"
+                           " supports.");
+            default:
+                reader.read(buffer);
+                writer.value(std::string_view(buffer));
+                return;
+            }
+        }
+
+        template <typename ReaderT, typename WriterT, typename ArrayHandler>
+        bool transcodeImpl(ReaderT& reader, WriterT& writer,
+                           ArrayHandler writeArray)
+        {
+            if (reader.state() != ReaderState::AT_VALUE && !reader.nextValue())
+                return false;
+
+            // true for objects, false for arrays.
+            std::vector<bool> scopes;
+            std::string buffer;
+            bool atValue = true;
+            while (true)
+            {
+                if (atValue)
+                {
+                    auto type = reader.valueType();
+                    if (type == ValueType::OBJECT)
+                    {
+                        reader.enter();
+                        writer.beginObject();
+                        scopes.push_back(true);
+                        atValue = false;
+                    }
+                    else if (type == ValueType::ARRAY)
+                    {
+                        switch (writeArray(reader, writer))
+                        {
+                        case ArrayResult::NOT_WRITTEN:
+                            reader.enter();
+                            writer.beginArray();
+                            scopes.push_back(false);
+                            atValue = false;
+                            break;
+                        case ArrayResult::WRITTEN:
+                            atValue = false;
+                            break;
+                        case ArrayResult::ENTERED_AT_VALUE:
+                            scopes.push_back(false);
+                            continue;
+                        }
+                    }
+                    else
+                    {
+                        writeScalar(reader, writer, buffer);
+                        atValue = false;
+                    }
+                }
+
+                if (scopes.empty())
+                    return true;
+
+                if (scopes.back())
+                {
+                    if (reader.nextKey())
+                    {
+                        reader.read(buffer);
+                        writer.key(buffer);
+                        atValue = reader.nextValue();
+                        continue;
+                    }
+                    writer.endObject();
+                }
+                else
+                {
+                    if (reader.nextValue())
+                    {
+                        atValue = true;
+                        continue;
+                    }
+                    writer.endArray();
+                }
+                reader.leave();
+                scopes.pop_back();
+            }
+        }
+
+        template <typename T>
+        UBJsonValueType getSmallestIntegerType(const std::vector<T>& values)
+        {
+            auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+            if (*lo >= std::numeric_limits<int8_t>::min()
+                && *hi <= std::numeric_limits<int8_t>::max())
+                return UBJsonValueType::INT_8;
+            if (*lo >= 0 && *hi <= std::numeric_limits<uint8_t>::max())
+                return UBJsonValueType::UINT_8;
+            if (*lo >= std::numeric_limits<int16_t>::min()
+                && *hi <= std::numeric_limits<int16_t>::max())
+                return UBJsonValueType::INT_16;
+            if (*lo >= std::numeric_limits<int32_t>::min()
+                && *hi <= std::numeric_limits<int32_t>::max())
+                return UBJsonValueType::INT_32;
+            return UBJsonValueType::INT_64;
+        }
+
+        template <typename T>
+        void writeOptimizedArray(UBJsonWriter& writer,
+                                 const std::vector<T>& values,
+                                 UBJsonValueType valueType)
+        {
+            writer.beginArray(UBJsonParameters(ptrdiff_t(values.size()),
+                                               valueType));
+            for (auto value : values)
+                writer.value(value);
+            writer.endArray();
+        }
+
+        enum class ReadValuesResult
+        {
+            /// All the values have been read and the array has been left.
+            COMPLETE,
+            /// The reader is at a value of a different type.
+            MISMATCH,
+            /// MAX_BUFFERED_VALUES values have been read, the reader is
+            /// at the next value.
+            FULL
+        };
+
+        template <typename T>
+        ReadValuesResult readValues(JsonReader& reader, ValueType valueType,
+                                    std::vector<T>& values)
+        {
+            while (true)
+            {
+                T value;
+                if (reader.valueType() != valueType || !reader.read(value))
+                    return ReadValuesResult::MISMATCH;
+                values.push_back(value);
+                if (!reader.nextValue())
+                {
+                    reader.leave();
+                    return ReadValuesResult::COMPLETE;
+                }
+                if (values.size() == MAX_BUFFERED_VALUES)
+                    return ReadValuesResult::FULL;
+            }
+        }
+
+        /**
+         * @brief Writes JSON arrays of numbers as optimized UBJSON arrays.
+         *
+         * The values have to be buffered, since the array's size must be
+         * written before its values. Arrays with more than
+         * MAX_BUFFERED_VALUES values are written as ordinary arrays to
+         * keep the memory usage bounded. JsonReader::readArray isn't used
+         * as it also accepts strings, booleans and nulls as numbers.
+         */
+        class JsonArrayHandler
+        {
+        public:
+            ArrayResult operator()(JsonReader& reader, UBJsonWriter& writer)
+            {
+                reader.enter();
+                if (!reader.nextValue())
+                {
+                    reader.leave();
+                    writer.beginArray().endArray();
+                    return ArrayResult::WRITTEN;
+                }
+
+                m_Integers.clear();
+                auto result = readValues(reader, ValueType::INTEGER,
+                                         m_Integers);
+                if (result == ReadValuesResult::COMPLETE)
+                {
+                    writeOptimizedArray(writer, m_Integers,
+                                        writer.isStrictIntegerSizesEnabled()
+                                        ? UBJsonValueType::INT_64
+                                        : getSmallestIntegerType(m_Integers));
+                    return ArrayResult::WRITTEN;
+                }
+
+                m_Floats.clear();
+                if (result == ReadValuesResult::MISMATCH && m_Integers.empty())
+                {
+                    result = readValues(reader, ValueType::FLOAT, m_Floats);
+                    if (result == ReadValuesResult::COMPLETE)
+                    {
+                        writeOptimizedArray(writer, m_Floats,
+                                            UBJsonValueType::FLOAT_64);
+                        return ArrayResult::WRITTEN;
+                    }
+                }
+
+                // The reader is at the first value that didn't fit in, or
+                // the array is too long to be buffered. The writer adds
+                // a back-patched count if count patching is enabled.
+                writer.beginArray();
+                for (auto value : m_Integers)
+                    writer.value(value);
+                for (auto value : m_Floats)
+                    writer.value(value);
+                return ArrayResult::ENTERED_AT_VALUE;
+            }
+        private:
+            std::vector<int64_t> m_Integers;
+            std::vector<double> m_Floats;
+        };
+
+        template <typename T>
+        bool writeOptimizedArray(UBJsonReader& reader, JsonWriter& writer,
+                                 std::vector<T>& values)
+        {
+            size_t size;
+            if (!reader.readOptimizedArray(static_cast<T*>(nullptr), size))
+                return false;
+            values.resize(size);
+            if (!reader.readOptimizedArray(values.data(), size))
+                return false;
+            writer.beginArray();
+            for (auto value : values)
+                writer.value(value);
+            writer.endArray();
+            return true;
+        }
+
+        /**
+         * @brief Reads the values of optimized UBJSON arrays of numbers
+         *  in one go.
+         */
+        class UBJsonArrayHandler
+        {
+        public:
+            ArrayResult operator()(UBJsonReader& reader, JsonWriter& writer)
+            {
+                if (!reader.isOptimizedArray()
+                    || reader.optimizedArrayProperties().first
+                       > MAX_BUFFERED_VALUES)
+                {
+                    return ArrayResult::NOT_WRITTEN;
+                }
+
+                bool written;
+                switch (reader.optimizedArrayProperties().second)
+                {
+                case DetailedValueType::UINT_7:
+                    written = writeOptimizedArray(reader, writer, m_Int8s);
+                    break;
+                case DetailedValueType::UINT_8:
+                    written = writeOptimizedArray(reader, writer, m_UInt8s);
+                    break;
+                case DetailedValueType::UINT_15:
+                    written = writeOptimizedArray(reader, writer, m_Int16s);
+                    break;
+                case DetailedValueType::UINT_31:
+                    written = writeOptimizedArray(reader, writer, m_Int32s);
+                    break;
+                case DetailedValueType::UINT_63:
+                    written = writeOptimizedArray(reader, writer, m_Int64s);
+                    break;
+                case DetailedValueType::FLOAT_32:
+                    written = writeOptimizedArray(reader, writer, m_Floats);
+                    break;
+                case DetailedValueType::FLOAT_64:
+                    written = writeOptimizedArray(reader, writer, m_Doubles);
+                    break;
+                default:
+                    written = false;
+                    break;
+                }
+                return written ? ArrayResult::WRITTEN
+                               : ArrayResult::NOT_WRITTEN;
+            }
+        private:
+            std::vector<int8_t> m_Int8s;
+            std::vector<uint8_t> m_UInt8s;
+            std::vector<int16_t> m_Int16s;
+            std::vector<int32_t> m_Int32s;
+            std::vector<int64_t> m_Int64s;
+            std::vector<float> m_Floats;
+            std::vector<double> m_Doubles;
+        };
+    }
+
+    bool transcode(Reader& reader, Writer& writer)
+    {
+        if (auto jsonReader = dynamic_cast<JsonReader*>(&reader))
+        {
+            if (auto ubjsonWriter = dynamic_cast<UBJsonWriter*>(&writer))
+                return transcode(*jsonReader, *ubjsonWriter);
+        }
+        else if (auto ubjsonReader = dynamic_cast<UBJsonReader*>(&reader))
+        {
+            if (auto jsonWriter = dynamic_cast<JsonWriter*>(&writer))
+                return transcode(*ubjsonReader, *jsonWriter);
+        }
+        return transcodeImpl(reader, writer, NoArrayHandler());
+    }
+
+    bool transcode(JsonReader& reader, UBJsonWriter& writer)
+    {
+        return transcodeImpl(reader, writer, JsonArrayHandler());
+    }
+
+    bool transcode(UBJsonReader& reader, JsonWriter& writer)
+    {
+        return transcodeImpl(reader, writer, UBJsonArrayHandler());
+    }
+}
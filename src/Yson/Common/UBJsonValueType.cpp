@@ -33,6 +33,10 @@ namespace Yson
         CASE_TYPE(INT_16);
         CASE_TYPE(INT_32);
         CASE_TYPE(INT_64);
+        CASE_TYPE(UINT_16);
+        CASE_TYPE(UINT_32);
+        CASE_TYPE(UINT_64);
+        CASE_TYPE(FLOAT_16);
         default:
             break;
         }
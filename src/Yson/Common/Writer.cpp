@@ -0,0 +1,96 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Writer.hpp"
+
+#include <vector>
+#include "Yson/ArrayItem.hpp"
+#include "Yson/ObjectItem.hpp"
+#include "Yson/YsonException.hpp"
+
+namespace Yson
+{
+    Writer& Writer::write(const JsonItem& item) // NOLINT(*-no-recursion)
+    {
+        if (item.isArray())
+        {
+            beginArray();
+            for (const auto& value : item.array())
+                write(value);
+            return endArray();
+        }
+
+        if (item.isObject())
+        {
+            const auto& object = item.object();
+            const auto& values = object.pmrValues();
+            beginObject();
+            for (const auto& key : object.pmrKeys())
+            {
+                this->key(std::string(key));
+                write(values.at(key));
+            }
+            return endObject();
+        }
+
+        writeValueItem(item.value());
+        return *this;
+    }
+
+    void Writer::writeValueItem(const ValueItem& item)
+    {
+        switch (item.valueType())
+        {
+        case ValueType::NULL_VALUE:
+            null();
+            return;
+        case ValueType::BOOLEAN:
+            if (bool b; item.get(b))
+            {
+                boolean(b);
+                return;
+            }
+            break;
+        case ValueType::INTEGER:
+            if (int64_t i; item.get(i))
+            {
+                value(i);
+                return;
+            }
+            if (uint64_t u; item.get(u))
+            {
+                value(u);
+                return;
+            }
+            [[fallthrough]];
+        case ValueType::FLOAT:
+            if (double d; item.get(d))
+            {
+                value(d);
+                return;
+            }
+            YSON_THROW("Can't convert the number to a value the writer"
+                       " supports.");
+        default:
+            break;
+        }
+
+        if (std::string s; item.get(s))
+        {
+            value(std::string_view(s));
+            return;
+        }
+
+        if (std::vector<char> data; item.getBinary(data))
+        {
+            binary(data.data(), data.size());
+            return;
+        }
+
+        YSON_THROW("Can't write a value of type " + toString(item.valueType()));
+    }
+}
@@ -7,8 +7,11 @@
 //****************************************************************************
 #include "Yson/JsonReader.hpp"
 
+#include <algorithm>
+#include <optional>
 #include "Yson/ArrayItem.hpp"
 #include "Yson/ObjectItem.hpp"
+#include "Yson/ReaderStats.hpp"
 #include "Yson/Common/Base64.hpp"
 #include "Yson/Common/Escape.hpp"
 #include "Yson/Common/GetDetailedValueType.hpp"
@@ -23,14 +26,138 @@
 
 namespace Yson
 {
+    namespace
+    {
+        template <typename T>
+        bool parseArrayValue(JsonTokenizer& tokenizer, T& value)
+        {
+            auto tokenType = tokenizer.tokenType();
+            if (tokenType != JsonTokenType::VALUE
+                && tokenType != JsonTokenType::STRING)
+            {
+                return false;
+            }
+            if constexpr (std::is_floating_point_v<T>)
+                return parse(tokenizer.token(), value);
+            else
+                return parse(tokenizer.token(), value, true);
+        }
+
+        void countUnescape(const JsonTokenizer& tokenizer)
+        {
+            if (auto stats = tokenizer.stats())
+                ++stats->unescapeCalls;
+        }
+
+        void decodeBase64(std::string_view text, std::vector<char>& buffer,
+                          const JsonTokenizer& tokenizer)
+        {
+            if (!fromBase64(text, buffer))
+                JSON_READER_THROW("Invalid base64 string.", tokenizer);
+        }
+
+        /**
+         * @brief Decodes groups of four characters that aren't at the end
+         *  of the string.
+         */
+        void decodeBase64Groups(std::string_view text,
+                                std::vector<char>& buffer,
+                                const JsonTokenizer& tokenizer)
+        {
+            // fromBase64 ignores padding at the end of the text, but these
+            // groups are followed by more characters.
+            if (!text.empty() && text.back() == '=')
+                JSON_READER_THROW("Invalid base64 string.", tokenizer);
+            decodeBase64(text, buffer, tokenizer);
+        }
+    }
+
+    namespace
+    {
+        /**
+         * @brief An array or object that is being read by readItem.
+         */
+        struct PartialItem
+        {
+            PartialItem(bool isObject,
+                        std::pmr::memory_resource* memoryResource)
+                : isObject(isObject),
+                  values(memoryResource),
+                  keys(memoryResource),
+                  objectValues(memoryResource)
+            {}
+
+            void setKey(std::string_view token)
+            {
+                auto entry = objectValues.find(token);
+                if (entry != objectValues.end())
+                {
+                    key = entry->first;
+                }
+                else
+                {
+                    keys.emplace_back(token);
+                    key = keys.back();
+                }
+                hasKey = true;
+            }
+
+            void add(JsonItem item)
+            {
+                if (isObject)
+                {
+                    objectValues.insert_or_assign(key, std::move(item));
+                    hasKey = false;
+                }
+                else
+                {
+                    values.push_back(std::move(item));
+                }
+            }
+
+            JsonItem makeItem(std::pmr::memory_resource* memoryResource)
+            {
+                std::pmr::polymorphic_allocator<> allocator(memoryResource);
+                if (isObject)
+                {
+                    return JsonItem(std::allocate_shared<ObjectItem>(
+                        allocator, std::move(keys), std::move(objectValues)));
+                }
+                return JsonItem(std::allocate_shared<ArrayItem>(
+                    allocator, std::move(values)));
+            }
+
+            bool isObject;
+            // The key of the next value in an object.
+            bool hasKey = false;
+            std::string_view key;
+            std::pmr::vector<JsonItem> values;
+            std::pmr::deque<std::pmr::string> keys;
+            std::pmr::unordered_map<std::string_view, JsonItem> objectValues;
+        };
+    }
+
     struct JsonReader::Members
     {
         explicit Members(JsonTokenizer&& tokenizer)
-                : tokenizer(std::move(tokenizer))
+                : tokenizer(std::move(tokenizer)),
+                  scopes(this->tokenizer.memoryResource()),
+                  savedScopes(this->tokenizer.memoryResource()),
+                  partialItems(this->tokenizer.memoryResource())
         {}
 
         JsonTokenizer tokenizer;
-        std::vector<std::pair<JsonScopeReader*, ReaderState>> scopes;
+        std::pmr::vector<std::pair<JsonScopeReader*, ReaderState>> scopes;
+        // Push mode only: the scopes when the current operation started.
+        std::pmr::vector<std::pair<JsonScopeReader*, ReaderState>> savedScopes;
+        bool inResumableCall = false;
+        bool needsMoreData = false;
+        // The arrays and objects readItem has entered, but not read to
+        // the end.
+        std::pmr::deque<PartialItem> partialItems;
+        // The base64 characters at the end of the last string chunk that
+        // didn't make up a complete group of four.
+        std::string base64Remainder;
         JsonArrayReader arrayReader;
         JsonDocumentReader documentReader;
         JsonObjectReader objectReader;
@@ -39,23 +166,47 @@ namespace Yson
         {
             return scopes.back().second;
         }
+
+        void enterScope(JsonScopeReader* reader)
+        {
+            if (auto stats = tokenizer.stats())
+            {
+                if (scopes.size() == scopes.capacity())
+                    ++stats->allocations;
+                // The document scope doesn't count.
+                stats->maxScopeDepth = std::max(stats->maxScopeDepth,
+                                                scopes.size());
+            }
+            scopes.emplace_back(reader, ReaderState::AT_START);
+        }
+
+        JsonItem makeValueItem(JsonTokenType tokenType)
+        {
+            return JsonItem(JsonValueItem(
+                std::pmr::string(tokenizer.token(),
+                                 tokenizer.memoryResource()),
+                tokenType));
+        }
     };
 
     JsonReader::JsonReader() = default;
 
-    JsonReader::JsonReader(std::istream& stream)
-            : JsonReader(stream, nullptr, 0)
+    JsonReader::JsonReader(std::istream& stream,
+                           const ReaderOptions& options)
+            : JsonReader(stream, nullptr, 0, options)
     {}
 
-    JsonReader::JsonReader(const std::filesystem::path& fileName)
-            : m_Members(std::make_unique<Members>(JsonTokenizer(fileName)))
+    JsonReader::JsonReader(const std::filesystem::path& fileName,
+                           const ReaderOptions& options)
+            : m_Members(std::make_unique<Members>(JsonTokenizer(fileName, options)))
     {
         m_Members->scopes.emplace_back(&m_Members->documentReader,
                                        ReaderState::INITIAL_STATE);
     }
 
-    JsonReader::JsonReader(const char* buffer, size_t bufferSize)
-            : m_Members(std::make_unique<Members>(JsonTokenizer(buffer, bufferSize)))
+    JsonReader::JsonReader(const char* buffer, size_t bufferSize,
+                           const ReaderOptions& options)
+            : m_Members(std::make_unique<Members>(JsonTokenizer(buffer, bufferSize, options)))
     {
         m_Members->scopes.emplace_back(&m_Members->documentReader,
                                        ReaderState::INITIAL_STATE);
@@ -63,8 +214,9 @@ namespace Yson
 
     JsonReader::JsonReader(std::istream& stream,
                            const char* buffer,
-                           size_t bufferSize)
-            : m_Members(std::make_unique<Members>(JsonTokenizer(stream, buffer, bufferSize)))
+                           size_t bufferSize,
+                           const ReaderOptions& options)
+            : m_Members(std::make_unique<Members>(JsonTokenizer(stream, buffer, bufferSize, options)))
     {
         m_Members->scopes.emplace_back(&m_Members->documentReader,
                                        ReaderState::INITIAL_STATE);
@@ -76,31 +228,105 @@ namespace Yson
 
     JsonReader& JsonReader::operator=(JsonReader&&) noexcept = default;
 
+    void JsonReader::reset(const char* buffer, size_t bufferSize)
+    {
+        if (!m_Members)
+        {
+            *this = JsonReader(buffer, bufferSize);
+            return;
+        }
+        m_Members->tokenizer.reset(buffer, bufferSize);
+        m_Members->scopes.clear();
+        m_Members->scopes.emplace_back(&m_Members->documentReader,
+                                       ReaderState::INITIAL_STATE);
+        m_Members->partialItems.clear();
+    }
+
+    void JsonReader::reset(std::istream& stream)
+    {
+        if (!m_Members)
+        {
+            *this = JsonReader(stream);
+            return;
+        }
+        m_Members->tokenizer.reset(stream);
+        m_Members->scopes.clear();
+        m_Members->scopes.emplace_back(&m_Members->documentReader,
+                                       ReaderState::INITIAL_STATE);
+        m_Members->partialItems.clear();
+    }
+
+    JsonReader::JsonReader(const ReaderOptions& options)
+            : m_Members(std::make_unique<Members>(JsonTokenizer(options)))
+    {
+        m_Members->scopes.emplace_back(&m_Members->documentReader,
+                                       ReaderState::INITIAL_STATE);
+    }
+
+    void JsonReader::reset()
+    {
+        if (!m_Members)
+        {
+            *this = JsonReader(ReaderOptions());
+            return;
+        }
+        m_Members->tokenizer.reset();
+        m_Members->scopes.clear();
+        m_Members->scopes.emplace_back(&m_Members->documentReader,
+                                       ReaderState::INITIAL_STATE);
+        m_Members->partialItems.clear();
+        m_Members->needsMoreData = false;
+    }
+
+    void JsonReader::feed(const char* data, size_t size)
+    {
+        m_Members->tokenizer.feed(data, size);
+    }
+
+    void JsonReader::finishFeed()
+    {
+        m_Members->tokenizer.finishFeed();
+    }
+
+    bool JsonReader::needsMoreData() const
+    {
+        return m_Members->needsMoreData;
+    }
+
     bool JsonReader::nextDocument()
     {
-        auto& scope = m_Members->scopes.back();
-        auto result = scope.first->nextDocument(m_Members->tokenizer,
-                                                scope.second);
-        scope.second = result.first;
-        return result.second;
+        return resumable([&]
+        {
+            auto& scope = m_Members->scopes.back();
+            auto result = scope.first->nextDocument(m_Members->tokenizer,
+                                                    scope.second);
+            scope.second = result.first;
+            return result.second;
+        });
     }
 
     bool JsonReader::nextKey()
     {
-        auto& scope = m_Members->scopes.back();
-        auto result = scope.first->nextKey(m_Members->tokenizer,
-                                           scope.second);
-        scope.second = result.first;
-        return result.second;
+        return resumable([&]
+        {
+            auto& scope = m_Members->scopes.back();
+            auto result = scope.first->nextKey(m_Members->tokenizer,
+                                               scope.second);
+            scope.second = result.first;
+            return result.second;
+        });
     }
 
     bool JsonReader::nextValue()
     {
-        auto& scope = m_Members->scopes.back();
-        auto result = scope.first->nextValue(m_Members->tokenizer,
-                                             scope.second);
-        scope.second = result.first;
-        return result.second;
+        return resumable([&]
+        {
+            auto& scope = m_Members->scopes.back();
+            auto result = scope.first->nextValue(m_Members->tokenizer,
+                                                 scope.second);
+            scope.second = result.first;
+            return result.second;
+        });
     }
 
     void JsonReader::enter()
@@ -118,7 +344,7 @@ namespace Yson
                 JSON_READER_THROW(
                         "There is no object or array to be entered.",
                         m_Members->tokenizer);
-            m_Members->scopes.emplace_back(nextReader, ReaderState::AT_START);
+            m_Members->enterScope(nextReader);
         }
         else
         {
@@ -129,26 +355,30 @@ namespace Yson
 
     void JsonReader::leave()
     {
-        if (m_Members->scopes.size() == 1)
-        {
-            JSON_READER_THROW(
-                    "Cannot call leave() when not inside an array or object",
-                    m_Members->tokenizer);
-        }
-        if (m_Members->currentState() != ReaderState::AT_END)
+        resumable([&]
         {
-            auto& scope = m_Members->scopes.back();
-            while (true)
+            if (m_Members->scopes.size() == 1)
+            {
+                JSON_READER_THROW(
+                        "Cannot call leave() when not inside an array or object",
+                        m_Members->tokenizer);
+            }
+            if (m_Members->currentState() != ReaderState::AT_END)
             {
-                auto result = scope.first->nextValue(m_Members->tokenizer,
-                                                     scope.second);
-                scope.second = result.first;
-                if (!result.second)
-                    break;
+                auto& scope = m_Members->scopes.back();
+                while (true)
+                {
+                    auto result = scope.first->nextValue(m_Members->tokenizer,
+                                                         scope.second);
+                    scope.second = result.first;
+                    if (!result.second)
+                        break;
+                }
             }
-        }
-        m_Members->scopes.pop_back();
-        m_Members->currentState() = ReaderState::AFTER_VALUE;
+            m_Members->scopes.pop_back();
+            m_Members->currentState() = ReaderState::AFTER_VALUE;
+            return true;
+        });
     }
 
     ValueType JsonReader::valueType() const
@@ -233,7 +463,7 @@ namespace Yson
         assertStateIsKeyOrValue();
         if (currentTokenIsValue())
         {
-            return m_Members->tokenizer.tokenString() ==     "null";
+            return m_Members->tokenizer.token() == "null";
         }
         return false;
     }
@@ -243,13 +473,13 @@ namespace Yson
         assertStateIsKeyOrValue();
         if (currentTokenIsValue())
         {
-            if (m_Members->tokenizer.tokenString() == "true")
+            if (m_Members->tokenizer.token() == "true")
             {
                 value = true;
                 return true;
             }
-            if (m_Members->tokenizer.tokenString() == "false"
-                || m_Members->tokenizer.tokenString() == "null")
+            if (m_Members->tokenizer.token() == "false"
+                || m_Members->tokenizer.token() == "null")
             {
                 value = false;
                 return true;
@@ -348,6 +578,7 @@ namespace Yson
                 auto tokenString = m_Members->tokenizer.tokenString();
                 if (hasEscapedCharacters(tokenString))
                 {
+                    countUnescape(m_Members->tokenizer);
                     tokenString = unescape(tokenString);
                     if (tokenString.size() == 1)
                     {
@@ -365,9 +596,17 @@ namespace Yson
         assertStateIsKeyOrValue();
         if (currentTokenIsValueOrString())
         {
-            value = m_Members->tokenizer.tokenString();
-            if (hasEscapedCharacters(value))
-                value = unescape(value);
+            // Assign rather than construct a new string, so that callers
+            // that reuse the same string (e.g. ObjectKeyIterator) don't
+            // allocate memory for every key and value.
+            auto token = m_Members->tokenizer.token();
+            if (hasEscapedCharacters(token))
+            {
+                countUnescape(m_Members->tokenizer);
+                value = unescape(token);
+            }
+            else
+                value.assign(token.data(), token.size());
             return true;
         }
         return false;
@@ -400,93 +639,248 @@ namespace Yson
         return readBase64(value);
     }
 
-    JsonItem JsonReader::readArray() // NOLINT(*-no-recursion)
+    bool JsonReader::readStringChunk(std::string& chunk)
     {
-        std::vector<JsonItem> values;
-        const auto& tokenizer = m_Members->tokenizer;
-        enter();
-        while (true)
-        {
-            if (!nextValue())
-                break;
-
-            auto tType = tokenizer.tokenType();
-            if (tType == JsonTokenType::START_OBJECT)
-                values.push_back(readObject());
-            else if (tType == JsonTokenType::START_ARRAY)
-                values.push_back(readArray());
-            else
-                values.emplace_back(JsonValueItem(tokenizer.tokenString(), tType));
-        }
-        leave();
-        return JsonItem(std::make_shared<ArrayItem>(std::move(values)));
-    }
+        assertStateIsKeyOrValue();
+        if (!currentTokenIsValueOrString())
+            return false;
 
-    JsonItem JsonReader::readObject() // NOLINT(*-no-recursion)
-    {
-        std::deque<std::string> keys;
-        std::unordered_map<std::string_view, JsonItem> values;
-        const auto& tokenizer = m_Members->tokenizer;
-        enter();
-        while (true)
+        auto& tokenizer = m_Members->tokenizer;
+        std::string_view part;
+        while (tokenizer.nextStringPart(part))
         {
-            if (!nextKey())
-                break;
-
-            auto entry = values.find(tokenizer.token());
-            std::string_view key;
-            if (entry != values.end())
+            if (part.empty())
+                continue;
+            if (hasEscapedCharacters(part))
             {
-                key = entry->first;
+                countUnescape(tokenizer);
+                chunk = unescape(part);
             }
             else
             {
-                keys.emplace_back(tokenizer.token());
-                key = keys.back();
+                chunk.assign(part.data(), part.size());
             }
+            return true;
+        }
+        return false;
+    }
 
-            if (!nextValue())
+    bool JsonReader::readBase64Chunk(std::vector<char>& chunk)
+    {
+        assertStateIsKeyOrValue();
+        if (!currentTokenIsString())
+            return false;
+
+        auto& tokenizer = m_Members->tokenizer;
+        auto& remainder = m_Members->base64Remainder;
+        if (tokenizer.isAtStartOfToken())
+            remainder.clear();
+
+        chunk.clear();
+        std::string_view part;
+        while (chunk.empty())
+        {
+            if (!tokenizer.nextStringPart(part))
             {
-                JSON_READER_THROW("Key without value: " + keys.back(),
-                                  tokenizer);
+                // The last group can be padded, or be shorter than four
+                // characters if the padding has been left out.
+                decodeBase64(remainder, chunk, tokenizer);
+                remainder.clear();
+                return !chunk.empty();
             }
 
-            auto tType = tokenizer.tokenType();
-            if (tType == JsonTokenType::START_OBJECT)
-                values.insert_or_assign(key, readObject());
-            else if (tType == JsonTokenType::START_ARRAY)
-                values.insert_or_assign(key, readArray());
-            else
-                values.insert_or_assign(key, JsonItem(JsonValueItem(tokenizer.tokenString(), tType)));
+            // The last group of the part is held back until it is known
+            // whether it is the last group of the string.
+            auto n = std::min(4 - remainder.size(), part.size());
+            remainder.append(part.substr(0, n));
+            part.remove_prefix(n);
+            if (part.empty())
+                continue;
+            decodeBase64Groups(remainder, chunk, tokenizer);
+
+            auto heldBack = part.size() % 4;
+            if (heldBack == 0)
+                heldBack = 4;
+            decodeBase64Groups(part.substr(0, part.size() - heldBack),
+                               chunk, tokenizer);
+            remainder.assign(part.substr(part.size() - heldBack));
         }
-        leave();
-        return JsonItem(std::make_shared<ObjectItem>(std::move(keys), std::move(values)));
+        return true;
+    }
+
+    bool JsonReader::readArray(std::vector<int32_t>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(std::vector<int64_t>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(std::vector<uint32_t>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(std::vector<uint64_t>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(std::vector<float>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(std::vector<double>& values)
+    {
+        return readArrayImpl(values);
+    }
+
+    bool JsonReader::readArray(int32_t* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
+    }
+
+    bool JsonReader::readArray(int64_t* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
+    }
+
+    bool JsonReader::readArray(uint32_t* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
+    }
+
+    bool JsonReader::readArray(uint64_t* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
+    }
+
+    bool JsonReader::readArray(float* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
+    }
+
+    bool JsonReader::readArray(double* buffer, size_t& size)
+    {
+        return readArrayImpl(buffer, size);
     }
 
     JsonItem JsonReader::readItem()
     {
-        auto& tokenizer = m_Members->tokenizer;
-        switch (m_Members->currentState())
+        auto item = tryReadItem();
+        if (!item)
         {
-        case ReaderState::INITIAL_STATE:
-        case ReaderState::AT_START:
-            if (!nextValue())
-                JSON_READER_THROW("Document is empty.", tokenizer);
-            [[fallthrough]];
-        case ReaderState::AT_VALUE:
+            JSON_READER_THROW("The item is incomplete, more data must be "
+                              "fed to the reader.", m_Members->tokenizer);
+        }
+        return std::move(*item);
+    }
+
+    std::optional<JsonItem> JsonReader::tryReadItem()
+    {
+        auto& m = *m_Members;
+        try
         {
+            return readItemImpl();
+        }
+        catch (...)
+        {
+            m.partialItems.clear();
+            throw;
+        }
+    }
+
+    std::optional<JsonItem> JsonReader::readItemImpl()
+    {
+        // Arrays and objects are read with an explicit stack rather than
+        // recursively. In push mode the stack keeps the part of the item
+        // that has been read when the reader runs out of data, and the
+        // next call continues from there.
+        auto& m = *m_Members;
+        auto& tokenizer = m.tokenizer;
+        auto& items = m.partialItems;
+        if (items.empty())
+        {
+            switch (m.currentState())
+            {
+            case ReaderState::INITIAL_STATE:
+            case ReaderState::AT_START:
+                if (!nextValue())
+                {
+                    if (m.needsMoreData)
+                        return {};
+                    JSON_READER_THROW("Document is empty.", tokenizer);
+                }
+                break;
+            case ReaderState::AT_VALUE:
+                break;
+            case ReaderState::AT_KEY:
+                return m.makeValueItem(tokenizer.tokenType());
+            default:
+                JSON_READER_THROW("No key or value.", tokenizer);
+            }
+
             auto tType = tokenizer.tokenType();
-            if (tType == JsonTokenType::START_OBJECT)
-                return readObject();
-            if (tType == JsonTokenType::START_ARRAY)
-                return readArray();
-            return JsonItem(JsonValueItem(tokenizer.tokenString(), tType));
-        }
-        case ReaderState::AT_KEY:
-            return JsonItem(JsonValueItem(tokenizer.tokenString(),
-                                      tokenizer.tokenType()));
-        default:
-            JSON_READER_THROW("No key or value.", tokenizer);
+            if (tType != JsonTokenType::START_OBJECT
+                && tType != JsonTokenType::START_ARRAY)
+            {
+                return m.makeValueItem(tType);
+            }
+            enter();
+            items.emplace_back(tType == JsonTokenType::START_OBJECT,
+                               tokenizer.memoryResource());
+        }
+
+        while (true)
+        {
+            auto& item = items.back();
+            if (item.isObject && !item.hasKey)
+            {
+                if (nextKey())
+                    item.setKey(tokenizer.token());
+                else if (m.needsMoreData)
+                    return {};
+            }
+
+            bool isAtValue = false;
+            if (!item.isObject || item.hasKey)
+            {
+                isAtValue = nextValue();
+                if (!isAtValue && m.needsMoreData)
+                    return {};
+                if (!isAtValue && item.hasKey)
+                {
+                    JSON_READER_THROW("Key without value: "
+                                      + std::string(item.key), tokenizer);
+                }
+            }
+
+            if (!isAtValue)
+            {
+                leave();
+                auto result = item.makeItem(tokenizer.memoryResource());
+                items.pop_back();
+                if (items.empty())
+                    return result;
+                items.back().add(std::move(result));
+                continue;
+            }
+
+            auto tType = tokenizer.tokenType();
+            if (tType == JsonTokenType::START_OBJECT
+                || tType == JsonTokenType::START_ARRAY)
+            {
+                enter();
+                items.emplace_back(tType == JsonTokenType::START_OBJECT,
+                                   tokenizer.memoryResource());
+            }
+            else
+            {
+                item.add(m.makeValueItem(tType));
+            }
         }
     }
 
@@ -552,6 +946,122 @@ namespace Yson
         return false;
     }
 
+    bool JsonReader::enterNumericArray()
+    {
+        if (m_Members->currentState() != ReaderState::AT_VALUE)
+        {
+            JSON_READER_THROW("Select a value before calling readArray.",
+                              m_Members->tokenizer);
+        }
+        if (m_Members->tokenizer.tokenType() != JsonTokenType::START_ARRAY)
+            return false;
+        m_Members->enterScope(&m_Members->arrayReader);
+        return true;
+    }
+
+    bool JsonReader::nextNumericArrayValue()
+    {
+        // Calls JsonArrayReader directly rather than through the scope's
+        // JsonScopeReader pointer to avoid a virtual call per value.
+        auto& state = m_Members->currentState();
+        auto result = m_Members->arrayReader.nextValue(m_Members->tokenizer,
+                                                       state);
+        state = result.first;
+        return result.second;
+    }
+
+    template <typename T>
+    bool JsonReader::readArrayImpl(std::vector<T>& values)
+    {
+        auto result = resumable([&]
+        {
+            values.clear();
+            if (!enterNumericArray())
+                return false;
+
+            auto& tokenizer = m_Members->tokenizer;
+            while (nextNumericArrayValue())
+            {
+                T value;
+                if (!parseArrayValue(tokenizer, value))
+                    return false;
+                values.push_back(value);
+            }
+            leave();
+            return true;
+        });
+        if (!result && m_Members->needsMoreData)
+            values.clear();
+        return result;
+    }
+
+    template <typename T>
+    bool JsonReader::readArrayImpl(T* buffer, size_t& size)
+    {
+        return resumable([&]
+        {
+            if (!enterNumericArray())
+            {
+                size = 0;
+                return false;
+            }
+
+            auto& tokenizer = m_Members->tokenizer;
+            size_t count = 0;
+            while (nextNumericArrayValue())
+            {
+                if (count == size
+                    || !parseArrayValue(tokenizer, buffer[count]))
+                {
+                    size = count;
+                    return false;
+                }
+                ++count;
+            }
+            leave();
+            size = count;
+            return true;
+        });
+    }
+
+    template <typename Func>
+    bool JsonReader::resumable(Func func)
+    {
+        // In push mode the tokenizer throws JsonTokenizerNeedsMoreData when
+        // it runs out of data. The outermost call then rolls the reader
+        // back to where the operation started, so it can be repeated
+        // when more data has been fed.
+        auto& m = *m_Members;
+        if (!m.tokenizer.isPushMode() || m.inResumableCall)
+            return func();
+
+        m.needsMoreData = false;
+        m.savedScopes = m.scopes;
+        m.tokenizer.setCheckpoint();
+        m.inResumableCall = true;
+        try
+        {
+            auto result = func();
+            m.inResumableCall = false;
+            m.tokenizer.clearCheckpoint();
+            return result;
+        }
+        catch (const JsonTokenizerNeedsMoreData&)
+        {
+            m.inResumableCall = false;
+            m.tokenizer.restoreCheckpoint();
+            m.scopes.swap(m.savedScopes);
+            m.needsMoreData = true;
+            return false;
+        }
+        catch (...)
+        {
+            m.inResumableCall = false;
+            m.tokenizer.clearCheckpoint();
+            throw;
+        }
+    }
+
     ReaderState JsonReader::state() const
     {
         return m_Members->currentState();
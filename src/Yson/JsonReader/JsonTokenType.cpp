@@ -33,6 +33,7 @@ namespace Yson
         CASE_TYPE(WHITESPACE);
         CASE_TYPE(NEWLINE);
         CASE_TYPE(INTERNAL_MULTILINE_STRING);
+        CASE_TYPE(INTERNAL_PARTIAL_STRING);
         }
         return "<unknown token type: " + std::to_string(int(type)) + ">";
     }
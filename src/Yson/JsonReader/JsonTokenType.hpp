@@ -12,7 +12,7 @@
 
 namespace Yson
 {
-    enum class JsonTokenType
+    enum class JsonTokenType : char
     {
         INVALID_TOKEN,
         START_ARRAY,
@@ -36,7 +36,11 @@ namespace Yson
         NEWLINE,
         /** Used internally in JsonTokenizer.
           */
-        INTERNAL_MULTILINE_STRING
+        INTERNAL_MULTILINE_STRING,
+        /** Used internally in JsonTokenizer for strings that are longer
+          * than the chunk size.
+          */
+        INTERNAL_PARTIAL_STRING
     };
 
     std::string toString(JsonTokenType type);
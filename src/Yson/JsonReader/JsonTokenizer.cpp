@@ -7,32 +7,139 @@
 //****************************************************************************
 #include "JsonTokenizer.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <tuple>
+#include <typeinfo>
+#include "Yson/ReaderStats.hpp"
 #include "Yson/YsonException.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
 #include "Yson/Common/DefaultBufferSize.hpp"
+#include "Yson/Common/FindInvalidUtf8.hpp"
+#include "Yson/Common/MemoryResource.hpp"
 #include "JsonTokenizerUtilities.hpp"
 #include "TextBufferReader.hpp"
 #include "TextFileReader.hpp"
+#include "TextPushReader.hpp"
+#include "ThrowJsonReaderException.hpp"
 
 namespace Yson
 {
+    namespace
+    {
+        Yconvert::Encoding toYconvertEncoding(TextEncoding encoding)
+        {
+            switch (encoding)
+            {
+            case TextEncoding::UTF_8:
+                return Yconvert::Encoding::UTF_8;
+            case TextEncoding::UTF_16_LE:
+                return Yconvert::Encoding::UTF_16_LE;
+            case TextEncoding::UTF_16_BE:
+                return Yconvert::Encoding::UTF_16_BE;
+            case TextEncoding::UTF_32_LE:
+                return Yconvert::Encoding::UTF_32_LE;
+            case TextEncoding::UTF_32_BE:
+                return Yconvert::Encoding::UTF_32_BE;
+            default:
+                return Yconvert::Encoding::UNKNOWN;
+            }
+        }
+
+        std::unique_ptr<TextReader>
+        makeStreamReader(std::istream& stream,
+                         const char* buffer, size_t bufferSize,
+                         Compression compression,
+                         Yconvert::Encoding encoding,
+                         std::pmr::memory_resource* memoryResource)
+        {
+            if (auto decompressingStream = openDecompressingStream(
+                    stream, buffer, bufferSize, compression))
+            {
+                return std::make_unique<TextStreamReader>(
+                    std::move(decompressingStream), encoding, memoryResource);
+            }
+            return std::make_unique<TextStreamReader>(
+                stream, buffer, bufferSize, encoding, memoryResource);
+        }
+
+        std::unique_ptr<TextReader>
+        makeBufferReader(const char* buffer, size_t bufferSize,
+                         Compression compression,
+                         Yconvert::Encoding encoding,
+                         std::pmr::memory_resource* memoryResource)
+        {
+            if (auto decompressingStream = openDecompressingStream(
+                    buffer, bufferSize, compression))
+            {
+                return std::make_unique<TextStreamReader>(
+                    std::move(decompressingStream), encoding, memoryResource);
+            }
+            return std::make_unique<TextBufferReader>(buffer, bufferSize,
+                                                      encoding);
+        }
+    }
+
+    JsonTokenizer::JsonTokenizer(std::unique_ptr<TextReader> textReader,
+                                 const ReaderOptions& options)
+        : m_TextReader(std::move(textReader)),
+          m_MemoryResource(getMemoryResource(options.memoryResource)),
+          m_Buffer(m_MemoryResource),
+          m_ChunkSize(options.chunkSize ? options.chunkSize
+                                        : getDefaultBufferSize()),
+          m_MaxChunkSize(options.maxChunkSize),
+          m_MaxTokenSize(options.maxTokenSize),
+          m_Encoding(options.encoding),
+          m_Compression(options.compression),
+          m_StreamCompression(getStreamCompression(options)),
+          m_ValidateUtf8(options.validateUtf8),
+          m_Stats(options.stats)
+    {
+        if (m_ChunkSize < 4)
+            YSON_THROW("Chunk size can't be less than 4.");
+        m_TextReader->setStats(m_Stats);
+    }
+
+    JsonTokenizer::JsonTokenizer(const ReaderOptions& options)
+        : JsonTokenizer(std::make_unique<TextPushReader>(
+                            toYconvertEncoding(options.encoding),
+                            getMemoryResource(options.memoryResource)),
+                        options)
+    {
+        m_PushReader = static_cast<TextPushReader*>(m_TextReader.get());
+    }
+
     JsonTokenizer::JsonTokenizer(std::istream& stream,
                                  const char* buffer,
-                                 size_t bufferSize)
-        : m_TextReader(new TextStreamReader(stream, buffer, bufferSize)),
-          m_ChunkSize(getDefaultBufferSize())
+                                 size_t bufferSize,
+                                 const ReaderOptions& options)
+        : JsonTokenizer(makeStreamReader(
+                            stream, buffer, bufferSize,
+                            getStreamCompression(options),
+                            toYconvertEncoding(options.encoding),
+                            getMemoryResource(options.memoryResource)),
+                        options)
     {}
 
-    JsonTokenizer::JsonTokenizer(const std::filesystem::path& fileName)
-        : m_TextReader(new TextFileReader(fileName)),
-          m_FileName(fileName.string()),
-          m_ChunkSize(getDefaultBufferSize())
-    {}
+    JsonTokenizer::JsonTokenizer(const std::filesystem::path& fileName,
+                                 const ReaderOptions& options)
+        : JsonTokenizer(std::make_unique<TextFileReader>(
+                            fileName, toYconvertEncoding(options.encoding),
+                            getMemoryResource(options.memoryResource),
+                            options.compression),
+                        options)
+    {
+        m_FileName = fileName.string();
+    }
 
-    JsonTokenizer::JsonTokenizer(const char* buffer, size_t bufferSize)
-        : m_TextReader(new TextBufferReader(buffer, bufferSize)),
-          m_ChunkSize(getDefaultBufferSize())
+    JsonTokenizer::JsonTokenizer(const char* buffer, size_t bufferSize,
+                                 const ReaderOptions& options)
+        : JsonTokenizer(makeBufferReader(
+                            buffer, bufferSize,
+                            options.compression,
+                            toYconvertEncoding(options.encoding),
+                            getMemoryResource(options.memoryResource)),
+                        options)
     {}
 
     JsonTokenizer::~JsonTokenizer() = default;
@@ -41,6 +148,9 @@ namespace Yson
 
     bool JsonTokenizer::next()
     {
+        if (m_StringState != StringState::COMPLETE)
+            skipRestOfString();
+
         while (internalNext())
         {
             switch (m_TokenType)
@@ -56,15 +166,36 @@ namespace Yson
             case JsonTokenType::COMMA:
             case JsonTokenType::VALUE:
                 m_ColumnNumber += m_TokenEnd - m_TokenStart;
+                if (m_Stats)
+                    countToken();
                 return true;
             case JsonTokenType::STRING:
                 m_ColumnNumber += m_TokenEnd-- - m_TokenStart++;
+                if (m_Stats)
+                    ++m_Stats->stringTokens;
                 return true;
             case JsonTokenType::INTERNAL_MULTILINE_STRING:
+                // The line continuations are removed in place, the token
+                // can't be scanned again after restoring a checkpoint.
+                if (m_PushReader)
+                {
+                    JSON_READER_THROW("Multiline strings are not supported "
+                                      "in push mode.", *this);
+                }
                 addLinesAndColumns(m_LineNumber, m_ColumnNumber,
                                    countLinesAndColumns(token()));
                 removeLineContinuations();
                 m_TokenType = JsonTokenType::STRING;
+                if (m_Stats)
+                    ++m_Stats->stringTokens;
+                return true;
+            case JsonTokenType::INTERNAL_PARTIAL_STRING:
+                // The string's lines and columns are counted when it is
+                // read or skipped.
+                m_StringQuote = *m_TokenStart++;
+                m_StringState = StringState::PARTIAL;
+                m_StringPartsSize = 0;
+                m_TokenType = JsonTokenType::STRING;
                 return true;
             case JsonTokenType::INCOMPLETE_TOKEN:
                 break;
@@ -92,15 +223,110 @@ namespace Yson
         return m_TokenType;
     }
 
-    std::string_view JsonTokenizer::token() const
+    std::string_view JsonTokenizer::token()
     {
+        switch (m_StringState)
+        {
+        case StringState::PARTIAL:
+            completeString();
+            break;
+        case StringState::PARTIAL_READ:
+        case StringState::CONSUMED:
+            JSON_READER_THROW("The string has been read in parts and is no"
+                              " longer available.", *this);
+        default:
+            break;
+        }
         return {m_TokenStart, size_t(m_TokenEnd - m_TokenStart)};
     }
 
+    bool JsonTokenizer::nextStringPart(std::string_view& part)
+    {
+        switch (m_StringState)
+        {
+        case StringState::COMPLETE:
+            part = token();
+            m_StringState = StringState::COMPLETE_READ;
+            return true;
+        case StringState::PARTIAL:
+            // The opening quote.
+            ++m_ColumnNumber;
+            m_StringState = StringState::PARTIAL_READ;
+            break;
+        case StringState::PARTIAL_READ:
+            break;
+        default:
+            return false;
+        }
+
+        while (true)
+        {
+            auto remaining = size_t(m_BufferEnd - m_TokenStart);
+            auto result = findEndOfStringPart(
+                std::string_view(m_TokenStart, remaining), m_StringQuote);
+            auto text = std::string_view(
+                m_TokenStart, size_t(result.endOfToken - m_TokenStart));
+            if (result.tokenType == JsonTokenType::INVALID_TOKEN)
+            {
+                addLinesAndColumns(m_LineNumber, m_ColumnNumber,
+                                   countLinesAndColumns(text));
+                JSON_READER_THROW("Invalid character in string.", *this);
+            }
+
+            if (!text.empty() || !result.isIncomplete)
+            {
+                m_StringPartsSize += text.size();
+                assertTokenSizeIsWithinLimit(m_StringPartsSize);
+                addLinesAndColumns(m_LineNumber, m_ColumnNumber,
+                                   countLinesAndColumns(text));
+                auto first = &m_Buffer[0] + (m_TokenStart - m_BufferStart);
+                auto last = first + text.size();
+                if (result.tokenType
+                    == JsonTokenType::INTERNAL_MULTILINE_STRING)
+                {
+                    last = Yson::removeLineContinuations(first, last);
+                }
+                part = {first, size_t(last - first)};
+                m_TokenStart = m_TokenEnd = m_NextToken = result.endOfToken;
+                if (!result.isIncomplete)
+                {
+                    // The closing quote.
+                    ++m_ColumnNumber;
+                    ++m_NextToken;
+                    m_StringState = StringState::CONSUMED;
+                    if (m_Stats)
+                        ++m_Stats->stringTokens;
+                }
+                return true;
+            }
+
+            if (!fillBuffer()
+                && size_t(m_BufferEnd - m_TokenStart) == remaining)
+            {
+                JSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            }
+        }
+    }
+
+    bool JsonTokenizer::isAtStartOfToken() const
+    {
+        return m_StringState == StringState::COMPLETE
+               || m_StringState == StringState::PARTIAL;
+    }
+
+    ReaderStats* JsonTokenizer::stats() const
+    {
+        return m_Stats;
+    }
+
+    std::pmr::memory_resource* JsonTokenizer::memoryResource() const
+    {
+        return m_MemoryResource;
+    }
+
     std::string JsonTokenizer::tokenString() const
     {
-        auto view = token();
-        return {view.begin(), view.end()};
+        return {m_TokenStart, m_TokenEnd};
     }
 
     const std::string& JsonTokenizer::fileName() const
@@ -118,6 +344,11 @@ namespace Yson
         return m_ColumnNumber;
     }
 
+    size_t JsonTokenizer::offset() const
+    {
+        return m_BufferOffset + size_t(m_TokenStart - m_BufferStart);
+    }
+
     size_t JsonTokenizer::chunkSize() const
     {
         return m_ChunkSize;
@@ -133,6 +364,165 @@ namespace Yson
         m_ChunkSize = value;
     }
 
+    void JsonTokenizer::reset(std::istream& stream,
+                              const char* buffer,
+                              size_t bufferSize)
+    {
+        auto decompressingStream = openDecompressingStream(
+            stream, buffer, bufferSize, m_StreamCompression);
+        // TextFileReader is derived from TextStreamReader, but it owns
+        // its stream and can't be reused.
+        if (!decompressingStream && m_TextReader
+            && typeid(*m_TextReader) == typeid(TextStreamReader))
+        {
+            static_cast<TextStreamReader&>(*m_TextReader)
+                .reset(stream, buffer, bufferSize);
+        }
+        else
+        {
+            if (decompressingStream)
+            {
+                m_TextReader = std::make_unique<TextStreamReader>(
+                    std::move(decompressingStream),
+                    toYconvertEncoding(m_Encoding), m_MemoryResource);
+            }
+            else
+            {
+                m_TextReader = std::make_unique<TextStreamReader>(
+                    stream, buffer, bufferSize,
+                    toYconvertEncoding(m_Encoding), m_MemoryResource);
+            }
+            m_TextReader->setStats(m_Stats);
+        }
+        m_PushReader = nullptr;
+        m_FileName.clear();
+        resetTokenState();
+    }
+
+    void JsonTokenizer::reset(const char* buffer, size_t bufferSize)
+    {
+        auto decompressingStream = openDecompressingStream(
+            buffer, bufferSize, m_Compression);
+        auto reader = dynamic_cast<TextBufferReader*>(m_TextReader.get());
+        if (!decompressingStream && reader)
+        {
+            reader->reset(buffer, bufferSize);
+        }
+        else
+        {
+            if (decompressingStream)
+            {
+                m_TextReader = std::make_unique<TextStreamReader>(
+                    std::move(decompressingStream),
+                    toYconvertEncoding(m_Encoding), m_MemoryResource);
+            }
+            else
+            {
+                m_TextReader = std::make_unique<TextBufferReader>(
+                    buffer, bufferSize, toYconvertEncoding(m_Encoding));
+            }
+            m_TextReader->setStats(m_Stats);
+        }
+        m_PushReader = nullptr;
+        m_FileName.clear();
+        resetTokenState();
+    }
+
+    void JsonTokenizer::reset()
+    {
+        if (m_PushReader)
+        {
+            m_PushReader->reset();
+        }
+        else
+        {
+            m_TextReader = std::make_unique<TextPushReader>(
+                toYconvertEncoding(m_Encoding), m_MemoryResource);
+            m_TextReader->setStats(m_Stats);
+            m_PushReader = static_cast<TextPushReader*>(m_TextReader.get());
+        }
+        m_FileName.clear();
+        resetTokenState();
+    }
+
+    bool JsonTokenizer::isPushMode() const
+    {
+        return m_PushReader != nullptr;
+    }
+
+    void JsonTokenizer::feed(const char* data, size_t size)
+    {
+        if (!m_PushReader)
+            YSON_THROW("feed() can only be used in push mode.");
+        m_PushReader->feed(data, size);
+    }
+
+    void JsonTokenizer::finishFeed()
+    {
+        if (!m_PushReader)
+            YSON_THROW("finishFeed() can only be used in push mode.");
+        m_PushReader->finish();
+    }
+
+    void JsonTokenizer::setCheckpoint()
+    {
+        m_Checkpoint.tokenStart = size_t(m_TokenStart - m_BufferStart);
+        m_Checkpoint.tokenEnd = size_t(m_TokenEnd - m_BufferStart);
+        m_Checkpoint.nextToken = size_t(m_NextToken - m_BufferStart);
+        m_Checkpoint.lineNumber = m_LineNumber;
+        m_Checkpoint.columnNumber = m_ColumnNumber;
+        m_Checkpoint.tokenType = m_TokenType;
+        if (m_Stats)
+        {
+            m_Checkpoint.objectTokens = m_Stats->objectTokens;
+            m_Checkpoint.arrayTokens = m_Stats->arrayTokens;
+            m_Checkpoint.stringTokens = m_Stats->stringTokens;
+            m_Checkpoint.valueTokens = m_Stats->valueTokens;
+        }
+        m_HasCheckpoint = true;
+    }
+
+    void JsonTokenizer::restoreCheckpoint()
+    {
+        m_TokenStart = m_BufferStart + m_Checkpoint.tokenStart;
+        m_TokenEnd = m_BufferStart + m_Checkpoint.tokenEnd;
+        m_NextToken = m_BufferStart + m_Checkpoint.nextToken;
+        m_LineNumber = m_Checkpoint.lineNumber;
+        m_ColumnNumber = m_Checkpoint.columnNumber;
+        m_TokenType = m_Checkpoint.tokenType;
+        if (m_Stats)
+        {
+            m_Stats->objectTokens = m_Checkpoint.objectTokens;
+            m_Stats->arrayTokens = m_Checkpoint.arrayTokens;
+            m_Stats->stringTokens = m_Checkpoint.stringTokens;
+            m_Stats->valueTokens = m_Checkpoint.valueTokens;
+        }
+        m_HasCheckpoint = false;
+    }
+
+    void JsonTokenizer::clearCheckpoint()
+    {
+        m_HasCheckpoint = false;
+    }
+
+    void JsonTokenizer::resetTokenState()
+    {
+        m_HasCheckpoint = false;
+        m_Buffer.clear();
+        m_BufferOffset = 0;
+        m_ValidatedSize = 0;
+        m_BufferStart = m_BufferEnd = nullptr;
+        m_TokenStart = m_TokenEnd = m_NextToken = nullptr;
+        m_LineNumber = 1;
+        m_ColumnNumber = 1;
+        m_TokenType = JsonTokenType::INVALID_TOKEN;
+        m_StringState = StringState::COMPLETE;
+        m_StringPartsSize = 0;
+        m_IsCompletingString = false;
+        m_ScanState = {};
+        m_ScanStateOffset = SIZE_MAX;
+    }
+
     bool JsonTokenizer::internalNext()
     {
         if (m_TokenType == JsonTokenType::END_OF_FILE)
@@ -141,32 +531,54 @@ namespace Yson
         if (m_NextToken != m_TokenStart)
         {
             m_TokenStart = m_NextToken;
-            auto token = nextToken(std::string_view(m_TokenStart,
-                                                    m_BufferEnd - m_TokenStart));
+            auto token = scanToken(false);
             if (!token.isIncomplete)
             {
+                assertTokenSizeIsWithinLimit(
+                    size_t(token.endOfToken - m_TokenStart));
                 m_NextToken = m_TokenEnd = token.endOfToken;
                 m_TokenType = token.tokenType;
                 return true;
             }
 
+            assertTokenSizeIsWithinLimit(size_t(m_BufferEnd - m_TokenStart));
             m_TokenType = JsonTokenType::INCOMPLETE_TOKEN;
             return true;
         }
 
         bool isEndOfFile = !fillBuffer();
+        if (isEndOfFile && m_PushReader && !m_PushReader->isFinished())
+            throw JsonTokenizerNeedsMoreData();
         if (!isEndOfFile || !m_Buffer.empty())
         {
-            auto token = nextToken(
-                std::string_view(m_TokenStart, m_BufferEnd - m_TokenStart),
-                isEndOfFile);
+            auto token = scanToken(isEndOfFile);
             if (!token.isIncomplete)
             {
+                assertTokenSizeIsWithinLimit(
+                    size_t(token.endOfToken - m_TokenStart));
                 m_NextToken = m_TokenEnd = token.endOfToken;
                 m_TokenType = token.tokenType;
                 return true;
             }
 
+            assertTokenSizeIsWithinLimit(size_t(m_BufferEnd - m_TokenStart));
+            // Strings that are longer than the chunk size are returned
+            // without reading the rest of them, they can then be read in
+            // parts or skipped without keeping all of them in the buffer.
+            if ((token.tokenType == JsonTokenType::STRING
+                 || token.tokenType == JsonTokenType::INTERNAL_MULTILINE_STRING)
+                && !m_PushReader && !m_IsCompletingString
+                && size_t(m_BufferEnd - m_TokenStart) >= m_ChunkSize)
+            {
+                m_TokenEnd = m_NextToken = m_BufferEnd;
+                m_TokenType = JsonTokenType::INTERNAL_PARTIAL_STRING;
+                return true;
+            }
+
+            // The token didn't fit in the chunk that was just read,
+            // read larger chunks from now on if that's allowed.
+            if (m_ChunkSize < m_MaxChunkSize)
+                m_ChunkSize = std::min(m_ChunkSize * 2, m_MaxChunkSize);
             m_TokenType = JsonTokenType::INCOMPLETE_TOKEN;
             return true;
         }
@@ -175,26 +587,127 @@ namespace Yson
         return false;
     }
 
+    Result JsonTokenizer::scanToken(bool isEndOfFile)
+    {
+        auto tokenOffset = offset();
+        if (tokenOffset != m_ScanStateOffset)
+        {
+            m_ScanState = {};
+            m_ScanStateOffset = tokenOffset;
+        }
+        return nextToken(
+            std::string_view(m_TokenStart, size_t(m_BufferEnd - m_TokenStart)),
+            isEndOfFile, m_ScanState);
+    }
+
     bool JsonTokenizer::fillBuffer()
     {
-        if (m_TokenStart != m_BufferEnd && m_TokenStart != m_BufferStart)
+        // Everything from the checkpoint's token and onwards must be kept
+        // so the checkpoint can be restored.
+        auto keepFrom = m_HasCheckpoint
+                        ? m_BufferStart + m_Checkpoint.tokenStart
+                        : m_TokenStart;
+        auto tokenOffset = size_t(m_TokenStart - keepFrom);
+        auto removedSize = size_t(keepFrom - m_BufferStart);
+        m_BufferOffset += removedSize;
+        m_ValidatedSize -= std::min(m_ValidatedSize, removedSize);
+        if (m_HasCheckpoint)
+        {
+            auto shift = size_t(keepFrom - m_BufferStart);
+            m_Checkpoint.tokenStart -= shift;
+            m_Checkpoint.tokenEnd -= shift;
+            m_Checkpoint.nextToken -= shift;
+        }
+
+        if (keepFrom != m_BufferEnd && keepFrom != m_BufferStart)
         {
-            std::copy(m_TokenStart, m_BufferEnd, m_Buffer.begin());
-            m_Buffer.resize(m_BufferEnd - m_TokenStart);
-            m_TokenStart = m_TokenEnd = m_NextToken = m_BufferStart;
-            m_BufferEnd = m_BufferStart + m_Buffer.size();
+            std::copy(keepFrom, m_BufferEnd, m_Buffer.begin());
+            m_Buffer.resize(m_BufferEnd - keepFrom);
+            if (m_Stats)
+                m_Stats->bytesMoved += m_Buffer.size();
         }
-        else if (m_TokenStart == m_BufferEnd)
+        else if (keepFrom == m_BufferEnd)
         {
             m_Buffer.clear();
         }
 
-        if (!m_TextReader->read(m_Buffer, m_ChunkSize))
-            return false;
+        auto sizeBefore = m_Buffer.size();
+        auto capacityBefore = m_Buffer.capacity();
+        bool result = m_TextReader->read(m_Buffer, m_ChunkSize);
+        if (m_Stats)
+        {
+            ++m_Stats->bufferRefills;
+            m_Stats->bytesRead += m_Buffer.size() - sizeBefore;
+            if (m_Buffer.capacity() != capacityBefore)
+                ++m_Stats->allocations;
+        }
 
-        m_BufferStart = m_TokenStart = m_TokenEnd = m_NextToken = m_Buffer.data();
-        m_BufferEnd = m_Buffer.data() + m_Buffer.size();
-        return true;
+        m_BufferStart = m_Buffer.data();
+        m_BufferEnd = m_BufferStart + m_Buffer.size();
+        m_TokenStart = m_TokenEnd = m_NextToken = m_BufferStart + tokenOffset;
+        if (m_ValidateUtf8)
+            validateUtf8(!result && !(m_PushReader
+                                      && !m_PushReader->isFinished()));
+        return result;
+    }
+
+    void JsonTokenizer::countToken() const
+    {
+        switch (m_TokenType)
+        {
+        case JsonTokenType::START_ARRAY:
+            ++m_Stats->arrayTokens;
+            break;
+        case JsonTokenType::START_OBJECT:
+            ++m_Stats->objectTokens;
+            break;
+        case JsonTokenType::VALUE:
+            ++m_Stats->valueTokens;
+            break;
+        default:
+            break;
+        }
+    }
+
+    void JsonTokenizer::validateUtf8(bool isEndOfInput)
+    {
+        // A multi-byte character can be split between two reads, in
+        // which case its first bytes are validated again after the next
+        // read.
+        auto start = m_BufferStart + m_ValidatedSize;
+        bool isIncomplete;
+        m_ValidatedSize += findInvalidUtf8(
+            std::string_view(start, size_t(m_BufferEnd - start)),
+            isIncomplete);
+        if (m_ValidatedSize == m_Buffer.size()
+            || (isIncomplete && !isEndOfInput))
+        {
+            return;
+        }
+
+        auto invalid = m_BufferStart + m_ValidatedSize;
+        auto line = m_LineNumber;
+        auto column = m_ColumnNumber;
+        if (invalid > m_TokenStart)
+        {
+            addLinesAndColumns(line, column, countLinesAndColumns(
+                std::string_view(m_TokenStart,
+                                 size_t(invalid - m_TokenStart))));
+        }
+        throw YsonReaderException("Invalid UTF-8 character.",
+                                  YSON_DEBUG_LOCATION(),
+                                  m_FileName, line, column,
+                                  m_BufferOffset + m_ValidatedSize);
+    }
+
+    void JsonTokenizer::assertTokenSizeIsWithinLimit(size_t tokenSize) const
+    {
+        if (m_MaxTokenSize != 0 && tokenSize > m_MaxTokenSize)
+        {
+            JSON_READER_THROW("Token is longer than the maximum token size ("
+                              + std::to_string(m_MaxTokenSize) + " bytes).",
+                              *this);
+        }
     }
 
     void JsonTokenizer::removeLineContinuations()
@@ -203,16 +716,31 @@ namespace Yson
         ++m_TokenStart;
         auto from = &m_Buffer[0] + (m_TokenStart - m_Buffer.data());
         auto to = &m_Buffer[0] + (m_TokenEnd - m_Buffer.data()) - 1;
-        auto next = findLineContinuation(from, to);
-        auto dst = next.first;
-        from = next.second;
-        while (from != to)
+        m_TokenEnd = Yson::removeLineContinuations(from, to);
+    }
+
+    void JsonTokenizer::completeString()
+    {
+        // Nothing has been read from the string yet, its opening quote
+        // is still in the buffer in front of the token.
+        m_StringState = StringState::COMPLETE;
+        m_TokenEnd = m_NextToken = --m_TokenStart;
+        m_IsCompletingString = true;
+        const auto isString = next() && m_TokenType == JsonTokenType::STRING;
+        m_IsCompletingString = false;
+        if (!isString)
+            JSON_READER_THROW("Invalid string.", *this);
+    }
+
+    void JsonTokenizer::skipRestOfString()
+    {
+        if (m_StringState == StringState::PARTIAL
+            || m_StringState == StringState::PARTIAL_READ)
         {
-            next = findLineContinuation(from, to);
-            std::copy(from, next.first, dst);
-            dst += next.first - from;
-            from = next.second;
+            std::string_view part;
+            while (nextStringPart(part))
+            {}
         }
-        m_TokenEnd = dst;
+        m_StringState = StringState::COMPLETE;
     }
 }
@@ -7,25 +7,49 @@
 //****************************************************************************
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <string_view>
+#include "Yson/ReaderOptions.hpp"
 #include "Yson/YsonDefinitions.hpp"
 #include "JsonTokenType.hpp"
+#include "JsonTokenizerUtilities.hpp"
 #include "TextReader.hpp"
 
 namespace Yson
 {
+    class TextPushReader;
+
+    /**
+     * @brief Thrown by a JsonTokenizer in push mode when it needs more
+     *  data than has been fed to it.
+     *
+     * JsonReader catches it and restores the tokenizer to its last
+     * checkpoint.
+     */
+    struct JsonTokenizerNeedsMoreData
+    {};
+
     class YSON_API JsonTokenizer
     {
     public:
+        /**
+         * @brief Creates a tokenizer in push mode, its input is supplied
+         *  with feed().
+         */
+        explicit JsonTokenizer(const ReaderOptions& options);
+
         explicit JsonTokenizer(std::istream& stream,
                                const char* buffer = nullptr,
-                               size_t bufferSize = 0);
+                               size_t bufferSize = 0,
+                               const ReaderOptions& options = {});
 
-        explicit JsonTokenizer(const std::filesystem::path& fileName);
+        explicit JsonTokenizer(const std::filesystem::path& fileName,
+                               const ReaderOptions& options = {});
 
-        JsonTokenizer(const char* buffer, size_t bufferSize);
+        JsonTokenizer(const char* buffer, size_t bufferSize,
+                      const ReaderOptions& options = {});
 
         ~JsonTokenizer();
 
@@ -35,8 +59,47 @@ namespace Yson
 
         [[nodiscard]] JsonTokenType tokenType() const;
 
-        [[nodiscard]] std::string_view token() const;
-
+        /**
+         * @brief Returns the current token.
+         *
+         * If the token is a string that is longer than the chunk size and
+         * none of it has been read with nextStringPart, the rest of the
+         * string is read into the buffer first.
+         *
+         * @throw YsonReaderException if the token is a string that has
+         *  been read with nextStringPart.
+         */
+        [[nodiscard]] std::string_view token();
+
+        /**
+         * @brief Returns the next part of the current string token.
+         *
+         * The parts are views of the buffer, they are invalidated by the
+         * next call to any of the tokenizer's non-const functions. Line
+         * continuations have been removed, but the parts are otherwise
+         * escaped. Escape sequences, surrogate pairs and UTF-8 characters
+         * are never split between parts. Strings that are shorter than
+         * the chunk size are returned as a single part, and so are other
+         * tokens.
+         *
+         * @return false when the entire token has been returned.
+         */
+        bool nextStringPart(std::string_view& part);
+
+        /**
+         * @brief Returns true if no part of the current token has been
+         *  read with nextStringPart.
+         */
+        [[nodiscard]] bool isAtStartOfToken() const;
+
+        /**
+         * @brief Returns a copy of the current token as it is in the
+         *  buffer, e.g. for error messages.
+         *
+         * Unlike token(), this doesn't read the rest of a string that is
+         * longer than the chunk size, only the part that is in the buffer
+         * is returned. Call token() first to get the entire string.
+         */
         [[nodiscard]] std::string tokenString() const;
 
         [[nodiscard]] const std::string& fileName() const;
@@ -45,19 +108,104 @@ namespace Yson
 
         [[nodiscard]] size_t columnNumber() const;
 
+        /**
+         * @brief Returns the byte offset of the current token from the
+         *  start of the (UTF-8) input.
+         */
+        [[nodiscard]] size_t offset() const;
+
         [[nodiscard]] size_t chunkSize() const;
 
+        /**
+         * @brief Returns the counters from the ReaderOptions, or nullptr.
+         */
+        [[nodiscard]] ReaderStats* stats() const;
+
+        /**
+         * @brief Returns the memory resource from the ReaderOptions, or
+         *  the default resource.
+         */
+        [[nodiscard]] std::pmr::memory_resource* memoryResource() const;
+
         void setChunkSize(size_t value);
+
+        void reset(std::istream& stream,
+                   const char* buffer = nullptr,
+                   size_t bufferSize = 0);
+
+        void reset(const char* buffer, size_t bufferSize);
+
+        void reset();
+
+        [[nodiscard]] bool isPushMode() const;
+
+        void feed(const char* data, size_t size);
+
+        void finishFeed();
+
+        void setCheckpoint();
+
+        void restoreCheckpoint();
+
+        void clearCheckpoint();
     private:
+        struct Checkpoint
+        {
+            size_t tokenStart = 0;
+            size_t tokenEnd = 0;
+            size_t nextToken = 0;
+            size_t lineNumber = 1;
+            size_t columnNumber = 1;
+            JsonTokenType tokenType = JsonTokenType::INVALID_TOKEN;
+            // The token counters in m_Stats, tokens that are read again
+            // after the checkpoint is restored must not be counted twice.
+            size_t objectTokens = 0;
+            size_t arrayTokens = 0;
+            size_t stringTokens = 0;
+            size_t valueTokens = 0;
+        };
+
+        enum class StringState
+        {
+            /// The entire token is in the buffer.
+            COMPLETE,
+            /// The token has been returned by nextStringPart.
+            COMPLETE_READ,
+            /// Only the start of the string is in the buffer.
+            PARTIAL,
+            /// Parts of the string have been returned by nextStringPart.
+            PARTIAL_READ,
+            /// All of the string has been returned by nextStringPart.
+            CONSUMED
+        };
+
+        JsonTokenizer(std::unique_ptr<TextReader> textReader,
+                      const ReaderOptions& options);
+
+        void resetTokenState();
+
+        void assertTokenSizeIsWithinLimit(size_t tokenSize) const;
+
         bool internalNext();
 
+        Result scanToken(bool isEndOfFile);
+
         bool fillBuffer();
 
+        void validateUtf8(bool isEndOfInput);
+
         void removeLineContinuations();
 
+        void completeString();
+
+        void skipRestOfString();
+
+        void countToken() const;
+
         std::unique_ptr<TextReader> m_TextReader;
         std::string m_FileName;
-        std::string m_Buffer;
+        std::pmr::memory_resource* m_MemoryResource;
+        std::pmr::string m_Buffer;
         const char* m_BufferStart = nullptr;
         const char* m_BufferEnd = nullptr;
         const char* m_TokenStart = nullptr;
@@ -67,5 +215,33 @@ namespace Yson
         size_t m_ColumnNumber = 1;
         JsonTokenType m_TokenType = JsonTokenType::INVALID_TOKEN;
         size_t m_ChunkSize;
+        size_t m_MaxChunkSize;
+        size_t m_MaxTokenSize;
+        TextEncoding m_Encoding;
+        Compression m_Compression;
+        Compression m_StreamCompression;
+        bool m_ValidateUtf8;
+        ReaderStats* m_Stats;
+        // The number of bytes that have been removed from the start of
+        // m_Buffer since the start of the input.
+        size_t m_BufferOffset = 0;
+        // The number of bytes at the start of m_Buffer that have been
+        // validated.
+        size_t m_ValidatedSize = 0;
+        TextPushReader* m_PushReader = nullptr;
+        Checkpoint m_Checkpoint;
+        bool m_HasCheckpoint = false;
+        StringState m_StringState = StringState::COMPLETE;
+        char m_StringQuote = '"';
+        // The number of bytes of a partial string that have been
+        // returned by nextStringPart.
+        size_t m_StringPartsSize = 0;
+        bool m_IsCompletingString = false;
+        // How far an incomplete token has been scanned, lets the token be
+        // scanned incrementally as more data arrives, also after a
+        // checkpoint has been restored.
+        TokenScanState m_ScanState;
+        // The offset of the token m_ScanState belongs to.
+        size_t m_ScanStateOffset = SIZE_MAX;
     };
 }
@@ -9,6 +9,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 
 namespace Yson
 {
@@ -27,19 +29,28 @@ namespace Yson
 #endif
     }
     Result nextStringToken(std::string_view string, bool isEndOfFile,
-                           char quotes);
+                           char quotes, TokenScanState& state);
 
     JsonTokenType determineCommentType(std::string_view string);
 
-    Result nextCommentToken(std::string_view string, bool isEndOfFile);
+    Result nextCommentToken(std::string_view string, bool isEndOfFile,
+                            TokenScanState& state);
 
     Result findEndOfNewline(std::string_view string, bool isEndOfFile);
 
-    Result findEndOfValue(std::string_view string, bool isEndOfFile);
+    Result findEndOfValue(std::string_view string, bool isEndOfFile,
+                          size_t start = 0);
 
     Result findEndOfWhitespace(std::string_view string);
 
     Result nextToken(std::string_view string, bool isEndOfFile)
+    {
+        TokenScanState state;
+        return nextToken(string, isEndOfFile, state);
+    }
+
+    Result nextToken(std::string_view string, bool isEndOfFile,
+                     TokenScanState& state)
     {
         if (string.empty())
         {
@@ -70,24 +81,44 @@ namespace Yson
         case ',':
             return {JsonTokenType::COMMA, unwrap(string.begin() + 1)};
         case '"':
-            return nextStringToken(string, isEndOfFile, '"');
+            return nextStringToken(string, isEndOfFile, '"', state);
         case '\'':
-            return nextStringToken(string, isEndOfFile, '\'');
+            return nextStringToken(string, isEndOfFile, '\'', state);
         case '/':
-            return nextCommentToken(string, isEndOfFile);
+            return nextCommentToken(string, isEndOfFile, state);
         default:
-            return findEndOfValue(string, isEndOfFile);
+        {
+            // The value can end with "//" or "/*", the previous character
+            // must be checked again.
+            auto start = state.scannedSize ? state.scannedSize - 1 : 0;
+            auto result = findEndOfValue(string, isEndOfFile, start);
+            state.scannedSize = result.isIncomplete ? string.size() : 0;
+            return result;
+        }
         }
     }
 
-    Result nextStringToken(std::string_view string, bool isEndOfFile, char quotes)
+    Result nextStringToken(std::string_view string, bool isEndOfFile,
+                           char quotes, TokenScanState& state)
     {
         assert(!string.empty());
         assert(string[0] == quotes);
         bool escape = false;
         auto tokenType = JsonTokenType::STRING;
-        for (size_t i = 1, n = string.size(); i < n; ++i)
+        size_t i = 1;
+        if (state.scannedSize != 0)
+        {
+            i = state.scannedSize;
+            tokenType = state.tokenType;
+            state = {};
+        }
+        // Where scanning can be resumed without an escape sequence in
+        // progress.
+        size_t resumeAt = i;
+        for (size_t n = string.size(); i < n; ++i)
         {
+            if (!escape)
+                resumeAt = i;
             auto c = string[i];
             if (c < 0x20 && 0 < c)
             {
@@ -128,14 +159,19 @@ namespace Yson
         if (isEndOfFile)
             return {JsonTokenType::INVALID_TOKEN, unwrap(string.end())};
 
+        // An escaped '\r' at the end can be followed by a '\n' that
+        // hasn't arrived yet, it must be scanned again.
+        state.scannedSize = resumeAt;
+        state.tokenType = tokenType;
         return {tokenType, unwrap(string.end()), true};
     }
 
     Result findEndOfBlockComment(std::string_view string,
-                                 bool isEndOfFile)
+                                 bool isEndOfFile, size_t start)
     {
         bool precededByStar = false;
-        for (auto it = string.begin(); it != string.end(); ++it)
+        for (auto it = string.begin() + std::ptrdiff_t(start);
+             it != string.end(); ++it)
         {
             if (*it == '/' && precededByStar)
                 return {JsonTokenType::BLOCK_COMMENT, unwrap(++it)};
@@ -157,7 +193,8 @@ namespace Yson
         return {JsonTokenType::COMMENT, unwrap(string.end()), !isEndOfFile};
     }
 
-    Result nextCommentToken(std::string_view string, bool isEndOfFile)
+    Result nextCommentToken(std::string_view string, bool isEndOfFile,
+                            TokenScanState& state)
     {
         assert(!string.empty());
         assert(string[0] == '/');
@@ -178,10 +215,13 @@ namespace Yson
             return {JsonTokenType::INVALID_TOKEN, unwrap(string.end()), false};
         }
 
-        if (tokenType == JsonTokenType::COMMENT)
-            return findEndOfLineComment(string.substr(2), isEndOfFile);
-
-        return findEndOfBlockComment(string.substr(), isEndOfFile);
+        auto scannedSize = std::max<size_t>(state.scannedSize, 2);
+        Result result = tokenType == JsonTokenType::COMMENT
+            ? findEndOfLineComment(string.substr(scannedSize), isEndOfFile)
+            // The star before the previous end may belong to "*/".
+            : findEndOfBlockComment(string, isEndOfFile, scannedSize - 1);
+        state.scannedSize = result.isIncomplete ? string.size() : 0;
+        return result;
     }
 
     Result findEndOfNewline(std::string_view string, bool isEndOfFile)
@@ -200,9 +240,11 @@ namespace Yson
         return {JsonTokenType::NEWLINE, unwrap(string.end()), !isEndOfFile};
     }
 
-    Result findEndOfValue(std::string_view string, bool isEndOfFile)
+    Result findEndOfValue(std::string_view string, bool isEndOfFile,
+                          size_t start)
     {
-        for (auto it = string.begin(); it != string.end(); ++it)
+        for (auto it = string.begin() + std::ptrdiff_t(start);
+             it != string.end(); ++it)
         {
             switch (*it)
             {
@@ -307,4 +349,117 @@ namespace Yson
             from = next + 2;
         }
     }
+
+    char* removeLineContinuations(char* from, char* to)
+    {
+        auto next = findLineContinuation(from, to);
+        auto dst = next.first;
+        from = next.second;
+        while (from != to)
+        {
+            next = findLineContinuation(from, to);
+            std::copy(from, next.first, dst);
+            dst += next.first - from;
+            from = next.second;
+        }
+        return dst;
+    }
+
+    namespace
+    {
+        bool isHighSurrogateEscape(std::string_view escape)
+        {
+            return (escape[2] == 'd' || escape[2] == 'D')
+                   && std::string_view("89abAB").find(escape[3])
+                      != std::string_view::npos;
+        }
+
+        /**
+         * @brief Returns the size of the escape sequence at the start of
+         *  @a string, or 0 if @a string ends before the sequence is
+         *  complete.
+         */
+        size_t getEscapeSequenceSize(std::string_view string)
+        {
+            if (string.size() < 2)
+                return 0;
+            switch (string[1])
+            {
+            case '\r':
+                // Can't tell if the line continuation is followed by \n.
+                if (string.size() < 3)
+                    return 0;
+                return string[2] == '\n' ? 3 : 2;
+            case 'u':
+                if (string.size() < 6)
+                    return 0;
+                // Keep surrogate pairs together, they are unescaped
+                // as a single character.
+                if (!isHighSurrogateEscape(string))
+                    return 6;
+                if (string.size() < 12)
+                    return 0;
+                return string[6] == '\\' && string[7] == 'u' ? 12 : 6;
+            default:
+                return 2;
+            }
+        }
+
+        /**
+         * @brief Returns the size of @a string without the incomplete
+         *  UTF-8 character at its end, if there is one.
+         */
+        size_t getSizeOfCompleteCharacters(std::string_view string)
+        {
+            const auto n = string.size();
+            for (size_t i = 1; i <= std::min<size_t>(n, 4); ++i)
+            {
+                auto c = uint8_t(string[n - i]);
+                if ((c & 0xC0u) == 0x80u)
+                    continue;
+                size_t charSize = 1;
+                if ((c & 0xE0u) == 0xC0u)
+                    charSize = 2;
+                else if ((c & 0xF0u) == 0xE0u)
+                    charSize = 3;
+                else if ((c & 0xF8u) == 0xF0u)
+                    charSize = 4;
+                return charSize > i ? n - i : n;
+            }
+            return n;
+        }
+    }
+
+    Result findEndOfStringPart(std::string_view string, char quotes)
+    {
+        auto tokenType = JsonTokenType::STRING;
+        size_t i = 0;
+        const auto n = string.size();
+        while (i < n)
+        {
+            auto c = string[i];
+            if (c == quotes)
+                return {tokenType, string.data() + i};
+            if (c < 0x20 && 0 < c)
+                return {JsonTokenType::INVALID_TOKEN, string.data() + i};
+            if (c != '\\')
+            {
+                ++i;
+                continue;
+            }
+
+            auto size = getEscapeSequenceSize(string.substr(i));
+            if (size == 0)
+                return {tokenType, string.data() + i, true};
+            auto e = string[i + 1];
+            if (e == '\n' || e == '\r')
+                tokenType = JsonTokenType::INTERNAL_MULTILINE_STRING;
+            else if (e < 0x20 && 0 < e)
+                return {JsonTokenType::INVALID_TOKEN, string.data() + i + 1};
+            i += size;
+        }
+        return {tokenType,
+                string.data() + getSizeOfCompleteCharacters(string),
+                true};
+    }
 }
@@ -32,13 +32,57 @@ namespace Yson
         bool isIncomplete;
     };
 
+    /**
+     * @brief Records how far nextToken got in a token that is incomplete.
+     */
+    struct TokenScanState
+    {
+        /// The number of bytes at the start of the token that don't have
+        /// to be scanned again. 0 if the token hasn't been scanned.
+        size_t scannedSize = 0;
+        /// The token type determined from the scanned bytes.
+        JsonTokenType tokenType = JsonTokenType::INCOMPLETE_TOKEN;
+    };
+
     Result nextToken(std::string_view string,
                      bool isEndOfFile = false);
 
+    /**
+     * @brief Like nextToken, but continues where the previous call for
+     *  the same token stopped if that call found it to be incomplete.
+     *
+     * @a string must start at the same token as in the previous call,
+     * with more data added at the end. @a state is updated when the token
+     * is incomplete and cleared when it is complete.
+     */
+    Result nextToken(std::string_view string, bool isEndOfFile,
+                     TokenScanState& state);
+
     std::pair<size_t, size_t> countLinesAndColumns(std::string_view string);
 
     void addLinesAndColumns(size_t& lineNumber, size_t& columnNumber,
                             std::pair<size_t, size_t> addend);
 
     std::pair<char*, char*> findLineContinuation(char* from, char* to);
+
+    /**
+     * @brief Removes the line continuations in [from, to) and returns the
+     *  new end of the string.
+     */
+    char* removeLineContinuations(char* from, char* to);
+
+    /**
+     * @brief Finds the end of the longest part of a string token's content
+     *  that can be processed without the characters that follow it.
+     *
+     * @a string starts right after the opening quote or at the end of the
+     * previous part. If the closing quote is found, endOfToken points to
+     * it and isIncomplete is false. Otherwise the part doesn't end inside
+     * an escape sequence, a surrogate pair, a line continuation or a UTF-8
+     * character. The token type is INTERNAL_MULTILINE_STRING if the part
+     * contains line continuations, and INVALID_TOKEN if it contains a
+     * control character, in which case endOfToken points to the control
+     * character.
+     */
+    Result findEndOfStringPart(std::string_view string, char quotes);
 }
@@ -6,19 +6,75 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Yson/JsonValueItem.hpp"
+#include "Yson/Common/AssignInteger.hpp"
 #include "Yson/Common/Base64.hpp"
 #include "Yson/Common/Escape.hpp"
 #include "Yson/Common/GetValueType.hpp"
 #include "Yson/Common/ParseFloatingPoint.hpp"
 #include "Yson/Common/ParseInteger.hpp"
 #include "Yson/JsonReader/JsonTokenType.hpp"
+#include "Yson/YsonException.hpp"
 
 namespace Yson
 {
+    namespace
+    {
+        [[noreturn]]
+        void throwInvalidEscapeSequence(std::string_view str)
+        {
+            // unescape throws the exception that explains what is wrong.
+            static_cast<void>(unescape(str));
+            YSON_THROW("Invalid escape sequence.");
+        }
+    }
+
     JsonValueItem::JsonValueItem(std::string value, JsonTokenType type)
+        : JsonValueItem(std::pmr::string(value), type)
+    {}
+
+    JsonValueItem::JsonValueItem(std::pmr::string value, JsonTokenType type)
         : m_Value(std::move(value)),
           m_Type(type)
-    {}
+    {
+        if (m_Type == JsonTokenType::STRING)
+        {
+            // Strings with invalid escape sequences are kept as they are,
+            // so that only reading them fails, not reading the document.
+            if (findInvalidEscapeSequence(m_Value) != std::string_view::npos)
+                m_HasInvalidEscapes = true;
+            else if (hasEscapedCharacters(m_Value))
+                m_Value.assign(unescape(m_Value));
+            m_ValueType = ValueType::STRING;
+            return;
+        }
+
+        if (m_Type != JsonTokenType::VALUE)
+            return;
+
+        m_ValueType = getValueType(m_Value);
+        if (m_ValueType == ValueType::INTEGER)
+        {
+            if (parse(m_Value, m_Int64, true))
+            {
+                m_NumberType = NumberType::INT64;
+                int64_t decimal;
+                m_IsDecimalInteger = parse(m_Value, decimal, false)
+                                     && decimal == m_Int64;
+            }
+            else if (parse(m_Value, m_UInt64, true))
+            {
+                m_NumberType = NumberType::UINT64;
+                uint64_t decimal;
+                m_IsDecimalInteger = parse(m_Value, decimal, false)
+                                     && decimal == m_UInt64;
+            }
+        }
+        else if (m_ValueType == ValueType::FLOAT)
+        {
+            if (parse(m_Value, m_Double))
+                m_NumberType = NumberType::DOUBLE;
+        }
+    }
 
     ValueType JsonValueItem::valueType() const
     {
@@ -27,16 +83,10 @@ namespace Yson
 
     ValueType JsonValueItem::valueType(bool analyzeStrings) const
     {
-        if (m_Type == JsonTokenType::VALUE
-            || (analyzeStrings && m_Type == JsonTokenType::STRING))
-        {
+        if (analyzeStrings && m_Type == JsonTokenType::STRING)
             return getValueType(m_Value);
-        }
 
-        if (m_Type == JsonTokenType::STRING)
-            return ValueType::STRING;
-
-        return ValueType::INVALID;
+        return m_ValueType;
     }
 
     bool JsonValueItem::isNull() const
@@ -63,88 +113,78 @@ namespace Yson
 
     bool JsonValueItem::get(int8_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(int16_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(int32_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(int64_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(uint8_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(uint16_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(uint32_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(uint64_t& value) const
     {
-        return parse(m_Value, value, true);
+        return getInteger(value);
     }
 
     bool JsonValueItem::get(float& value) const
     {
-        return parse(m_Value, value);
+        return getFloatingPoint(value);
     }
 
     bool JsonValueItem::get(double& value) const
     {
-        return parse(m_Value, value);
+        return getFloatingPoint(value);
     }
 
     bool JsonValueItem::get(long double& value) const
     {
-        return parse(m_Value, value);
+        return getFloatingPoint(value);
     }
 
     bool JsonValueItem::get(char& value) const
     {
         if (m_Type == JsonTokenType::VALUE)
-            return parse(m_Value, value, true);
+            return getInteger(value);
         if (m_Type != JsonTokenType::STRING)
             return false;
-        if (m_Value.size() == 1)
-        {
-            value = m_Value[0];
-            return true;
-        }
-        if (hasEscapedCharacters(m_Value))
-        {
-            auto str = unescape(m_Value);
-            if (str.size() == 1)
-            {
-                value = str[0];
-                return true;
-            }
-        }
-        return false;
+        if (m_HasInvalidEscapes)
+            throwInvalidEscapeSequence(m_Value);
+        if (m_Value.size() != 1)
+            return false;
+        value = m_Value[0];
+        return true;
     }
 
     bool JsonValueItem::get(std::string& value) const
     {
-        if (hasEscapedCharacters(m_Value))
-            value = unescape(m_Value);
-        else
-            value = m_Value;
+        if (m_HasInvalidEscapes)
+            throwInvalidEscapeSequence(m_Value);
+        value = m_Value;
         return true;
     }
 
@@ -162,4 +202,42 @@ namespace Yson
     {
         return fromBase64(m_Value, static_cast<char*>(buffer), size);
     }
+
+    template <typename T>
+    bool JsonValueItem::getInteger(T& value) const
+    {
+        switch (m_NumberType)
+        {
+        case NumberType::INT64:
+            return assignInteger(value, m_Int64);
+        case NumberType::UINT64:
+            return assignInteger(value, m_UInt64);
+        default:
+            return parse(m_Value, value, true);
+        }
+    }
+
+    template <typename T>
+    bool JsonValueItem::getFloatingPoint(T& value) const
+    {
+        switch (m_NumberType)
+        {
+        case NumberType::INT64:
+            if (!m_IsDecimalInteger)
+                break;
+            value = T(m_Int64);
+            return true;
+        case NumberType::UINT64:
+            if (!m_IsDecimalInteger)
+                break;
+            value = T(m_UInt64);
+            return true;
+        case NumberType::DOUBLE:
+            value = T(m_Double);
+            return true;
+        default:
+            break;
+        }
+        return parse(m_Value, value);
+    }
 }
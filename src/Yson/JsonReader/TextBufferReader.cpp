@@ -19,36 +19,32 @@ namespace Yson
 
     TextBufferReader::TextBufferReader(const char* buffer, size_t size,
                                        Yconvert::Encoding sourceEncoding)
-            : m_Buffer(buffer),
-              m_Size(size),
-              m_Offset()
+            : m_SourceEncoding(sourceEncoding),
+              m_Encoding(Yconvert::Encoding::UNKNOWN)
     {
-        while (m_Size != 0 && m_Buffer[m_Size - 1] == 0)
-            --m_Size;
-        if (sourceEncoding != Yconvert::Encoding::UNKNOWN)
-        {
-            m_Converter = std::make_unique<Yconvert::Converter>(
-                    sourceEncoding, Yconvert::Encoding::UTF_8);
-        }
+        reset(buffer, size);
     }
 
-    bool TextBufferReader::read(std::string& destination, size_t bytes)
+    TextBufferReader::~TextBufferReader() = default;
+
+    bool TextBufferReader::read(std::pmr::string& destination, size_t bytes)
     {
-        bytes = std::min(m_Size - m_Offset, bytes);
-        if (bytes == 0)
-            return false;
-        if (!m_Converter)
+        if (m_Encoding == Yconvert::Encoding::UNKNOWN)
         {
-            auto encoding = Yconvert::determine_encoding(
+            if (m_Size == 0)
+                return false;
+            auto [encoding, offset] = Yconvert::determine_encoding(
                 m_Buffer,
                 std::min<size_t>(m_Size, 256));
-            m_Offset = encoding.second;
-            m_Converter = std::make_unique<Yconvert::Converter>(
-                encoding.first,
-                Yconvert::Encoding::UTF_8);
+            m_Offset = offset;
+            setEncoding(encoding);
         }
 
-        if (m_Converter->source_encoding() == Yconvert::Encoding::UTF_8)
+        bytes = std::min(m_Size - m_Offset, bytes);
+        if (bytes == 0)
+            return false;
+
+        if (m_Encoding == Yconvert::Encoding::UTF_8)
         {
             if (m_Offset + bytes != m_Size)
                 bytes = sizeWithoutIncompleteFinalCharacter(m_Buffer + m_Offset, bytes);
@@ -58,12 +54,53 @@ namespace Yson
         }
         else
         {
-            bytes = m_Converter->convert(m_Buffer + m_Offset, bytes, destination);
+            bytes = convert(*m_Converter, m_Buffer + m_Offset, bytes,
+                            destination);
         }
         m_Offset += bytes;
         return bytes != 0;
     }
 
+    void TextBufferReader::reset(const char* buffer, size_t size)
+    {
+        m_Buffer = buffer;
+        m_Size = m_UntrimmedSize = size;
+        m_Offset = 0;
+        while (m_Size != 0 && m_Buffer[m_Size - 1] == 0)
+            --m_Size;
+        m_Encoding = Yconvert::Encoding::UNKNOWN;
+        if (m_SourceEncoding != Yconvert::Encoding::UNKNOWN)
+            setEncoding(m_SourceEncoding);
+    }
+
+    void TextBufferReader::setEncoding(Yconvert::Encoding encoding)
+    {
+        m_Encoding = encoding;
+
+        // Trimming the trailing NULs may have removed parts of the final
+        // character in UTF-16 and UTF-32 text, put them back.
+        size_t unitSize = 1;
+        if (encoding == Yconvert::Encoding::UTF_16_LE
+            || encoding == Yconvert::Encoding::UTF_16_BE)
+        {
+            unitSize = 2;
+        }
+        else if (encoding == Yconvert::Encoding::UTF_32_LE
+                 || encoding == Yconvert::Encoding::UTF_32_BE)
+        {
+            unitSize = 4;
+        }
+        if (auto rem = (m_Size - m_Offset) % unitSize; rem != 0)
+            m_Size = std::min(m_Size + unitSize - rem, m_UntrimmedSize);
+
+        if (encoding != Yconvert::Encoding::UTF_8
+            && (!m_Converter || m_Converter->source_encoding() != encoding))
+        {
+            m_Converter = std::make_unique<Yconvert::Converter>(
+                encoding, Yconvert::Encoding::UTF_8);
+        }
+    }
+
     namespace
     {
         size_t sizeWithoutIncompleteFinalCharacter(const char* str, size_t size)
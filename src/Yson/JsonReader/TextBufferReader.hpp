@@ -23,11 +23,21 @@ namespace Yson
         TextBufferReader(const char* buffer, size_t size,
                          Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN);
 
-        bool read(std::string& destination, size_t bytes) override;
+        ~TextBufferReader() override;
+
+        bool read(std::pmr::string& destination, size_t bytes) override;
+
+        void reset(const char* buffer, size_t size);
     private:
+        void setEncoding(Yconvert::Encoding encoding);
+
         const char* m_Buffer;
         size_t m_Size;
+        size_t m_UntrimmedSize;
         size_t m_Offset;
+        Yconvert::Encoding m_SourceEncoding;
+        Yconvert::Encoding m_Encoding;
+        // Only used when the encoding isn't UTF-8.
         std::unique_ptr<Yconvert::Converter> m_Converter;
     };
 }
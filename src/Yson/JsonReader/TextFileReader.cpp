@@ -7,16 +7,24 @@
 //****************************************************************************
 #include "TextFileReader.hpp"
 #include "Yson/YsonException.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
 
 namespace Yson
 {
     TextFileReader::TextFileReader(
             const std::filesystem::path& fileName,
-            Yconvert::Encoding sourceEncoding)
-        : m_FileStream(fileName, std::ios_base::binary)
+            Yconvert::Encoding sourceEncoding,
+            std::pmr::memory_resource* memoryResource,
+            Compression compression)
+        : TextStreamReader(memoryResource),
+          m_FileStream(fileName, std::ios_base::binary)
     {
         if (!m_FileStream)
             YSON_THROW("Unable to open file: " + fileName.string());
-        init(m_FileStream, sourceEncoding);
+        m_DecompressingStream = openDecompressingStream(m_FileStream,
+                                                        nullptr, 0,
+                                                        compression);
+        init(m_DecompressingStream ? *m_DecompressingStream : m_FileStream,
+             sourceEncoding);
     }
 }
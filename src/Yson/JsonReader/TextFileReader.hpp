@@ -9,6 +9,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include "Yson/Compression.hpp"
 #include "TextStreamReader.hpp"
 
 namespace Yson
@@ -18,8 +19,12 @@ namespace Yson
     public:
         explicit TextFileReader(
             const std::filesystem::path& fileName,
-            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN);
+            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN,
+            std::pmr::memory_resource* memoryResource
+                = std::pmr::get_default_resource(),
+            Compression compression = Compression::NONE);
     private:
         std::ifstream m_FileStream;
+        std::unique_ptr<std::istream> m_DecompressingStream;
     };
 }
@@ -0,0 +1,100 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TextPushReader.hpp"
+
+#include <algorithm>
+#include <Yconvert/Converter.hpp>
+#include "Yson/YsonException.hpp"
+
+namespace Yson
+{
+    TextPushReader::TextPushReader(Yconvert::Encoding sourceEncoding,
+                                   std::pmr::memory_resource* memoryResource)
+        : m_Pending(memoryResource)
+    {
+        if (sourceEncoding != Yconvert::Encoding::UNKNOWN)
+        {
+            m_Converter = std::make_unique<Yconvert::Converter>(
+                    sourceEncoding, Yconvert::Encoding::UTF_8);
+            m_HasFixedEncoding = true;
+            m_DetectEncoding = false;
+        }
+    }
+
+    TextPushReader::~TextPushReader() = default;
+
+    bool TextPushReader::read(std::pmr::string& destination, size_t bytes)
+    {
+        auto available = m_Pending.size() - m_Offset;
+        if (available == 0)
+            return false;
+
+        if (m_DetectEncoding)
+        {
+            // Wait until there's enough data to recognize UTF-32 before
+            // determining the encoding.
+            if (available < 4 && !m_IsFinished)
+                return false;
+            auto [encoding, offset] = Yconvert::determine_encoding(
+                    m_Pending.data() + m_Offset,
+                    std::min<size_t>(available, 256));
+            m_Offset += offset;
+            available -= offset;
+            if (!m_Converter || m_Converter->source_encoding() != encoding)
+            {
+                m_Converter = std::make_unique<Yconvert::Converter>(
+                        encoding, Yconvert::Encoding::UTF_8);
+            }
+            m_DetectEncoding = false;
+        }
+
+        auto convertedBytes = convert(
+                *m_Converter,
+                m_Pending.data() + m_Offset,
+                std::min(available, bytes),
+                destination);
+        m_Offset += convertedBytes;
+        if (m_Offset == m_Pending.size())
+        {
+            m_Pending.clear();
+            m_Offset = 0;
+        }
+        return convertedBytes != 0;
+    }
+
+    void TextPushReader::feed(const char* data, size_t size)
+    {
+        if (m_IsFinished)
+            YSON_THROW("Can't feed more data after the end of the input.");
+        if (m_Offset != 0)
+        {
+            m_Pending.erase(m_Pending.begin(),
+                            m_Pending.begin() + ptrdiff_t(m_Offset));
+            m_Offset = 0;
+        }
+        m_Pending.insert(m_Pending.end(), data, data + size);
+    }
+
+    void TextPushReader::finish()
+    {
+        m_IsFinished = true;
+    }
+
+    bool TextPushReader::isFinished() const
+    {
+        return m_IsFinished;
+    }
+
+    void TextPushReader::reset()
+    {
+        m_Pending.clear();
+        m_Offset = 0;
+        m_IsFinished = false;
+        m_DetectEncoding = !m_HasFixedEncoding;
+    }
+}
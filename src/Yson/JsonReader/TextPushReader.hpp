@@ -0,0 +1,56 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <memory>
+#include <memory_resource>
+#include <vector>
+#include <Yconvert/Encoding.hpp>
+#include "TextReader.hpp"
+
+namespace Yconvert
+{
+    class Converter;
+}
+
+namespace Yson
+{
+    /**
+     * @brief A TextReader that reads data the application pushes to it
+     *  with feed().
+     *
+     * read() returns false when all the data that has been fed so far has
+     * been read, use isFinished() to tell if that is the end of the input.
+     */
+    class TextPushReader : public TextReader
+    {
+    public:
+        explicit TextPushReader(
+            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN,
+            std::pmr::memory_resource* memoryResource
+                = std::pmr::get_default_resource());
+
+        ~TextPushReader() override;
+
+        bool read(std::pmr::string& destination, size_t bytes) override;
+
+        void feed(const char* data, size_t size);
+
+        void finish();
+
+        [[nodiscard]] bool isFinished() const;
+
+        void reset();
+    private:
+        std::pmr::vector<char> m_Pending;
+        size_t m_Offset = 0;
+        bool m_IsFinished = false;
+        bool m_HasFixedEncoding = false;
+        bool m_DetectEncoding = true;
+        std::unique_ptr<Yconvert::Converter> m_Converter;
+    };
+}
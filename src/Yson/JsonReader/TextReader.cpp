@@ -0,0 +1,38 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "TextReader.hpp"
+
+#include <chrono>
+#include <Yconvert/Converter.hpp>
+#include "Yson/ReaderStats.hpp"
+
+namespace Yson
+{
+    size_t TextReader::convert(Yconvert::Converter& converter,
+                               const char* source, size_t sourceSize,
+                               std::pmr::string& destination)
+    {
+        std::chrono::steady_clock::time_point start;
+        if (m_Stats)
+            start = std::chrono::steady_clock::now();
+
+        // Converting to a std::string would allocate with the global
+        // allocator, so the text is converted directly into destination.
+        // UTF-16 grows the most, two bytes become at most three.
+        auto offset = destination.size();
+        destination.resize(offset + sourceSize + sourceSize / 2);
+        auto [sourceUsed, destinationUsed] = converter.convert(
+            source, sourceSize,
+            destination.data() + offset, destination.size() - offset);
+        destination.resize(offset + destinationUsed);
+
+        if (m_Stats)
+            m_Stats->conversionTime += std::chrono::steady_clock::now() - start;
+        return sourceUsed;
+    }
+}
@@ -6,15 +6,33 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
+#include <memory_resource>
 #include <string>
 
+namespace Yconvert
+{
+    class Converter;
+}
+
 namespace Yson
 {
+    struct ReaderStats;
+
     class TextReader
     {
     public:
         virtual ~TextReader() = default;
-        virtual bool read(std::string& destination, size_t bytes) = 0;
+        virtual bool read(std::pmr::string& destination, size_t bytes) = 0;
+
+        void setStats(ReaderStats* stats)
+        {
+            m_Stats = stats;
+        }
+    protected:
+        size_t convert(Yconvert::Converter& converter,
+                       const char* source, size_t sourceSize,
+                       std::pmr::string& destination);
+    private:
+        ReaderStats* m_Stats = nullptr;
     };
 }
-
@@ -11,35 +11,47 @@
 #include <istream>
 #include <memory>
 #include <Yconvert/Converter.hpp>
-#include "Yson/Common/DefaultBufferSize.hpp"
 
 namespace Yson
 {
-    TextStreamReader::TextStreamReader()
-        : m_Stream()
-    {
-        m_Buffer.reserve(getDefaultBufferSize());
-    }
+    TextStreamReader::TextStreamReader(
+            std::pmr::memory_resource* memoryResource)
+        : m_Stream(),
+          m_Buffer(memoryResource)
+    {}
 
     TextStreamReader::TextStreamReader(std::istream& stream,
                                        const char* buffer,
                                        size_t bufferSize,
-                                       Yconvert::Encoding sourceEncoding)
-        : m_Stream(&stream)
+                                       Yconvert::Encoding sourceEncoding,
+                                       std::pmr::memory_resource* memoryResource)
+        : m_Stream(&stream),
+          m_Buffer(memoryResource)
     {
         if (sourceEncoding != Yconvert::Encoding::UNKNOWN)
         {
             m_Converter = std::make_unique<Yconvert::Converter>(
                     sourceEncoding, Yconvert::Encoding::UTF_8);
+            m_HasFixedEncoding = true;
+            m_DetectEncoding = false;
         }
-        m_Buffer.reserve(std::max(getDefaultBufferSize(), bufferSize));
+        // The buffer grows to the tokenizer's chunk size on the first read.
         if (buffer && bufferSize)
             m_Buffer.insert(m_Buffer.end(), buffer, buffer + bufferSize);
     }
 
+    TextStreamReader::TextStreamReader(std::unique_ptr<std::istream> stream,
+                                       Yconvert::Encoding sourceEncoding,
+                                       std::pmr::memory_resource* memoryResource)
+        : TextStreamReader(*stream, nullptr, 0, sourceEncoding,
+                           memoryResource)
+    {
+        m_OwnedStream = std::move(stream);
+    }
+
     TextStreamReader::~TextStreamReader() = default;
 
-    bool TextStreamReader::read(std::string& destination, size_t bytes)
+    bool TextStreamReader::read(std::pmr::string& destination, size_t bytes)
     {
         auto initialBufferSize = m_Buffer.size();
         m_Buffer.resize(initialBufferSize + bytes);
@@ -55,19 +67,23 @@ namespace Yson
 
         const char* bufferStart = m_Buffer.data();
         auto bufferSize = m_Buffer.size();
-        if (!m_Converter)
+        if (m_DetectEncoding)
         {
             auto [encoding, offset] = Yconvert::determine_encoding(
                     m_Buffer.data(),
                     std::min<size_t>(bufferSize, 256));
             bufferStart += offset;
             bufferSize -= offset;
-            m_Converter = std::make_unique<Yconvert::Converter>(
-                    encoding, Yconvert::Encoding::UTF_8);
+            if (!m_Converter || m_Converter->source_encoding() != encoding)
+            {
+                m_Converter = std::make_unique<Yconvert::Converter>(
+                        encoding, Yconvert::Encoding::UTF_8);
+            }
+            m_DetectEncoding = false;
         }
 
-        auto convertedBytes = m_Converter->convert(
-                bufferStart, bufferSize, destination);
+        auto convertedBytes = convert(
+                *m_Converter, bufferStart, bufferSize, destination);
         if (convertedBytes == bufferSize)
         {
             m_Buffer.clear();
@@ -81,6 +97,20 @@ namespace Yson
         return true;
     }
 
+    void TextStreamReader::reset(std::istream& stream,
+                                 const char* buffer,
+                                 size_t bufferSize)
+    {
+        // Keeps the buffer's capacity, and the converter unless
+        // the next stream turns out to have a different encoding.
+        m_OwnedStream.reset();
+        m_Stream = &stream;
+        m_Buffer.clear();
+        if (buffer && bufferSize)
+            m_Buffer.insert(m_Buffer.end(), buffer, buffer + bufferSize);
+        m_DetectEncoding = !m_HasFixedEncoding;
+    }
+
     void TextStreamReader::init(std::istream& stream,
                                 Yconvert::Encoding sourceEncoding)
     {
@@ -89,10 +119,14 @@ namespace Yson
         {
             m_Converter = std::make_unique<Yconvert::Converter>(
                     sourceEncoding, Yconvert::Encoding::UTF_8);
+            m_HasFixedEncoding = true;
+            m_DetectEncoding = false;
         }
-        else if (m_Converter)
+        else
         {
             m_Converter.reset();
+            m_HasFixedEncoding = false;
+            m_DetectEncoding = true;
         }
     }
 }
@@ -7,6 +7,7 @@
 //****************************************************************************
 #pragma once
 #include <memory>
+#include <memory_resource>
 #include <vector>
 #include <Yconvert/Encoding.hpp>
 #include "TextReader.hpp"
@@ -25,20 +26,39 @@ namespace Yson
             std::istream& stream,
             const char* buffer = nullptr,
             size_t bufferSize = 0,
-            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN);
+            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN,
+            std::pmr::memory_resource* memoryResource
+                = std::pmr::get_default_resource());
+
+        /**
+         * @brief Creates a reader that owns its stream, e.g. a stream that
+         *  decompresses another stream.
+         */
+        explicit TextStreamReader(
+            std::unique_ptr<std::istream> stream,
+            Yconvert::Encoding sourceEncoding = Yconvert::Encoding::UNKNOWN,
+            std::pmr::memory_resource* memoryResource
+                = std::pmr::get_default_resource());
 
         ~TextStreamReader() override;
 
-        bool read(std::string& destination, size_t bytes) override;
+        bool read(std::pmr::string& destination, size_t bytes) override;
+
+        void reset(std::istream& stream,
+                   const char* buffer = nullptr,
+                   size_t bufferSize = 0);
 
     protected:
-        TextStreamReader();
+        explicit TextStreamReader(std::pmr::memory_resource* memoryResource);
 
         void init(std::istream& stream, Yconvert::Encoding sourceEncoding);
 
     private:
+        std::unique_ptr<std::istream> m_OwnedStream;
         std::istream* m_Stream;
         std::unique_ptr<Yconvert::Converter> m_Converter;
-        std::vector<char> m_Buffer;
+        std::pmr::vector<char> m_Buffer;
+        bool m_HasFixedEncoding = false;
+        bool m_DetectEncoding = true;
     };
 }
@@ -21,7 +21,8 @@
                                       YSON_DEBUG_LOCATION(), \
                                       (tokenizer).fileName(), \
                                       (tokenizer).lineNumber(), \
-                                      (tokenizer).columnNumber())
+                                      (tokenizer).columnNumber(), \
+                                      (tokenizer).offset())
 
 #define JSON_READER_UNEXPECTED_TOKEN(tokenizer) \
     JSON_READER_THROW( \
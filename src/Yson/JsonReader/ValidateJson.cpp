@@ -0,0 +1,166 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Validate.hpp"
+
+#include "Yson/Common/Escape.hpp"
+#include "Yson/Common/GetValueType.hpp"
+#include "Yson/Common/IsJavaScriptIdentifier.hpp"
+#include "Yson/Common/ScopeStack.hpp"
+#include "JsonScopeReaderUtilities.hpp"
+#include "JsonTokenizer.hpp"
+#include "ThrowJsonReaderException.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        void checkToken(JsonTokenizer& tokenizer, bool isKey)
+        {
+            if (tokenizer.tokenType() == JsonTokenType::VALUE)
+            {
+                auto token = tokenizer.token();
+                if (getValueType(token) == ValueType::INVALID
+                    && !(isKey && isJavaScriptIdentifier(token)))
+                {
+                    JSON_READER_THROW("Invalid value: '" + std::string(token)
+                                      + "'.", tokenizer);
+                }
+            }
+
+            // Strings that are longer than the chunk size are checked in
+            // parts rather than read into memory in their entirety.
+            auto offset = tokenizer.offset();
+            std::string_view part;
+            while (tokenizer.nextStringPart(part))
+            {
+                auto pos = findInvalidEscapeSequence(part);
+                if (pos != std::string_view::npos)
+                {
+                    throw YsonReaderException("Invalid escape sequence.",
+                                              YSON_DEBUG_LOCATION(),
+                                              tokenizer.fileName(),
+                                              tokenizer.lineNumber(),
+                                              tokenizer.columnNumber(),
+                                              offset + pos);
+                }
+                offset = tokenizer.offset();
+            }
+        }
+
+        /**
+         * @brief Checks the value or object key the tokenizer is at.
+         * @return true if the value is an array or object, which has been
+         *  pushed onto @a scopes.
+         */
+        bool enterOrCheckValue(JsonTokenizer& tokenizer, ScopeStack& scopes)
+        {
+            switch (tokenizer.tokenType())
+            {
+            case JsonTokenType::START_ARRAY:
+                scopes.push(false);
+                return true;
+            case JsonTokenType::START_OBJECT:
+                scopes.push(true);
+                return true;
+            default:
+                checkToken(tokenizer, false);
+                return false;
+            }
+        }
+
+        void validateValue(JsonTokenizer& tokenizer, ScopeStack& scopes)
+        {
+            // Follows the same grammar as JsonArrayReader and
+            // JsonObjectReader, but without keeping track of reader states.
+            auto atStart = enterOrCheckValue(tokenizer, scopes);
+            while (!scopes.empty())
+            {
+                auto endToken = scopes.isObject() ? JsonTokenType::END_OBJECT
+                                                  : JsonTokenType::END_ARRAY;
+                if (!atStart && !readComma(tokenizer, endToken))
+                {
+                    scopes.pop();
+                    continue;
+                }
+
+                bool hasEntry;
+                if (endToken == JsonTokenType::END_OBJECT)
+                {
+                    hasEntry = readKey(tokenizer, endToken);
+                    if (hasEntry)
+                    {
+                        checkToken(tokenizer, true);
+                        readColon(tokenizer);
+                        readStartOfValue(tokenizer);
+                    }
+                }
+                else
+                {
+                    hasEntry = readStartOfValue(tokenizer, endToken);
+                }
+
+                if (hasEntry)
+                {
+                    atStart = enterOrCheckValue(tokenizer, scopes);
+                }
+                else
+                {
+                    scopes.pop();
+                    atStart = false;
+                }
+            }
+        }
+
+        ValidationResult validate(JsonTokenizer& tokenizer)
+        {
+            try
+            {
+                ScopeStack scopes;
+                while (tokenizer.next())
+                {
+                    if (!isValueToken(tokenizer.tokenType()))
+                        JSON_READER_UNEXPECTED_TOKEN(tokenizer);
+                    validateValue(tokenizer, scopes);
+                }
+                if (tokenizer.tokenType() == JsonTokenType::INVALID_TOKEN)
+                    JSON_READER_UNEXPECTED_TOKEN(tokenizer);
+                return {};
+            }
+            catch (YsonReaderException& ex)
+            {
+                return {false, ex.offset, ex.line, ex.column, ex.message};
+            }
+            catch (YsonException& ex)
+            {
+                return {false, tokenizer.offset(), tokenizer.lineNumber(),
+                        tokenizer.columnNumber(), ex.message};
+            }
+        }
+    }
+
+    ValidationResult validateJson(const char* buffer, size_t bufferSize,
+                                  const ReaderOptions& options)
+    {
+        JsonTokenizer tokenizer(buffer, bufferSize, options);
+        return validate(tokenizer);
+    }
+
+    ValidationResult validateJson(std::istream& stream,
+                                  const ReaderOptions& options)
+    {
+        JsonTokenizer tokenizer(stream, nullptr, 0, options);
+        return validate(tokenizer);
+    }
+
+    ValidationResult validateJson(const std::filesystem::path& fileName,
+                                  const ReaderOptions& options)
+    {
+        JsonTokenizer tokenizer(fileName, options);
+        return validate(tokenizer);
+    }
+}
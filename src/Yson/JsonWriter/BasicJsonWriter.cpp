@@ -0,0 +1,57 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/BasicJsonWriter.hpp"
+
+#include <cstdio>
+#include <Yconvert/Convert.hpp>
+#include "Yson/Common/Base64.hpp"
+#include "Yson/Common/Escape.hpp"
+#include "Yson/Common/IsJavaScriptIdentifier.hpp"
+
+namespace Yson::detail
+{
+    void appendEscaped(std::pmr::string& buffer, std::string_view str,
+                       bool escapeNonAscii)
+    {
+        if (!hasUnescapedCharacters(str, escapeNonAscii))
+            buffer.append(str);
+        else
+            buffer.append(escape(str, escapeNonAscii));
+    }
+
+    void appendFloat(std::pmr::string& buffer, double value, int precision)
+    {
+        char text[32];
+#ifdef YSON_USE_TO_CHARS_FOR_FLOATS
+        auto result = std::to_chars(std::begin(text), std::end(text), value,
+                                    std::chars_format::general, precision);
+        buffer.append(text, result.ptr);
+#else
+        auto size = snprintf(text, sizeof(text), "%.*g", precision, value);
+        buffer.append(text, size_t(size));
+#endif
+    }
+
+    bool isUnquotedKey(std::string_view key)
+    {
+        return isJavaScriptIdentifier(key);
+    }
+
+    std::string toUtf8(std::wstring_view str)
+    {
+        Yconvert::Converter converter(Yconvert::Encoding::WSTRING_NATIVE,
+                                      Yconvert::Encoding::UTF_8);
+        converter.set_error_policy(Yconvert::ErrorPolicy::REPLACE);
+        return Yconvert::convert_to<std::string>(str, converter);
+    }
+
+    std::string toBase64String(const void* data, size_t size)
+    {
+        return toBase64(data, size);
+    }
+}
@@ -11,13 +11,20 @@
 #include <array>
 #include <charconv>
 #include <cmath>
+#include <deque>
 #include <fstream>
 #include <stack>
 #include <Yconvert/Convert.hpp>
+#include "Yson/JsonItem.hpp"
 #include "Yson/YsonException.hpp"
 #include "Yson/Common/Base64.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
 #include "Yson/Common/Escape.hpp"
+#include "Yson/Common/FormatInteger.hpp"
 #include "Yson/Common/IsJavaScriptIdentifier.hpp"
+#include "Yson/Common/MemoryResource.hpp"
+#include "Yson/JsonReader/JsonTokenType.hpp"
+#include "Yson/UBJsonReader/UBJsonTokenType.hpp"
 #include "JsonWriterUtilities.hpp"
 
 namespace Yson
@@ -25,7 +32,23 @@ namespace Yson
     namespace
     {
         constexpr size_t MAX_BUFFER_SIZE = 64 * 1024;
-        const std::string EMPTY_STRING;
+
+        void writeToStream(std::ostream& stream, const char* data,
+                           size_t size, WriterStats* stats)
+        {
+            stream.write(data, std::streamsize(size));
+            if (stats)
+            {
+                ++stats->flushes;
+                stats->bytesFlushed += size;
+            }
+        }
+
+        void updateMaxScopeDepth(WriterStats* stats, size_t depth)
+        {
+            if (stats && depth > stats->maxScopeDepth)
+                stats->maxScopeDepth = depth;
+        }
 
         struct Context
         {
@@ -59,15 +82,23 @@ namespace Yson
 
     struct JsonWriter::Members
     {
+        explicit Members(std::pmr::memory_resource* memoryResource)
+            : contexts(std::pmr::deque<Context>(memoryResource)),
+              sprintfBuffer(32, memoryResource),
+              buffer(memoryResource)
+        {}
+
         std::unique_ptr<std::ostream> streamPtr;
         std::ostream* stream = nullptr;
-        std::stack<Context> contexts;
+        std::stack<Context, std::pmr::deque<Context>> contexts;
         std::string indentation;
         std::string key;
-        std::vector<char> sprintfBuffer = std::vector<char>(32);
-        std::string buffer;
+        std::pmr::vector<char> sprintfBuffer;
+        std::pmr::string buffer;
         size_t maxBufferSize = MAX_BUFFER_SIZE;
         State state = AT_START_OF_VALUE_NO_COMMA;
+        /// The number of values written outside any array or object.
+        size_t topLevelValueCount = 0;
         unsigned indentationWidth = 2;
         int languageExtensions = 0;
         int floatingPointPrecision = 9;
@@ -75,27 +106,36 @@ namespace Yson
         char indentationCharacter = ' ';
         int maximumLineWidth = 120;
         std::unique_ptr<Yconvert::Converter> wstringConverter;
+        WriterStats* stats = nullptr;
     };
 
-    JsonWriter::JsonWriter(JsonFormatting formatting)
-        : JsonWriter(std::unique_ptr<std::ostream>(), nullptr, formatting)
+    JsonWriter::JsonWriter(JsonFormatting formatting,
+                           std::pmr::memory_resource* memoryResource)
+        : JsonWriter(std::unique_ptr<std::ostream>(), nullptr, formatting,
+                     memoryResource)
     {}
 
     JsonWriter::JsonWriter(const std::filesystem::path& fileName,
-                           JsonFormatting formatting)
-        : JsonWriter(std::make_unique<std::ofstream>(fileName),
+                           JsonFormatting formatting,
+                           std::pmr::memory_resource* memoryResource)
+        : JsonWriter(openOutputFile(fileName, false),
                      nullptr,
-                     formatting)
+                     formatting,
+                     memoryResource)
     {}
 
-    JsonWriter::JsonWriter(std::ostream& stream, JsonFormatting formatting)
-        : JsonWriter(std::unique_ptr<std::ostream>(), &stream, formatting)
+    JsonWriter::JsonWriter(std::ostream& stream, JsonFormatting formatting,
+                           std::pmr::memory_resource* memoryResource)
+        : JsonWriter(std::unique_ptr<std::ostream>(), &stream, formatting,
+                     memoryResource)
     {}
 
     JsonWriter::JsonWriter(std::unique_ptr<std::ostream> streamPtr,
                            std::ostream* stream,
-                           JsonFormatting formatting)
-        : m_Members(std::make_unique<Members>())
+                           JsonFormatting formatting,
+                           std::pmr::memory_resource* memoryResource)
+        : m_Members(std::make_unique<Members>(
+              getMemoryResource(memoryResource)))
     {
         m_Members->streamPtr = std::move(streamPtr);
         m_Members->stream = m_Members->streamPtr
@@ -140,11 +180,17 @@ namespace Yson
         return {m.buffer.data(), m.buffer.size()};
     }
 
-    const std::string& JsonWriter::str() const
+    std::string JsonWriter::str() const
+    {
+        return std::string(pmrStr());
+    }
+
+    const std::pmr::string& JsonWriter::pmrStr() const
     {
+        static const std::pmr::string EMPTY;
         auto& m = members();
         if (m.stream)
-            return EMPTY_STRING;
+            return EMPTY;
         return m.buffer;
     }
 
@@ -305,6 +351,12 @@ namespace Yson
         return *this;
     }
 
+    JsonWriter& JsonWriter::write(const JsonItem& item)
+    {
+        Writer::write(item);
+        return *this;
+    }
+
     JsonWriter& JsonWriter::rawText(std::string_view value)
     {
         write(value);
@@ -544,13 +596,24 @@ namespace Yson
         auto& m = members();
         if (m.stream && !m.buffer.empty())
         {
-            m.stream->write(m.buffer.data(),
-                            std::streamsize(m.buffer.size()));
+            writeToStream(*m.stream, m.buffer.data(), m.buffer.size(),
+                          m.stats);
             m.buffer.clear();
         }
         return *this;
     }
 
+    WriterStats* JsonWriter::stats() const
+    {
+        return members().stats;
+    }
+
+    JsonWriter& JsonWriter::setStats(WriterStats* stats)
+    {
+        members().stats = stats;
+        return *this;
+    }
+
     void JsonWriter::write(std::string_view s)
     {
         write(s.data(), s.size());
@@ -566,7 +629,7 @@ namespace Yson
         else
         {
             flush();
-            m.stream->write(s, std::streamsize(size));
+            writeToStream(*m.stream, s, size, m.stats);
         }
     }
 
@@ -600,6 +663,41 @@ namespace Yson
         }
     }
 
+    void JsonWriter::writeValueItem(const ValueItem& item)
+    {
+        if (const auto* jsonItem = dynamic_cast<const JsonValueItem*>(&item))
+        {
+            // m_Value holds strings unescaped and other values exactly
+            // as they appeared in the input. Strings with invalid escape
+            // sequences are kept as they were, Writer::writeValueItem
+            // reads them with get(), which throws.
+            if (jsonItem->m_Type == JsonTokenType::STRING
+                && !jsonItem->m_HasInvalidEscapes)
+            {
+                value(std::string_view(jsonItem->m_Value));
+                return;
+            }
+            const auto valueType = jsonItem->m_ValueType;
+            if (valueType == ValueType::NULL_VALUE
+                || valueType == ValueType::BOOLEAN
+                || isJsonNumber(jsonItem->m_Value))
+            {
+                rawValue(jsonItem->m_Value);
+                return;
+            }
+        }
+        else if (const auto* ubItem = dynamic_cast<const UBJsonValueItem*>(&item))
+        {
+            if (ubItem->m_Type == UBJsonTokenType::HIGH_PRECISION_TOKEN
+                && isJsonNumber(ubItem->m_Value))
+            {
+                rawValue(ubItem->m_Value);
+                return;
+            }
+        }
+        Writer::writeValueItem(item);
+    }
+
     JsonWriter& JsonWriter::writeString(std::string_view text)
     {
         beginValue();
@@ -622,6 +720,33 @@ namespace Yson
             " been moved to another instance.");
     }
 
+    std::unique_ptr<JsonWriter> JsonWriter::makeFragmentWriter() const
+    {
+        auto& m = members();
+        // The fragment is a value inside a new structure at the current
+        // position, which is one level deeper than the current value.
+        const auto fragmentFormatting = formatting();
+        auto writer = std::make_unique<JsonWriter>(fragmentFormatting);
+        auto& fm = writer->members();
+        fm.indentationCharacter = m.indentationCharacter;
+        fm.indentationWidth = m.indentationWidth;
+        fm.languageExtensions = m.languageExtensions;
+        fm.floatingPointPrecision = m.floatingPointPrecision;
+        fm.maximumLineWidth = m.maximumLineWidth;
+        if (fragmentFormatting == JsonFormatting::FORMAT)
+        {
+            fm.indentation = m.indentation;
+            writer->indent();
+        }
+        return writer;
+    }
+
+    bool JsonWriter::isCompleteFragment() const
+    {
+        auto& m = members();
+        return m.contexts.size() == 1 && m.topLevelValueCount == 1;
+    }
+
     void JsonWriter::beginValue()
     {
         auto& m = members();
@@ -705,6 +830,8 @@ namespace Yson
             break;
         }
         ++m.contexts.top().valueIndex;
+        if (m.contexts.size() == 1)
+            ++m.topLevelValueCount;
         if (isInsideObject())
         {
             if (!isUnquotedValueNamesEnabled()
@@ -761,6 +888,7 @@ namespace Yson
         }
 
         m.contexts.emplace(endChar, parameters);
+        updateMaxScopeDepth(m.stats, m.contexts.size() - 1);
         if (formatting() == JsonFormatting::FORMAT)
             indent();
         m.state = AT_START_OF_STRUCTURE;
@@ -837,16 +965,13 @@ namespace Yson
     {
         beginValue();
         auto& m = members();
-        auto& buffer = m.sprintfBuffer;
-        auto result = std::to_chars(buffer.data(),
-                                    buffer.data() + buffer.size(), number);
-        while (result.ec != std::errc())
-        {
-            buffer.resize(buffer.size() * 2);
-            result = std::to_chars(buffer.data(),
-                                   buffer.data() + buffer.size(), number);
-        }
-        write(buffer.data(), size_t(result.ptr - buffer.data()));
+        if (m.buffer.size() + MAX_INTEGER_CHARACTERS > m.maxBufferSize)
+            flush();
+        // Format the number directly into the end of the buffer.
+        const auto size = m.buffer.size();
+        m.buffer.resize(size + MAX_INTEGER_CHARACTERS);
+        const auto end = formatInteger(m.buffer.data() + size, number);
+        m.buffer.resize(size_t(end - m.buffer.data()));
         m.state = AT_END_OF_VALUE;
         return *this;
     }
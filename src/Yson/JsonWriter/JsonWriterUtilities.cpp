@@ -40,7 +40,7 @@ namespace Yson
         return suggestedPos;
     }
 
-    size_t getCurrentLineWidth(const std::string& buffer,
+    size_t getCurrentLineWidth(std::string_view buffer,
                                size_t maxLineWidth)
     {
         auto maxOffset = std::min(buffer.size(), maxLineWidth);
@@ -51,4 +51,54 @@ namespace Yson
         }
         return maxOffset;
     }
+
+    namespace
+    {
+        bool isDigit(char c)
+        {
+            return '0' <= c && c <= '9';
+        }
+
+        const char* skipDigits(const char* it, const char* end)
+        {
+            while (it != end && isDigit(*it))
+                ++it;
+            return it;
+        }
+    }
+
+    bool isJsonNumber(std::string_view s)
+    {
+        auto it = s.data();
+        auto end = it + s.size();
+        if (it != end && *it == '-')
+            ++it;
+        if (it == end)
+            return false;
+        if (*it == '0')
+            ++it;
+        else if (isDigit(*it))
+            it = skipDigits(it, end);
+        else
+            return false;
+
+        if (it != end && *it == '.')
+        {
+            auto next = skipDigits(++it, end);
+            if (next == it)
+                return false;
+            it = next;
+        }
+
+        if (it != end && (*it == 'e' || *it == 'E'))
+        {
+            if (++it != end && (*it == '+' || *it == '-'))
+                ++it;
+            auto next = skipDigits(it, end);
+            if (next == it)
+                return false;
+            it = next;
+        }
+        return it == end;
+    }
 }
@@ -13,6 +13,12 @@ namespace Yson
 {
     size_t findSplitPos(std::string_view s, size_t suggestedPos);
 
-    size_t getCurrentLineWidth(const std::string& buffer,
+    size_t getCurrentLineWidth(std::string_view buffer,
                                size_t maxLineWidth);
+
+    /**
+     * @brief Returns true if @a s is a number as defined by the JSON
+     *  standard, i.e. it can be written verbatim by JsonWriter.
+     */
+    bool isJsonNumber(std::string_view s);
 }
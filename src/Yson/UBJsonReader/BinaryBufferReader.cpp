@@ -9,6 +9,7 @@
 
 #include <cassert>
 #include <cstring>
+#include "Yson/ReaderStats.hpp"
 #include "FromBigEndian.hpp"
 
 namespace Yson
@@ -24,6 +25,8 @@ namespace Yson
     {
         auto actualSize = std::min<size_t>(size, m_BufferEnd - m_TokenEnd);
         m_TokenStart = m_TokenEnd += actualSize;
+        if (m_Stats)
+            m_Stats->bytesRead += actualSize;
         return actualSize == size;
     }
 
@@ -58,6 +61,8 @@ namespace Yson
         auto actualSize = std::min<size_t>(size, m_BufferEnd - m_TokenEnd);
         m_TokenStart = m_TokenEnd;
         m_TokenEnd += actualSize;
+        if (m_Stats)
+            m_Stats->bytesRead += actualSize;
         return actualSize == size;
     }
 
@@ -66,6 +71,8 @@ namespace Yson
         auto actualSize = std::min<size_t>(size, m_BufferEnd - m_TokenEnd);
         m_TokenStart = m_TokenEnd;
         m_TokenEnd += actualSize;
+        if (m_Stats)
+            m_Stats->bytesRead += actualSize;
         if (actualSize != size)
         {
             // Moves m_TokenStart to the end of the buffer to "emulate"
@@ -80,8 +87,22 @@ namespace Yson
         return true;
     }
 
+    bool BinaryBufferReader::seek(size_t position)
+    {
+        if (position > size_t(m_BufferEnd - m_BufferStart))
+            return false;
+        m_TokenStart = m_TokenEnd = m_BufferStart + position;
+        return true;
+    }
+
     size_t BinaryBufferReader::size()
     {
         return m_TokenEnd - m_TokenStart;
     }
+
+    void BinaryBufferReader::reset(const char* buffer, size_t size)
+    {
+        m_TokenStart = m_TokenEnd = m_BufferStart = buffer;
+        m_BufferEnd = buffer + size;
+    }
 }
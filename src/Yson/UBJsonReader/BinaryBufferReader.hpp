@@ -32,6 +32,10 @@ namespace Yson
 
         bool read(void* buffer, size_t size, size_t unitSize) override;
 
+        bool seek(size_t position) override;
+
+        void reset(const char* buffer, size_t size);
+
     private:
         const char* m_TokenStart;
         const char* m_TokenEnd;
@@ -7,14 +7,22 @@
 //****************************************************************************
 #include "BinaryFileReader.hpp"
 #include "Yson/YsonException.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
 
 namespace Yson
 {
-    BinaryFileReader::BinaryFileReader(const std::filesystem::path& fileName)
-        : m_Stream(fileName, std::ios_base::binary)
+    BinaryFileReader::BinaryFileReader(const std::filesystem::path& fileName,
+                                       size_t chunkSize,
+                                       std::pmr::memory_resource* memoryResource,
+                                       Compression compression)
+        : BinaryStreamReader(chunkSize, memoryResource),
+          m_Stream(fileName, std::ios_base::binary)
     {
         if (!m_Stream)
             YSON_THROW("Unable to open file: " + fileName.string());
-        setStream(&m_Stream);
+        m_DecompressingStream = openDecompressingStream(m_Stream, nullptr, 0,
+                                                        compression);
+        setStream(m_DecompressingStream ? m_DecompressingStream.get()
+                                        : &m_Stream);
     }
 }
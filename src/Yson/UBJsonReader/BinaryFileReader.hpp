@@ -9,15 +9,21 @@
 #include "BinaryStreamReader.hpp"
 #include <filesystem>
 #include <fstream>
+#include "Yson/Compression.hpp"
 
 namespace Yson
 {
     class BinaryFileReader : public BinaryStreamReader
     {
     public:
-        explicit BinaryFileReader(const std::filesystem::path& fileName);
+        BinaryFileReader(const std::filesystem::path& fileName,
+                         size_t chunkSize,
+                         std::pmr::memory_resource* memoryResource
+                             = std::pmr::get_default_resource(),
+                         Compression compression = Compression::NONE);
 
     private:
         std::ifstream m_Stream;
+        std::unique_ptr<std::istream> m_DecompressingStream;
     };
 }
@@ -10,6 +10,8 @@
 
 namespace Yson
 {
+    struct ReaderStats;
+
     class BinaryReader
     {
     public:
@@ -30,7 +32,22 @@ namespace Yson
         virtual bool read(void* buffer, size_t size, size_t unitSize) = 0;
 
         virtual size_t size() = 0;
+
+        /**
+         * @brief Moves to @a position in the input, the next read starts
+         *  there.
+         *
+         * @return false if the input can't be repositioned.
+         */
+        virtual bool seek(size_t position) = 0;
+
+        void setStats(ReaderStats* stats)
+        {
+            m_Stats = stats;
+        }
     protected:
         BinaryReader() = default;
+
+        ReaderStats* m_Stats = nullptr;
     };
 }
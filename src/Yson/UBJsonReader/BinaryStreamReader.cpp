@@ -10,29 +10,58 @@
 #include <cassert>
 #include <cstring>
 #include <istream>
-#include "Yson/Common/DefaultBufferSize.hpp"
+#include "Yson/ReaderStats.hpp"
 #include "FromBigEndian.hpp"
 
 namespace Yson
 {
-    BinaryStreamReader::BinaryStreamReader()
-        : m_Stream(nullptr)
+    namespace
     {
-        m_Buffer.reserve(getDefaultBufferSize());
+        std::streamoff getStreamStart(std::istream& stream)
+        {
+            const auto position = stream.tellg();
+            return position == std::istream::pos_type(-1)
+                   ? 0
+                   : std::streamoff(position);
+        }
+    }
+
+    BinaryStreamReader::BinaryStreamReader(
+            size_t chunkSize,
+            std::pmr::memory_resource* memoryResource)
+        : m_Stream(nullptr),
+          m_Buffer(memoryResource)
+    {
+        m_Buffer.reserve(chunkSize);
         m_Start = m_End = m_Buffer.data();
     }
 
     BinaryStreamReader::BinaryStreamReader(std::istream& stream,
                                            const char* buffer,
-                                           size_t bufferSize)
-        : m_Stream(&stream)
+                                           size_t bufferSize,
+                                           size_t chunkSize,
+                                           std::pmr::memory_resource* memoryResource)
+        : m_Stream(&stream),
+          m_Buffer(memoryResource),
+          m_StreamStart(getStreamStart(stream)),
+          m_InitialBufferSize(buffer ? bufferSize : 0)
     {
-        m_Buffer.reserve(getDefaultBufferSize());
+        m_Buffer.reserve(chunkSize);
         if (buffer)
             m_Buffer.assign(buffer, buffer + bufferSize);
         m_End = m_Start = m_Buffer.data();
     }
 
+    BinaryStreamReader::BinaryStreamReader(std::unique_ptr<std::istream> stream,
+                                           size_t chunkSize,
+                                           std::pmr::memory_resource* memoryResource)
+        : BinaryStreamReader(*stream, nullptr, 0, chunkSize, memoryResource)
+    {
+        m_OwnedStream = std::move(stream);
+    }
+
+    BinaryStreamReader::~BinaryStreamReader() = default;
+
     bool BinaryStreamReader::advance(size_t size)
     {
         m_Start = m_End;
@@ -42,11 +71,12 @@ namespace Yson
             m_End = m_Start += size;
             return true;
         }
-        m_End = m_Start += remainderSize;
         auto originalPos = m_Stream->tellg();
         m_Stream->seekg(std::streamsize(size - remainderSize),
                         std::ios_base::cur);
-        return m_Stream->tellg() - originalPos == size - remainderSize;
+        auto skippedSize = size_t(m_Stream->tellg() - originalPos);
+        discardBuffer(skippedSize);
+        return skippedSize == size - remainderSize;
     }
 
     const void* BinaryStreamReader::data() const
@@ -73,10 +103,7 @@ namespace Yson
 
     size_t BinaryStreamReader::position() const
     {
-        auto pos = m_Stream->tellg();
-        if (pos != std::istream::pos_type(-1))
-            return size_t(pos) - remainingBytesIncludingValue();
-        return 0;
+        return m_BufferPosition + size_t(m_Start - m_Buffer.data());
     }
 
     bool BinaryStreamReader::read(size_t size)
@@ -101,23 +128,65 @@ namespace Yson
             m_End = m_Start + size;
             memcpy(buffer, m_Start, size);
             if (unitSize > 1)
-                fromBigEndian(size, m_Start, unitSize);
+                fromBigEndian(size, static_cast<char*>(buffer), unitSize);
             return true;
         }
 
         if (remainderSize)
             memcpy(buffer, m_Start, remainderSize);
-        m_End = m_Start += remainderSize;
         m_Stream->read(static_cast<char*>(buffer) + remainderSize,
                        std::streamsize(size - remainderSize));
+        if (m_Stats)
+            m_Stats->bytesRead += size_t(m_Stream->gcount());
+        discardBuffer(size_t(m_Stream->gcount()));
         auto readSize = size_t(m_Stream->gcount()) + remainderSize;
         if (readSize != size)
             return false;
         if (unitSize > 1)
-            fromBigEndian(size, m_Start, unitSize);
+            fromBigEndian(size, static_cast<char*>(buffer), unitSize);
         return true;
     }
 
+    void BinaryStreamReader::reset(std::istream& stream,
+                                   const char* buffer,
+                                   size_t bufferSize)
+    {
+        m_OwnedStream.reset();
+        m_Stream = &stream;
+        if (buffer)
+            m_Buffer.assign(buffer, buffer + bufferSize);
+        else
+            m_Buffer.clear();
+        m_End = m_Start = m_Buffer.data();
+        m_BufferPosition = 0;
+        m_StreamStart = getStreamStart(stream);
+        m_InitialBufferSize = buffer ? bufferSize : 0;
+    }
+
+    bool BinaryStreamReader::seek(size_t position)
+    {
+        // There's no need to read the buffer's contents again if
+        // position is inside it.
+        if (m_BufferPosition <= position
+            && position <= m_BufferPosition + m_Buffer.size())
+        {
+            m_End = m_Start = m_Buffer.data() + (position - m_BufferPosition);
+            return true;
+        }
+
+        // The initial buffer isn't in the stream, it can't be read again.
+        if (position < m_InitialBufferSize)
+            return false;
+
+        m_Stream->clear();
+        m_Stream->seekg(m_StreamStart
+                        + std::streamoff(position - m_InitialBufferSize));
+        m_Buffer.clear();
+        m_End = m_Start = m_Buffer.data();
+        m_BufferPosition = position;
+        return !m_Stream->fail();
+    }
+
     size_t BinaryStreamReader::size()
     {
         return m_End - m_Start;
@@ -126,11 +195,14 @@ namespace Yson
     void BinaryStreamReader::setStream(std::istream* stream)
     {
         m_Stream = stream;
+        m_StreamStart = getStreamStart(*stream);
     }
 
     bool BinaryStreamReader::fillBuffer(size_t size)
     {
         auto remainderSize = remainingBytesIncludingValue();
+        auto capacity = m_Buffer.capacity();
+        m_BufferPosition += size_t(m_Start - m_Buffer.data());
         if (m_Buffer.empty())
         {
             m_Buffer.resize(std::max(m_Buffer.capacity(), size));
@@ -138,7 +210,11 @@ namespace Yson
         else
         {
             if (remainderSize != 0 && m_Start != m_Buffer.data())
+            {
                 std::copy(m_Start, m_Start + remainderSize, m_Buffer.data());
+                if (m_Stats)
+                    m_Stats->bytesMoved += remainderSize;
+            }
             if (m_Buffer.size() < size)
                 m_Buffer.resize(size);
         }
@@ -147,11 +223,25 @@ namespace Yson
         m_Stream->read(m_Buffer.data() + remainderSize,
                        std::streamsize(m_Buffer.size() - remainderSize));
         auto contentSize = m_Stream->gcount() + remainderSize;
+        if (m_Stats)
+        {
+            ++m_Stats->bufferRefills;
+            m_Stats->bytesRead += size_t(m_Stream->gcount());
+            if (m_Buffer.capacity() != capacity)
+                ++m_Stats->allocations;
+        }
         if (contentSize < m_Buffer.size())
             m_Buffer.resize(contentSize);
         return contentSize >= size;
     }
 
+    void BinaryStreamReader::discardBuffer(size_t bypassedSize)
+    {
+        m_BufferPosition += m_Buffer.size() + bypassedSize;
+        m_Buffer.clear();
+        m_End = m_Start = m_Buffer.data();
+    }
+
     size_t BinaryStreamReader::remainingBytesAfterValue() const
     {
         return size_t(m_Buffer.data() + m_Buffer.size() - m_End);
@@ -6,7 +6,9 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #pragma once
-#include <iosfwd>
+#include <ios>
+#include <memory>
+#include <memory_resource>
 #include <vector>
 #include "BinaryReader.hpp"
 
@@ -17,7 +19,21 @@ namespace Yson
     public:
         BinaryStreamReader(std::istream& stream,
                            const char* buffer,
-                           size_t bufferSize);
+                           size_t bufferSize,
+                           size_t chunkSize,
+                           std::pmr::memory_resource* memoryResource
+                               = std::pmr::get_default_resource());
+
+        /**
+         * @brief Creates a reader that owns its stream, e.g. a stream that
+         *  decompresses another stream.
+         */
+        BinaryStreamReader(std::unique_ptr<std::istream> stream,
+                           size_t chunkSize,
+                           std::pmr::memory_resource* memoryResource
+                               = std::pmr::get_default_resource());
+
+        ~BinaryStreamReader() override;
 
         bool advance(size_t count) override;
 
@@ -35,21 +51,43 @@ namespace Yson
 
         bool read(void* buffer, size_t size, size_t unitSize) override;
 
+        bool seek(size_t position) override;
+
+        void reset(std::istream& stream,
+                   const char* buffer,
+                   size_t bufferSize);
+
     protected:
-        BinaryStreamReader();
+        BinaryStreamReader(size_t chunkSize,
+                           std::pmr::memory_resource* memoryResource);
 
         void setStream(std::istream* stream);
 
     private:
         bool fillBuffer(size_t size);
 
+        /**
+         * @brief Empties the buffer after @a bypassedSize bytes following
+         *  it have been read or skipped directly from the stream.
+         */
+        void discardBuffer(size_t bypassedSize);
+
         [[nodiscard]] size_t remainingBytesAfterValue() const;
 
         [[nodiscard]] size_t remainingBytesIncludingValue() const;
 
+        std::unique_ptr<std::istream> m_OwnedStream;
         std::istream* m_Stream;
-        std::vector<char> m_Buffer;
+        std::pmr::vector<char> m_Buffer;
         char* m_Start;
         char* m_End;
+        /// The position in the input of the first byte in m_Buffer.
+        size_t m_BufferPosition = 0;
+        /// The stream's own position when the reader started reading
+        /// from it, the input's positions are relative to this one.
+        std::streamoff m_StreamStart = 0;
+        /// The size of the buffer given to the constructor or reset(),
+        /// it precedes m_StreamStart in the input.
+        size_t m_InitialBufferSize = 0;
     };
 }
@@ -8,6 +8,7 @@
 #pragma once
 #include <algorithm>
 #include <cassert>
+#include <cstring>
 
 namespace Yson
 {
@@ -145,4 +146,38 @@ namespace Yson
         }
     }
     #endif
+
+    /**
+     * @brief Converts the @a size / @a unitSize values in @a buffer from
+     *  little-endian to native byte order.
+     */
+    #ifdef IS_BIG_ENDIAN
+    inline void fromLittleEndian(size_t size, char* buffer, size_t unitSize)
+    {
+        assert(size % unitSize == 0);
+        if (unitSize > 1)
+        {
+            for (size_t i = unitSize; i <= size; i += unitSize)
+                std::reverse(buffer + i - unitSize, buffer + i);
+        }
+    }
+    #else
+    inline void fromLittleEndian(size_t, char*, size_t)
+    {}
+    #endif
+
+    /**
+     * @brief Copies the N-byte little-endian value at @a src to @a dst
+     *  in native byte order.
+     */
+    template <int N>
+    void fromLittleEndian(void* dst, const void* src)
+    {
+        #ifdef IS_BIG_ENDIAN
+        auto csrc = static_cast<const char*>(src);
+        std::reverse_copy(csrc, csrc + N, static_cast<char*>(dst));
+        #else
+        memcpy(dst, src, N);
+        #endif
+    }
 }
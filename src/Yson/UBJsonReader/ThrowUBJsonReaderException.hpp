@@ -16,6 +16,7 @@ namespace Yson
                                           YSON_DEBUG_LOCATION(), \
                                           (tokenizer).fileName(), \
                                           0, \
+                                          (tokenizer).position(), \
                                           (tokenizer).position())
 
     #define UBJSON_READER_UNEXPECTED_TOKEN(tokenizer) \
@@ -0,0 +1,208 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/UBJsonIndex.hpp"
+
+#include <algorithm>
+#include "Yson/UBJsonReader.hpp"
+#include "Yson/UBJsonWriter.hpp"
+#include "Yson/YsonException.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        using Entries = std::vector<std::pair<std::string, uint64_t>>;
+
+        void appendKey(std::string& path, std::string_view key)
+        {
+            path.push_back('/');
+            for (auto c : key)
+            {
+                if (c == '~')
+                    path.append("~0");
+                else if (c == '/')
+                    path.append("~1");
+                else
+                    path.push_back(c);
+            }
+        }
+
+        /**
+         * @brief Adds the current value and its children to @a entries.
+         *
+         * @return false if the value doesn't have an offset, i.e. it is
+         *  in an optimized array or object with a value type.
+         */
+        bool indexValue(UBJsonReader& reader, std::string& path, // NOLINT(*-no-recursion)
+                        size_t depth, Entries& entries)
+        {
+            const auto offset = reader.valueOffset();
+            if (!offset)
+                return false;
+
+            entries.emplace_back(path, *offset);
+            if (depth == 0)
+                return true;
+
+            const auto valueType = reader.valueType();
+            if (valueType != ValueType::ARRAY
+                && valueType != ValueType::OBJECT)
+            {
+                return true;
+            }
+
+            const auto pathSize = path.size();
+            reader.enter();
+            if (valueType == ValueType::ARRAY)
+            {
+                for (size_t i = 0; reader.nextValue(); ++i)
+                {
+                    appendKey(path, std::to_string(i));
+                    const auto indexed = indexValue(reader, path, depth - 1,
+                                                    entries);
+                    path.resize(pathSize);
+                    if (!indexed)
+                        break;
+                }
+            }
+            else
+            {
+                while (reader.nextKey())
+                {
+                    appendKey(path, read<std::string>(reader));
+                    reader.nextValue();
+                    const auto indexed = indexValue(reader, path, depth - 1,
+                                                    entries);
+                    path.resize(pathSize);
+                    if (!indexed)
+                        break;
+                }
+            }
+            reader.leave();
+            return true;
+        }
+
+        void sortEntries(Entries& entries)
+        {
+            // The sort is stable and unique keeps the first of equal
+            // elements, i.e. the first value of duplicate keys is kept.
+            std::stable_sort(entries.begin(), entries.end(),
+                             [](auto& a, auto& b)
+                             {
+                                 return a.first < b.first;
+                             });
+            auto it = std::unique(entries.begin(), entries.end(),
+                                  [](auto& a, auto& b)
+                                  {
+                                      return a.first == b.first;
+                                  });
+            entries.erase(it, entries.end());
+        }
+
+        UBJsonIndex readIndex(UBJsonReader& reader)
+        {
+            UBJsonIndex index;
+            if (!reader.nextValue() || reader.valueType() != ValueType::OBJECT)
+                YSON_THROW("The input is not a UBJSON index.");
+            reader.enter();
+            while (reader.nextKey())
+            {
+                auto path = read<std::string>(reader);
+                reader.nextValue();
+                index.add(std::move(path), read<uint64_t>(reader));
+            }
+            reader.leave();
+            return index;
+        }
+
+        void writeIndex(UBJsonWriter& writer, const Entries& entries)
+        {
+            writer.beginObject();
+            for (const auto& [path, offset] : entries)
+                writer.key(path).value(offset);
+            writer.endObject();
+            writer.flush();
+        }
+    }
+
+    UBJsonIndex UBJsonIndex::build(UBJsonReader& reader, size_t maxDepth)
+    {
+        UBJsonIndex index;
+        if (!reader.nextValue())
+            return index;
+        std::string path;
+        indexValue(reader, path, maxDepth, index.m_Entries);
+        sortEntries(index.m_Entries);
+        return index;
+    }
+
+    UBJsonIndex UBJsonIndex::load(std::istream& stream)
+    {
+        UBJsonReader reader(stream);
+        return readIndex(reader);
+    }
+
+    UBJsonIndex UBJsonIndex::load(const std::filesystem::path& fileName)
+    {
+        UBJsonReader reader(fileName);
+        return readIndex(reader);
+    }
+
+    void UBJsonIndex::save(std::ostream& stream) const
+    {
+        UBJsonWriter writer(stream);
+        writeIndex(writer, m_Entries);
+    }
+
+    void UBJsonIndex::save(const std::filesystem::path& fileName) const
+    {
+        UBJsonWriter writer(fileName);
+        writeIndex(writer, m_Entries);
+    }
+
+    void UBJsonIndex::add(std::string path, uint64_t offset)
+    {
+        auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), path,
+                                   [](auto& entry, auto& p)
+                                   {
+                                       return entry.first < p;
+                                   });
+        if (it != m_Entries.end() && it->first == path)
+            it->second = offset;
+        else
+            m_Entries.emplace(it, std::move(path), offset);
+    }
+
+    std::optional<uint64_t> UBJsonIndex::find(std::string_view path) const
+    {
+        auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), path,
+                                   [](auto& entry, auto& p)
+                                   {
+                                       return entry.first < p;
+                                   });
+        if (it != m_Entries.end() && it->first == path)
+            return it->second;
+        return {};
+    }
+
+    size_t UBJsonIndex::size() const
+    {
+        return m_Entries.size();
+    }
+
+    bool UBJsonIndex::empty() const
+    {
+        return m_Entries.empty();
+    }
+
+    const std::vector<std::pair<std::string, uint64_t>>&
+    UBJsonIndex::entries() const
+    {
+        return m_Entries;
+    }
+}
@@ -7,8 +7,11 @@
 //****************************************************************************
 #include "Yson/UBJsonReader.hpp"
 
+#include <algorithm>
 #include "Yson/ArrayItem.hpp"
 #include "Yson/ObjectItem.hpp"
+#include "Yson/ReaderStats.hpp"
+#include "Yson/UBJsonIndex.hpp"
 #include "Yson/Common/Base64.hpp"
 #include "Yson/Common/GetDetailedValueType.hpp"
 #include "Yson/Common/GetValueType.hpp"
@@ -23,9 +26,77 @@ namespace Yson
 {
     namespace
     {
+        /// The count of an optimized array or object comes from the
+        /// input, so the capacity reserved from it is limited.
+        constexpr size_t MAX_RESERVED_ITEMS = 1024 * 1024;
+
+        size_t getReservedSize(const UBJsonTokenizer& tokenizer)
+        {
+            switch (tokenizer.tokenType())
+            {
+            case UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN:
+            case UBJsonTokenType::START_OPTIMIZED_OBJECT_TOKEN:
+                return std::min(tokenizer.contentSize(), MAX_RESERVED_ITEMS);
+            default:
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Returns true if the values of the current optimized
+         *  array can be read into memory in one go.
+         *
+         * The count comes from the input, arrays that are larger than
+         * the maximum token size or MAX_RESERVED_ITEMS are read one
+         * value at a time so that a count that doesn't match the input
+         * ends with an unexpected end of document rather than a huge
+         * allocation.
+         */
+        bool canReadArrayData(const UBJsonTokenizer& tokenizer)
+        {
+            const auto valueSize = getValueSize(tokenizer.contentType());
+            if (valueSize == 0 || tokenizer.stats())
+                return false;
+            const auto count = tokenizer.contentSize();
+            if (count > MAX_RESERVED_ITEMS)
+                return false;
+            const auto maxTokenSize = tokenizer.maxTokenSize();
+            return maxTokenSize == 0 || count * valueSize <= maxTokenSize;
+        }
+
+        /**
+         * @brief Adds a value item to @a values for each of the
+         *  fixed-size values in @a data.
+         */
+        void addFixedSizeValues(std::pmr::vector<JsonItem>& values,
+                                std::span<const char> data,
+                                UBJsonTokenType valueType,
+                                bool littleEndian)
+        {
+            const auto valueSize = getValueSize(valueType);
+            const auto count = data.size() / valueSize;
+            const auto memoryResource = values.get_allocator().resource();
+            values.reserve(values.size() + count);
+            for (size_t i = 0; i < count; ++i)
+            {
+                auto value = data.data() + i * valueSize;
+                std::pmr::string str(value, valueSize, memoryResource);
+                values.emplace_back(UBJsonValueItem(std::move(str), valueType,
+                                                    {}, littleEndian));
+            }
+        }
+
+        JsonItem makeArrayItem(std::pmr::vector<JsonItem> values)
+        {
+            const auto memoryResource = values.get_allocator().resource();
+            return JsonItem(std::allocate_shared<ArrayItem>(
+                std::pmr::polymorphic_allocator<>(memoryResource),
+                std::move(values)));
+        }
+
         template <typename T>
         bool readOptimizedArrayToString(UBJsonReader& reader,
-                                        std::string& buffer)
+                                        std::pmr::string& buffer)
         {
             size_t size = 0;
             T* ptr = nullptr;
@@ -50,37 +121,63 @@ namespace Yson
     struct UBJsonReader::Members
     {
         explicit Members(UBJsonTokenizer&& tokenizer)
-                : tokenizer(std::move(tokenizer))
+                : tokenizer(std::move(tokenizer)),
+                  scopes(this->tokenizer.memoryResource())
         {
             scopes.reserve(50);
         }
 
         UBJsonTokenizer tokenizer;
-        std::vector<Scope> scopes;
+        std::pmr::vector<Scope> scopes;
         UBJsonArrayReader arrayReader;
         UBJsonDocumentReader documentReader;
         UBJsonObjectReader objectReader;
         UBJsonOptimizedArrayReader optimizedArrayReader;
         UBJsonOptimizedObjectReader optimizedObjectReader;
+
+        void enterScope(UBJsonScopeReader* reader, UBJsonReaderState state)
+        {
+            if (auto stats = tokenizer.stats())
+            {
+                if (scopes.size() == scopes.capacity())
+                    ++stats->allocations;
+                // The document scope doesn't count.
+                stats->maxScopeDepth = std::max(stats->maxScopeDepth,
+                                                scopes.size());
+            }
+            scopes.push_back({reader, state});
+        }
+
+        JsonItem makeValueItem(UBJsonTokenType tokenType) const
+        {
+            return JsonItem(UBJsonValueItem(
+                std::pmr::string(tokenizer.token(),
+                                 tokenizer.memoryResource()),
+                tokenType, {}, tokenizer.isBJData()));
+        }
     };
 
     UBJsonReader::UBJsonReader() = default;
 
-    UBJsonReader::UBJsonReader(std::istream& stream)
-        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(stream)))
+    UBJsonReader::UBJsonReader(std::istream& stream,
+                               const ReaderOptions& options)
+        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(stream, nullptr, 0, options)))
     {}
 
-    UBJsonReader::UBJsonReader(const std::filesystem::path& fileName)
-        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(fileName)))
+    UBJsonReader::UBJsonReader(const std::filesystem::path& fileName,
+                               const ReaderOptions& options)
+        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(fileName, options)))
     {}
 
-    UBJsonReader::UBJsonReader(const char* buffer, size_t bufferSize)
-        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(buffer, bufferSize)))
+    UBJsonReader::UBJsonReader(const char* buffer, size_t bufferSize,
+                               const ReaderOptions& options)
+        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(buffer, bufferSize, options)))
     {}
 
     UBJsonReader::UBJsonReader(std::istream& stream, const char* buffer,
-                               size_t bufferSize)
-        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(stream, buffer, bufferSize)))
+                               size_t bufferSize,
+                               const ReaderOptions& options)
+        : UBJsonReader(std::make_unique<Members>(UBJsonTokenizer(stream, buffer, bufferSize, options)))
     {}
 
     UBJsonReader::UBJsonReader(std::unique_ptr<Members> members)
@@ -96,6 +193,56 @@ namespace Yson
 
     UBJsonReader& UBJsonReader::operator=(UBJsonReader&&) noexcept = default;
 
+    void UBJsonReader::reset(const char* buffer, size_t bufferSize)
+    {
+        if (!m_Members)
+        {
+            *this = UBJsonReader(buffer, bufferSize);
+            return;
+        }
+        m_Members->tokenizer.reset(buffer, bufferSize);
+        resetScopes();
+    }
+
+    void UBJsonReader::reset(std::istream& stream)
+    {
+        if (!m_Members)
+        {
+            *this = UBJsonReader(stream);
+            return;
+        }
+        m_Members->tokenizer.reset(stream);
+        resetScopes();
+    }
+
+    void UBJsonReader::seek(size_t offset)
+    {
+        if (!m_Members)
+            YSON_THROW("Uninitialized UBJsonReader.");
+        m_Members->tokenizer.seek(offset);
+        resetScopes();
+    }
+
+    bool UBJsonReader::seek(const UBJsonIndex& index, std::string_view path)
+    {
+        const auto offset = index.find(path);
+        if (!offset)
+            return false;
+        seek(size_t(*offset));
+        return true;
+    }
+
+    std::optional<size_t> UBJsonReader::valueOffset() const
+    {
+        const auto& state = currentScope().state;
+        if (state.state != ReaderState::AT_VALUE)
+            UBJSON_READER_THROW("There is no current value.",
+                                m_Members->tokenizer);
+        if (state.valueType != UBJsonTokenType::UNKNOWN_TOKEN)
+            return {};
+        return m_Members->tokenizer.markerPosition();
+    }
+
     bool UBJsonReader::nextValue()
     {
         auto& scope = currentScope();
@@ -121,22 +268,19 @@ namespace Yson
         {
             auto options = currentScope().state.options;
             auto tokenType = m_Members->tokenizer.tokenType();
+            auto& m = *m_Members;
             if (tokenType == UBJsonTokenType::START_OBJECT_TOKEN)
-                m_Members->scopes.push_back(
-                        {&m_Members->objectReader,
-                         UBJsonReaderState(ReaderState::AT_START, options)});
+                m.enterScope(&m.objectReader,
+                             UBJsonReaderState(ReaderState::AT_START, options));
             else if (tokenType == UBJsonTokenType::START_ARRAY_TOKEN)
-                m_Members->scopes.push_back(
-                        {&m_Members->arrayReader,
-                         UBJsonReaderState(ReaderState::AT_START, options)});
+                m.enterScope(&m.arrayReader,
+                             UBJsonReaderState(ReaderState::AT_START, options));
             else if (tokenType == UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN)
-                m_Members->scopes.push_back(
-                        {&m_Members->optimizedArrayReader,
-                         makeState(m_Members->tokenizer, options)});
+                m.enterScope(&m.optimizedArrayReader,
+                             makeState(m.tokenizer, options));
             else if (tokenType == UBJsonTokenType::START_OPTIMIZED_OBJECT_TOKEN)
-                m_Members->scopes.push_back(
-                        {&m_Members->optimizedObjectReader,
-                         makeState(m_Members->tokenizer, options)});
+                m.enterScope(&m.optimizedObjectReader,
+                             makeState(m.tokenizer, options));
             else
                 UBJSON_READER_THROW(
                         "There is no object or array to be entered.",
@@ -190,8 +334,12 @@ namespace Yson
         case UBJsonTokenType::INT16_TOKEN:
         case UBJsonTokenType::INT32_TOKEN:
         case UBJsonTokenType::INT64_TOKEN:
+        case UBJsonTokenType::UINT16_TOKEN:
+        case UBJsonTokenType::UINT32_TOKEN:
+        case UBJsonTokenType::UINT64_TOKEN:
         case UBJsonTokenType::CHAR_TOKEN:
             return ValueType::INTEGER;
+        case UBJsonTokenType::FLOAT16_TOKEN:
         case UBJsonTokenType::FLOAT32_TOKEN:
         case UBJsonTokenType::FLOAT64_TOKEN:
         case UBJsonTokenType::HIGH_PRECISION_TOKEN:
@@ -243,8 +391,15 @@ namespace Yson
             return DetailedValueType::UINT_31;
         case UBJsonTokenType::INT64_TOKEN:
             return DetailedValueType::UINT_63;
+        case UBJsonTokenType::UINT16_TOKEN:
+            return DetailedValueType::UINT_16;
+        case UBJsonTokenType::UINT32_TOKEN:
+            return DetailedValueType::UINT_32;
+        case UBJsonTokenType::UINT64_TOKEN:
+            return DetailedValueType::UINT_64;
         case UBJsonTokenType::CHAR_TOKEN:
             return DetailedValueType::CHAR;
+        case UBJsonTokenType::FLOAT16_TOKEN:
         case UBJsonTokenType::FLOAT32_TOKEN:
             return DetailedValueType::FLOAT_32;
         case UBJsonTokenType::FLOAT64_TOKEN:
@@ -275,7 +430,7 @@ namespace Yson
     {
         auto state = currentScope().state.state;
         auto tokType = m_Members->tokenizer.tokenType();
-        return state != ReaderState::AT_VALUE
+        return state == ReaderState::AT_VALUE
                && tokType == UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN;
     }
 
@@ -303,8 +458,15 @@ namespace Yson
             return {size, DetailedValueType::UINT_31};
         case UBJsonTokenType::INT64_TOKEN:
             return {size, DetailedValueType::UINT_63};
+        case UBJsonTokenType::UINT16_TOKEN:
+            return {size, DetailedValueType::UINT_16};
+        case UBJsonTokenType::UINT32_TOKEN:
+            return {size, DetailedValueType::UINT_32};
+        case UBJsonTokenType::UINT64_TOKEN:
+            return {size, DetailedValueType::UINT_64};
         case UBJsonTokenType::CHAR_TOKEN:
             return {size, DetailedValueType::CHAR};
+        case UBJsonTokenType::FLOAT16_TOKEN:
         case UBJsonTokenType::FLOAT32_TOKEN:
             return {size, DetailedValueType::FLOAT_32};
         case UBJsonTokenType::FLOAT64_TOKEN:
@@ -322,6 +484,13 @@ namespace Yson
         }
     }
 
+    std::span<const size_t> UBJsonReader::arrayDimensions() const
+    {
+        if (!isOptimizedArray())
+            return {};
+        return m_Members->tokenizer.dimensions();
+    }
+
     bool UBJsonReader::readNull() const
     {
         assertStateIsKeyOrValue();
@@ -476,6 +645,24 @@ namespace Yson
                                       UBJsonTokenType::UINT8_TOKEN);
     }
 
+    bool UBJsonReader::readOptimizedArray(uint16_t* buffer, size_t& size)
+    {
+        return readOptimizedArrayImpl(buffer, size,
+                                      UBJsonTokenType::UINT16_TOKEN);
+    }
+
+    bool UBJsonReader::readOptimizedArray(uint32_t* buffer, size_t& size)
+    {
+        return readOptimizedArrayImpl(buffer, size,
+                                      UBJsonTokenType::UINT32_TOKEN);
+    }
+
+    bool UBJsonReader::readOptimizedArray(uint64_t* buffer, size_t& size)
+    {
+        return readOptimizedArrayImpl(buffer, size,
+                                      UBJsonTokenType::UINT64_TOKEN);
+    }
+
     bool UBJsonReader::readOptimizedArray(float* buffer, size_t& size)
     {
         return readOptimizedArrayImpl(buffer, size,
@@ -494,6 +681,37 @@ namespace Yson
                                       UBJsonTokenType::CHAR_TOKEN);
     }
 
+    bool UBJsonReader::readArrayData(std::span<const char>& data)
+    {
+        auto& state = currentScope().state;
+        auto& tokenizer = m_Members->tokenizer;
+        if (state.state != ReaderState::AT_VALUE)
+        {
+            UBJSON_READER_THROW("Current token is not an optimized array.",
+                                tokenizer);
+        }
+
+        if (tokenizer.tokenType()
+            != UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN)
+        {
+            return false;
+        }
+
+        const auto valueSize = getValueSize(tokenizer.contentType());
+        if (valueSize == 0)
+            return false;
+
+        const auto size = tokenizer.contentSize();
+        if (size > SIZE_MAX / valueSize)
+            UBJSON_READER_THROW("Optimized array is too large.", tokenizer);
+
+        tokenizer.readBytes(size * valueSize);
+        const auto token = tokenizer.token();
+        data = {token.data(), token.size()};
+        state.state = ReaderState::AFTER_VALUE;
+        return true;
+    }
+
     bool UBJsonReader::readBinary(void* buffer, size_t& size)
     {
         return readOptimizedArray(static_cast<uint8_t*>(buffer), size);
@@ -539,12 +757,10 @@ namespace Yson
             case UBJsonTokenType::START_ARRAY_TOKEN:
                 return readArray(isExpandOptimizedByteArraysEnabled());
             default:
-                return JsonItem(UBJsonValueItem(std::string(tokenizer.token()),
-                                            tokenizer.tokenType()));
+                return m_Members->makeValueItem(tokenizer.tokenType());
             }
         case ReaderState::AT_KEY:
-            return JsonItem(UBJsonValueItem(std::string(tokenizer.token()),
-                                        tokenizer.tokenType()));
+            return m_Members->makeValueItem(tokenizer.tokenType());
         default:
             UBJSON_READER_THROW("No key or value.", m_Members->tokenizer);
         }
@@ -600,34 +816,64 @@ namespace Yson
         YSON_THROW("Uninitialized UBJsonReader.");
     }
 
+    void UBJsonReader::resetScopes()
+    {
+        auto options = m_Members->scopes.front().state.options;
+        m_Members->scopes.clear();
+        m_Members->scopes.push_back({&m_Members->documentReader,
+                                     UBJsonReaderState(
+                                         ReaderState::INITIAL_STATE,
+                                         options)});
+    }
+
     JsonItem UBJsonReader::readArray(bool expandOptmizedByteArrays) // NOLINT(*-no-recursion)
     {
-        std::vector<JsonItem> values;
         const auto& tokenizer = m_Members->tokenizer;
         const auto arrayType = tokenizer.tokenType();
         if (arrayType == UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
             && !expandOptmizedByteArrays)
         {
-            std::string str;
-            switch (tokenizer.contentType())
+            std::pmr::string str(tokenizer.memoryResource());
+            const auto contentType = tokenizer.contentType();
+            bool isRead = false;
+            switch (contentType)
             {
             case UBJsonTokenType::CHAR_TOKEN:
-                if (readOptimizedArrayToString<char>(*this, str))
-                    return JsonItem(UBJsonValueItem(str, arrayType));
+                isRead = readOptimizedArrayToString<char>(*this, str);
                 break;
             case UBJsonTokenType::INT8_TOKEN:
-                if (readOptimizedArrayToString<int8_t>(*this, str))
-                    return JsonItem(UBJsonValueItem(str, arrayType));
+                isRead = readOptimizedArrayToString<int8_t>(*this, str);
                 break;
             case UBJsonTokenType::UINT8_TOKEN:
-                if (readOptimizedArrayToString<uint8_t>(*this, str))
-                    return JsonItem(UBJsonValueItem(str, arrayType));
+                isRead = readOptimizedArrayToString<uint8_t>(*this, str);
                 break;
             default:
                 break;
             }
+            if (isRead)
+            {
+                return JsonItem(UBJsonValueItem(std::move(str), arrayType,
+                                                contentType));
+            }
+        }
+
+        std::pmr::vector<JsonItem> values(tokenizer.memoryResource());
+        // Fixed-size values are read in one go and converted without
+        // going through the tokenizer, unless each token must be counted.
+        if (arrayType == UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
+            && canReadArrayData(tokenizer))
+        {
+            const auto valueType = tokenizer.contentType();
+            std::span<const char> data;
+            if (readArrayData(data))
+            {
+                addFixedSizeValues(values, data, valueType,
+                                   tokenizer.isBJData());
+                return makeArrayItem(std::move(values));
+            }
         }
 
+        values.reserve(getReservedSize(tokenizer));
         enter();
         while (true)
         {
@@ -645,20 +891,22 @@ namespace Yson
                 values.push_back(readArray(expandOptmizedByteArrays));
                 break;
             default:
-                values.emplace_back(UBJsonValueItem(std::string(tokenizer.token()),
-                                                tokenizer.tokenType()));
+                values.push_back(m_Members->makeValueItem(
+                    tokenizer.tokenType()));
                 break;
             }
         }
         leave();
-        return JsonItem(std::make_shared<ArrayItem>(std::move(values)));
+        return makeArrayItem(std::move(values));
     }
 
     JsonItem UBJsonReader::readObject(bool expandOptimizedByteArrays) // NOLINT(*-no-recursion)
     {
-        std::deque<std::string> keys;
-        std::unordered_map<std::string_view, JsonItem> values;
         const auto& tokenizer = m_Members->tokenizer;
+        std::pmr::deque<std::pmr::string> keys(tokenizer.memoryResource());
+        std::pmr::unordered_map<std::string_view, JsonItem> values(
+            tokenizer.memoryResource());
+        values.reserve(getReservedSize(tokenizer));
         enter();
         while (true)
         {
@@ -679,8 +927,8 @@ namespace Yson
 
             if (!nextValue())
             {
-                UBJSON_READER_THROW("Key without value: " + keys.back(),
-                                    tokenizer);
+                UBJSON_READER_THROW("Key without value: "
+                                    + std::string(keys.back()), tokenizer);
             }
 
             switch (tokenizer.tokenType())
@@ -694,14 +942,15 @@ namespace Yson
                 values.insert_or_assign(key, readArray(expandOptimizedByteArrays));
                 break;
             default:
-                values.insert_or_assign(key,
-                                        JsonItem(UBJsonValueItem(std::string(tokenizer.token()),
-                                                             tokenizer.tokenType())));
+                values.insert_or_assign(key, m_Members->makeValueItem(
+                    tokenizer.tokenType()));
                 break;
             }
         }
         leave();
-        return JsonItem(std::make_shared<ObjectItem>(std::move(keys), std::move(values)));
+        return JsonItem(std::allocate_shared<ObjectItem>(
+            std::pmr::polymorphic_allocator<>(tokenizer.memoryResource()),
+            std::move(keys), std::move(values)));
     }
 
     template <typename T>
@@ -732,7 +981,8 @@ namespace Yson
         if (size < tokenizer.contentSize())
             return false;
 
-        if (tokenizer.read(buffer, size, tokenizer.contentType()))
+        size = tokenizer.contentSize();
+        if (tokenizer.read(buffer, size * sizeof(T), tokenizer.contentType()))
         {
             state.state = ReaderState::AFTER_VALUE;
             return true;
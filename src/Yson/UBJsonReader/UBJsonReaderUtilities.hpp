@@ -7,6 +7,7 @@
 //****************************************************************************
 #pragma once
 #include "Yson/Common/AssignInteger.hpp"
+#include "Yson/Common/Float16.hpp"
 #include "Yson/Common/ParseFloatingPoint.hpp"
 #include "Yson/Common/ParseInteger.hpp"
 #include "ThrowUBJsonReaderException.hpp"
@@ -40,6 +41,12 @@ namespace Yson
             return assignInteger(value, tokenizer.tokenAs<int32_t>());
         case UBJsonTokenType::INT64_TOKEN:
             return assignInteger(value, tokenizer.tokenAs<int64_t>());
+        case UBJsonTokenType::UINT16_TOKEN:
+            return assignInteger(value, tokenizer.tokenAs<uint16_t>());
+        case UBJsonTokenType::UINT32_TOKEN:
+            return assignInteger(value, tokenizer.tokenAs<uint32_t>());
+        case UBJsonTokenType::UINT64_TOKEN:
+            return assignInteger(value, tokenizer.tokenAs<uint64_t>());
         case UBJsonTokenType::STRING_TOKEN:
             return parse(tokenizer.token(), value, true);
         default:
@@ -79,6 +86,18 @@ namespace Yson
         case UBJsonTokenType::INT64_TOKEN:
             value = T(tokenizer.tokenAs<int64_t>());
             return true;
+        case UBJsonTokenType::UINT16_TOKEN:
+            value = T(tokenizer.tokenAs<uint16_t>());
+            return true;
+        case UBJsonTokenType::UINT32_TOKEN:
+            value = T(tokenizer.tokenAs<uint32_t>());
+            return true;
+        case UBJsonTokenType::UINT64_TOKEN:
+            value = T(tokenizer.tokenAs<uint64_t>());
+            return true;
+        case UBJsonTokenType::FLOAT16_TOKEN:
+            value = T(float16ToFloat(tokenizer.tokenAs<uint16_t>()));
+            return true;
         case UBJsonTokenType::FLOAT32_TOKEN:
             value = T(tokenizer.tokenAs<float>());
             return true;
@@ -120,6 +120,17 @@ namespace Yson
         }
     }
 
+    /**
+     * @brief Skips a value of type @a contentType, or any value if
+     *  @a contentType is UNKNOWN_TOKEN.
+     */
+    bool skipToken(UBJsonTokenizer& tokenizer, UBJsonTokenType contentType)
+    {
+        if (contentType == UBJsonTokenType::UNKNOWN_TOKEN)
+            return tokenizer.skip();
+        return tokenizer.skip(contentType);
+    }
+
     void skipKeysAndComplexValues(UBJsonTokenizer& tokenizer) // NOLINT(*-no-recursion)
     {
         auto count = tokenizer.contentSize();
@@ -127,7 +138,7 @@ namespace Yson
         for (size_t i = 0; i < count; ++i)
         {
             if (!tokenizer.skip(UBJsonTokenType::STRING_TOKEN)
-                || !tokenizer.skip(contentType))
+                || !skipToken(tokenizer, contentType))
             {
                 UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(tokenizer);
             }
@@ -149,6 +160,16 @@ namespace Yson
     {
         auto count = tokenizer.contentSize();
         auto contentType = tokenizer.contentType();
+        // Fixed-size values are skipped in one go unless each of them
+        // must be counted.
+        const auto valueSize = getValueSize(contentType);
+        if (valueSize != 0 && !tokenizer.stats())
+        {
+            if (count > SIZE_MAX / valueSize)
+                UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(tokenizer);
+            tokenizer.skipBytes(count * valueSize);
+            return;
+        }
         for (size_t i = 0; i < count; ++i)
         {
             if (!tokenizer.skip(contentType))
@@ -162,7 +183,7 @@ namespace Yson
         auto contentType = tokenizer.contentType();
         for (size_t i = 0; i < count; ++i)
         {
-            if (!tokenizer.skip(contentType))
+            if (!skipToken(tokenizer, contentType))
                 UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(tokenizer);
             skipValue(tokenizer);
         }
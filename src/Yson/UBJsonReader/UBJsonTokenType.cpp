@@ -35,6 +35,10 @@ namespace Yson
         CASE_TYPE(INT64_TOKEN);
         CASE_TYPE(FLOAT32_TOKEN);
         CASE_TYPE(FLOAT64_TOKEN);
+        CASE_TYPE(UINT16_TOKEN);
+        CASE_TYPE(UINT32_TOKEN);
+        CASE_TYPE(UINT64_TOKEN);
+        CASE_TYPE(FLOAT16_TOKEN);
         CASE_TYPE(HIGH_PRECISION_TOKEN);
         CASE_TYPE(CHAR_TOKEN);
         CASE_TYPE(STRING_TOKEN);
@@ -60,4 +64,29 @@ namespace Yson
         c -= 'C';
         return 0 < c && c < sizeof(LegalTypes) && LegalTypes[c] != 0;
     }
+
+    size_t getValueSize(UBJsonTokenType type)
+    {
+        switch (type)
+        {
+        case UBJsonTokenType::INT8_TOKEN:
+        case UBJsonTokenType::UINT8_TOKEN:
+        case UBJsonTokenType::CHAR_TOKEN:
+            return 1;
+        case UBJsonTokenType::INT16_TOKEN:
+        case UBJsonTokenType::UINT16_TOKEN:
+        case UBJsonTokenType::FLOAT16_TOKEN:
+            return 2;
+        case UBJsonTokenType::INT32_TOKEN:
+        case UBJsonTokenType::UINT32_TOKEN:
+        case UBJsonTokenType::FLOAT32_TOKEN:
+            return 4;
+        case UBJsonTokenType::INT64_TOKEN:
+        case UBJsonTokenType::UINT64_TOKEN:
+        case UBJsonTokenType::FLOAT64_TOKEN:
+            return 8;
+        default:
+            return 0;
+        }
+    }
 }
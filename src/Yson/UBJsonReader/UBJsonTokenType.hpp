@@ -26,6 +26,10 @@ namespace Yson
         INT64_TOKEN = 'L',
         FLOAT32_TOKEN = 'd',
         FLOAT64_TOKEN = 'D',
+        UINT16_TOKEN = 'u',
+        UINT32_TOKEN = 'm',
+        UINT64_TOKEN = 'M',
+        FLOAT16_TOKEN = 'h',
         HIGH_PRECISION_TOKEN = 'H',
         CHAR_TOKEN = 'C',
         STRING_TOKEN = 'S',
@@ -43,4 +47,10 @@ namespace Yson
     YSON_API std::ostream& operator<<(std::ostream& stream, UBJsonTokenType type);
 
     bool isValidTokenType(char c);
+
+    /**
+     * @brief Returns the size of the values of fixed-size numeric
+     *  and character tokens, and 0 for other tokens.
+     */
+    size_t getValueSize(UBJsonTokenType type);
 }
@@ -7,7 +7,13 @@
 //****************************************************************************
 #include "UBJsonTokenizer.hpp"
 
+#include <algorithm>
 #include <cstring>
+#include <typeinfo>
+#include "Yson/ReaderStats.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
+#include "Yson/Common/DefaultBufferSize.hpp"
+#include "Yson/Common/MemoryResource.hpp"
 #include "BinaryBufferReader.hpp"
 #include "BinaryFileReader.hpp"
 #include "ThrowUBJsonReaderException.hpp"
@@ -15,20 +21,158 @@
 
 namespace Yson
 {
+    namespace
+    {
+        bool isBJDataTokenType(UBJsonTokenType type)
+        {
+            switch (type)
+            {
+            case UBJsonTokenType::UINT16_TOKEN:
+            case UBJsonTokenType::UINT32_TOKEN:
+            case UBJsonTokenType::UINT64_TOKEN:
+            case UBJsonTokenType::FLOAT16_TOKEN:
+                return true;
+            default:
+                return false;
+            }
+        }
+    }
+
     UBJsonTokenizer::UBJsonTokenizer(std::istream& stream,
                                      const char* buffer,
-                                     size_t bufferSize)
-        : m_Reader(new BinaryStreamReader(stream, buffer, bufferSize))
-    {}
+                                     size_t bufferSize,
+                                     const ReaderOptions& options)
+        : m_ChunkSize(options.chunkSize ? options.chunkSize
+                                        : getDefaultBufferSize()),
+          m_MaxTokenSize(options.maxTokenSize),
+          m_Compression(options.compression),
+          m_StreamCompression(getStreamCompression(options)),
+          m_Stats(options.stats),
+          m_MemoryResource(getMemoryResource(options.memoryResource)),
+          m_BJData(options.bjdata),
+          m_Dimensions(m_MemoryResource)
+    {
+        if (auto decompressingStream = openDecompressingStream(
+                stream, buffer, bufferSize, m_StreamCompression))
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                std::move(decompressingStream), m_ChunkSize,
+                m_MemoryResource);
+        }
+        else
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                stream, buffer, bufferSize, m_ChunkSize, m_MemoryResource);
+        }
+        m_Reader->setStats(m_Stats);
+    }
+
+    UBJsonTokenizer::UBJsonTokenizer(const std::filesystem::path& fileName,
+                                     const ReaderOptions& options)
+        : m_FileName(fileName.string()),
+          m_ChunkSize(options.chunkSize ? options.chunkSize
+                                        : getDefaultBufferSize()),
+          m_MaxTokenSize(options.maxTokenSize),
+          m_Compression(options.compression),
+          m_StreamCompression(getStreamCompression(options)),
+          m_Stats(options.stats),
+          m_MemoryResource(getMemoryResource(options.memoryResource)),
+          m_BJData(options.bjdata),
+          m_Dimensions(m_MemoryResource)
+    {
+        m_Reader = std::make_unique<BinaryFileReader>(fileName, m_ChunkSize,
+                                                      m_MemoryResource,
+                                                      m_Compression);
+        m_Reader->setStats(m_Stats);
+    }
+
+    UBJsonTokenizer::UBJsonTokenizer(const char* buffer, size_t bufferSize,
+                                     const ReaderOptions& options)
+        : m_ChunkSize(options.chunkSize ? options.chunkSize
+                                        : getDefaultBufferSize()),
+          m_MaxTokenSize(options.maxTokenSize),
+          m_Compression(options.compression),
+          m_StreamCompression(getStreamCompression(options)),
+          m_Stats(options.stats),
+          m_MemoryResource(getMemoryResource(options.memoryResource)),
+          m_BJData(options.bjdata),
+          m_Dimensions(m_MemoryResource)
+    {
+        if (auto decompressingStream = openDecompressingStream(
+                buffer, bufferSize, m_Compression))
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                std::move(decompressingStream), m_ChunkSize,
+                m_MemoryResource);
+        }
+        else
+        {
+            m_Reader = std::make_unique<BinaryBufferReader>(buffer,
+                                                            bufferSize);
+        }
+        m_Reader->setStats(m_Stats);
+    }
 
-    UBJsonTokenizer::UBJsonTokenizer(const std::filesystem::path& fileName)
-        : m_Reader(new BinaryFileReader(fileName)),
-          m_FileName(fileName.string())
-    {}
+    void UBJsonTokenizer::reset(std::istream& stream,
+                                const char* buffer,
+                                size_t bufferSize)
+    {
+        auto decompressingStream = openDecompressingStream(
+            stream, buffer, bufferSize, m_StreamCompression);
+        // BinaryFileReader is derived from BinaryStreamReader, but it owns
+        // its stream and can't be reused.
+        if (decompressingStream)
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                std::move(decompressingStream), m_ChunkSize,
+                m_MemoryResource);
+            m_Reader->setStats(m_Stats);
+        }
+        else if (m_Reader && typeid(*m_Reader) == typeid(BinaryStreamReader))
+        {
+            static_cast<BinaryStreamReader&>(*m_Reader)
+                .reset(stream, buffer, bufferSize);
+        }
+        else
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                stream, buffer, bufferSize, m_ChunkSize, m_MemoryResource);
+            m_Reader->setStats(m_Stats);
+        }
+        m_TokenType = {};
+        m_ContentSize = 0;
+        m_ContentType = {};
+        m_MarkerPosition = 0;
+        m_Dimensions.clear();
+        m_FileName.clear();
+    }
 
-    UBJsonTokenizer::UBJsonTokenizer(const char* buffer, size_t bufferSize)
-        : m_Reader(new BinaryBufferReader(buffer, bufferSize))
-    {}
+    void UBJsonTokenizer::reset(const char* buffer, size_t bufferSize)
+    {
+        auto decompressingStream = openDecompressingStream(
+            buffer, bufferSize, m_Compression);
+        if (decompressingStream)
+        {
+            m_Reader = std::make_unique<BinaryStreamReader>(
+                std::move(decompressingStream), m_ChunkSize,
+                m_MemoryResource);
+        }
+        else if (auto reader = dynamic_cast<BinaryBufferReader*>(m_Reader.get()))
+        {
+            reader->reset(buffer, bufferSize);
+        }
+        else
+        {
+            m_Reader = std::make_unique<BinaryBufferReader>(buffer, bufferSize);
+        }
+        m_Reader->setStats(m_Stats);
+        m_TokenType = {};
+        m_ContentSize = 0;
+        m_ContentType = {};
+        m_MarkerPosition = 0;
+        m_Dimensions.clear();
+        m_FileName.clear();
+    }
 
     size_t UBJsonTokenizer::contentSize() const
     {
@@ -40,6 +184,11 @@ namespace Yson
         return m_ContentType;
     }
 
+    std::span<const size_t> UBJsonTokenizer::dimensions() const
+    {
+        return m_Dimensions;
+    }
+
     std::string UBJsonTokenizer::fileName() const
     {
         return m_FileName;
@@ -51,12 +200,22 @@ namespace Yson
         {
             if (!m_Reader->read(1))
                 return false;
+            m_MarkerPosition = m_Reader->position();
             if (next(static_cast<UBJsonTokenType>(m_Reader->front())))
                 return true;
         }
     }
 
     bool UBJsonTokenizer::next(UBJsonTokenType tokenType) // NOLINT(*-no-recursion)
+    {
+        if (!readToken(tokenType))
+            return false;
+        if (m_Stats)
+            countToken();
+        return true;
+    }
+
+    bool UBJsonTokenizer::readToken(UBJsonTokenType tokenType) // NOLINT(*-no-recursion)
     {
         m_TokenType = tokenType;
         m_ContentSize = 0;
@@ -68,25 +227,22 @@ namespace Yson
                 return true;
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
         case UBJsonTokenType::INT16_TOKEN:
-            if (m_Reader->read(2))
-                return true;
-            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            return readValue(2);
         case UBJsonTokenType::INT32_TOKEN:
-            if (m_Reader->read(4))
-                return true;
-            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            return readValue(4);
         case UBJsonTokenType::INT64_TOKEN:
-            if (m_Reader->read(8))
-                return true;
-            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            return readValue(8);
         case UBJsonTokenType::FLOAT32_TOKEN:
-            if (m_Reader->read(4))
-                return true;
-            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            return readValue(4);
         case UBJsonTokenType::FLOAT64_TOKEN:
-            if (m_Reader->read(8))
-                return true;
-            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            return readValue(8);
+        case UBJsonTokenType::UINT16_TOKEN:
+        case UBJsonTokenType::UINT32_TOKEN:
+        case UBJsonTokenType::UINT64_TOKEN:
+        case UBJsonTokenType::FLOAT16_TOKEN:
+            if (!m_BJData)
+                UBJSON_READER_UNEXPECTED_TOKEN(*this);
+            return readValue(getValueSize(tokenType));
         case UBJsonTokenType::CHAR_TOKEN:
             if (m_Reader->read(1))
                 return true;
@@ -117,6 +273,7 @@ namespace Yson
         case UBJsonTokenType::START_OBJECT_TOKEN:
         case UBJsonTokenType::START_ARRAY_TOKEN:
             {
+                m_Dimensions.clear();
                 char value;
                 if (!m_Reader->peek(&value))
                     UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
@@ -130,10 +287,11 @@ namespace Yson
                         "Optimized object or array doesn't specify length.",
                         *this);
                     m_ContentType = static_cast<UBJsonTokenType>(data[1]);
-                    if (!next())
-                        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
-                    m_ContentSize = convertInteger<size_t>(m_TokenType,
-                                                           m_Reader->data());
+                    if (!m_BJData && isBJDataTokenType(m_ContentType))
+                        UBJSON_READER_THROW(
+                            "Unexpected value type in optimized object or array: "
+                            + toString(m_ContentType) + ".", *this);
+                    readContainerSize(tokenType);
                     m_TokenType =
                         tokenType == UBJsonTokenType::START_ARRAY_TOKEN
                             ? UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
@@ -142,11 +300,8 @@ namespace Yson
                 else if (value == '#')
                 {
                     m_Reader->read(1);
-                    if (!next())
-                        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
                     m_ContentType = UBJsonTokenType::UNKNOWN_TOKEN;
-                    m_ContentSize = convertInteger<size_t>(m_TokenType,
-                                                           m_Reader->data());
+                    readContainerSize(tokenType);
                     m_TokenType =
                         tokenType == UBJsonTokenType::START_ARRAY_TOKEN
                             ? UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
@@ -166,7 +321,6 @@ namespace Yson
     bool UBJsonTokenizer::read(void* buffer, size_t size,
                                UBJsonTokenType tokenType)
     {
-        size_t unitSize;
         switch (tokenType)
         {
         case UBJsonTokenType::NULL_TOKEN:
@@ -178,30 +332,32 @@ namespace Yson
         case UBJsonTokenType::FALSE_TOKEN:
             memset(buffer, 'F', size);
             return true;
-        case UBJsonTokenType::INT8_TOKEN:
-        case UBJsonTokenType::UINT8_TOKEN:
-        case UBJsonTokenType::CHAR_TOKEN:
-            unitSize = 1;
-            break;
-        case UBJsonTokenType::INT16_TOKEN:
-            unitSize = 2;
-            break;
-        case UBJsonTokenType::INT32_TOKEN:
-        case UBJsonTokenType::FLOAT32_TOKEN:
-            unitSize = 4;
-            break;
-        case UBJsonTokenType::INT64_TOKEN:
-        case UBJsonTokenType::FLOAT64_TOKEN:
-            unitSize = 8;
-            break;
         default:
+            break;
+        }
+        const auto unitSize = getValueSize(tokenType);
+        if (unitSize == 0)
             return false;
+        if (m_BJData)
+        {
+            if (!m_Reader->read(buffer, size, 1))
+                UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            fromLittleEndian(size, static_cast<char*>(buffer), unitSize);
+            return true;
         }
         if (m_Reader->read(buffer, size, unitSize))
             return true;
         UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
     }
 
+    bool UBJsonTokenizer::readBytes(size_t size)
+    {
+        assertTokenSizeIsWithinLimit(size);
+        if (m_Reader->read(size))
+            return true;
+        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+    }
+
     bool UBJsonTokenizer::skip()
     {
         while (true)
@@ -214,6 +370,22 @@ namespace Yson
     }
 
     bool UBJsonTokenizer::skip(UBJsonTokenType tokenType)
+    {
+        if (!skipToken(tokenType))
+            return false;
+        if (m_Stats)
+            countToken();
+        return true;
+    }
+
+    bool UBJsonTokenizer::skipBytes(size_t size)
+    {
+        if (m_Reader->advance(size))
+            return true;
+        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+    }
+
+    bool UBJsonTokenizer::skipToken(UBJsonTokenType tokenType)
     {
         m_TokenType = tokenType;
         m_ContentSize = 0;
@@ -244,6 +416,15 @@ namespace Yson
             if (m_Reader->advance(8))
                 return true;
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+        case UBJsonTokenType::UINT16_TOKEN:
+        case UBJsonTokenType::UINT32_TOKEN:
+        case UBJsonTokenType::UINT64_TOKEN:
+        case UBJsonTokenType::FLOAT16_TOKEN:
+            if (!m_BJData)
+                UBJSON_READER_UNEXPECTED_TOKEN(*this);
+            if (m_Reader->advance(getValueSize(tokenType)))
+                return true;
+            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
         case UBJsonTokenType::CHAR_TOKEN:
             if (m_Reader->advance(1))
                 return true;
@@ -274,6 +455,7 @@ namespace Yson
         case UBJsonTokenType::START_OBJECT_TOKEN:
         case UBJsonTokenType::START_ARRAY_TOKEN:
             {
+                m_Dimensions.clear();
                 char value;
                 if (!m_Reader->peek(&value))
                     UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
@@ -287,10 +469,11 @@ namespace Yson
                         "Optimized object or array doesn't specify length.",
                         *this);
                     m_ContentType = static_cast<UBJsonTokenType>(data[1]);
-                    if (!next())
-                        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
-                    m_ContentSize = convertInteger<size_t>(m_TokenType,
-                                                           m_Reader->data());
+                    if (!m_BJData && isBJDataTokenType(m_ContentType))
+                        UBJSON_READER_THROW(
+                            "Unexpected value type in optimized object or array: "
+                            + toString(m_ContentType) + ".", *this);
+                    readContainerSize(tokenType);
                     m_TokenType =
                         tokenType == UBJsonTokenType::START_ARRAY_TOKEN
                             ? UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
@@ -299,11 +482,8 @@ namespace Yson
                 else if (value == '#')
                 {
                     m_Reader->read(1);
-                    if (!next())
-                        UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
                     m_ContentType = UBJsonTokenType::UNKNOWN_TOKEN;
-                    m_ContentSize = convertInteger<size_t>(m_TokenType,
-                                                           m_Reader->data());
+                    readContainerSize(tokenType);
                     m_TokenType =
                         tokenType == UBJsonTokenType::START_ARRAY_TOKEN
                             ? UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN
@@ -325,6 +505,43 @@ namespace Yson
         return m_Reader->position();
     }
 
+    size_t UBJsonTokenizer::markerPosition() const
+    {
+        return m_MarkerPosition;
+    }
+
+    void UBJsonTokenizer::seek(size_t position)
+    {
+        if (!m_Reader->seek(position))
+            UBJSON_READER_THROW("Unable to move to position "
+                                + std::to_string(position) + ".", *this);
+        m_TokenType = {};
+        m_ContentSize = 0;
+        m_ContentType = {};
+        m_MarkerPosition = position;
+        m_Dimensions.clear();
+    }
+
+    bool UBJsonTokenizer::isBJData() const
+    {
+        return m_BJData;
+    }
+
+    size_t UBJsonTokenizer::maxTokenSize() const
+    {
+        return m_MaxTokenSize;
+    }
+
+    ReaderStats* UBJsonTokenizer::stats() const
+    {
+        return m_Stats;
+    }
+
+    std::pmr::memory_resource* UBJsonTokenizer::memoryResource() const
+    {
+        return m_MemoryResource;
+    }
+
     std::string_view UBJsonTokenizer::token() const
     {
         return {
@@ -348,20 +565,157 @@ namespace Yson
         return m_TokenType;
     }
 
+    bool UBJsonTokenizer::readCount() // NOLINT(*-no-recursion)
+    {
+        // Reads the size of a string or optimized object or array without
+        // counting it as a value token.
+        return m_Reader->read(1)
+               && readToken(static_cast<UBJsonTokenType>(m_Reader->front()));
+    }
+
+    bool UBJsonTokenizer::readValue(size_t size)
+    {
+        if (!m_Reader->read(size))
+            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+        return true;
+    }
+
+    void UBJsonTokenizer::readContainerSize(UBJsonTokenType tokenType) // NOLINT(*-no-recursion)
+    {
+        char c;
+        if (m_BJData && tokenType == UBJsonTokenType::START_ARRAY_TOKEN
+            && m_Reader->peek(&c) && c == '[')
+        {
+            m_Reader->read(1);
+            readDimensions();
+            size_t size = 1;
+            for (auto dimension : m_Dimensions)
+            {
+                if (dimension != 0 && size > SIZE_MAX / dimension)
+                    UBJSON_READER_THROW("Array dimensions are too large.",
+                                        *this);
+                size *= dimension;
+            }
+            m_ContentSize = size;
+        }
+        else
+        {
+            if (!readCount())
+                UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            m_ContentSize = convertInteger<size_t>(m_TokenType, tokenData(),
+                                                   m_BJData);
+            m_Dimensions.push_back(m_ContentSize);
+        }
+    }
+
+    void UBJsonTokenizer::readDimensions() // NOLINT(*-no-recursion)
+    {
+        // The dimension vector is an array of integers, optionally
+        // optimized, whose opening '[' has already been read.
+        char c;
+        if (!m_Reader->peek(&c))
+            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+        if (c != '$' && c != '#')
+        {
+            while (true)
+            {
+                if (!m_Reader->read(1))
+                    UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+                if (m_Reader->front() == ']')
+                    return;
+                readToken(static_cast<UBJsonTokenType>(m_Reader->front()));
+                m_Dimensions.push_back(
+                    convertInteger<size_t>(m_TokenType, tokenData(),
+                                           m_BJData));
+            }
+        }
+
+        auto type = UBJsonTokenType::UNKNOWN_TOKEN;
+        if (c == '$')
+        {
+            if (!m_Reader->read(3))
+                UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            auto data = static_cast<const char*>(m_Reader->data());
+            if (data[2] != '#')
+                UBJSON_READER_THROW("Dimension vector doesn't specify length.",
+                                    *this);
+            type = static_cast<UBJsonTokenType>(data[1]);
+        }
+        else
+        {
+            m_Reader->read(1);
+        }
+
+        if (!readCount())
+            UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+        const auto count = convertInteger<size_t>(m_TokenType, tokenData(),
+                                                  m_BJData);
+        for (size_t i = 0; i < count; ++i)
+        {
+            if (type == UBJsonTokenType::UNKNOWN_TOKEN)
+            {
+                if (!readCount())
+                    UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            }
+            else if (!readToken(type))
+            {
+                UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
+            }
+            m_Dimensions.push_back(
+                convertInteger<size_t>(m_TokenType, tokenData(), m_BJData));
+        }
+    }
+
+    void UBJsonTokenizer::countToken() const
+    {
+        switch (m_TokenType)
+        {
+        case UBJsonTokenType::START_OBJECT_TOKEN:
+        case UBJsonTokenType::START_OPTIMIZED_OBJECT_TOKEN:
+            ++m_Stats->objectTokens;
+            break;
+        case UBJsonTokenType::START_ARRAY_TOKEN:
+        case UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN:
+            ++m_Stats->arrayTokens;
+            break;
+        case UBJsonTokenType::STRING_TOKEN:
+            ++m_Stats->stringTokens;
+            break;
+        case UBJsonTokenType::END_OBJECT_TOKEN:
+        case UBJsonTokenType::END_ARRAY_TOKEN:
+        case UBJsonTokenType::NO_OP_TOKEN:
+            break;
+        default:
+            ++m_Stats->valueTokens;
+            break;
+        }
+    }
+
     void UBJsonTokenizer::readSizedToken() // NOLINT(*-no-recursion)
     {
-        if (!next())
+        if (!readCount())
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
-        auto size = convertInteger<size_t>(m_TokenType, m_Reader->data());
+        auto size = convertInteger<size_t>(m_TokenType, tokenData(), m_BJData);
+        assertTokenSizeIsWithinLimit(size);
         if (!m_Reader->read(size))
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
     }
 
+    void UBJsonTokenizer::assertTokenSizeIsWithinLimit(size_t size) const
+    {
+        if (m_MaxTokenSize != 0 && size > m_MaxTokenSize)
+        {
+            UBJSON_READER_THROW("Token is longer than the maximum token size ("
+                                + std::to_string(m_MaxTokenSize) + " bytes).",
+                                *this);
+        }
+    }
+
     void UBJsonTokenizer::skipSizedToken()
     {
-        if (!next())
+        if (!readCount())
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
-        auto size = convertInteger<size_t>(m_TokenType, m_Reader->data());
+        auto size = convertInteger<size_t>(m_TokenType, tokenData(), m_BJData);
         if (!m_Reader->advance(size))
             UBJSON_READER_UNEXPECTED_END_OF_DOCUMENT(*this);
     }
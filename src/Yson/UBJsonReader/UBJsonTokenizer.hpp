@@ -10,8 +10,12 @@
 #include <filesystem>
 #include <iosfwd>
 #include <memory>
+#include <memory_resource>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
+#include "Yson/ReaderOptions.hpp"
 #include "Yson/YsonDefinitions.hpp"
 #include "BinaryReader.hpp"
 #include "FromBigEndian.hpp"
@@ -24,11 +28,14 @@ namespace Yson
     public:
         explicit UBJsonTokenizer(std::istream& stream,
                                  const char* buffer = nullptr,
-                                 size_t bufferSize = 0);
+                                 size_t bufferSize = 0,
+                                 const ReaderOptions& options = {});
 
-        explicit UBJsonTokenizer(const std::filesystem::path& fileName);
+        explicit UBJsonTokenizer(const std::filesystem::path& fileName,
+                                 const ReaderOptions& options = {});
 
-        UBJsonTokenizer(const char* buffer, size_t bufferSize);
+        UBJsonTokenizer(const char* buffer, size_t bufferSize,
+                        const ReaderOptions& options = {});
 
         [[nodiscard]]
         size_t contentSize() const;
@@ -36,6 +43,17 @@ namespace Yson
         [[nodiscard]]
         UBJsonTokenType contentType() const;
 
+        /**
+         * @brief Returns the dimensions of the current optimized object
+         *  or array.
+         *
+         * A BJData array with a dimension vector has one entry per
+         * dimension, other optimized objects and arrays have a single
+         * entry, the number of values.
+         */
+        [[nodiscard]]
+        std::span<const size_t> dimensions() const;
+
         [[nodiscard]]
         std::string fileName() const;
 
@@ -45,13 +63,80 @@ namespace Yson
 
         bool read(void* buffer, size_t size, UBJsonTokenType tokenType);
 
+        /**
+         * @brief Reads the next @a size bytes of the input, which then
+         *  are returned by token() and tokenData().
+         *
+         * @throw YsonReaderException if @a size exceeds the maximum
+         *  token size.
+         */
+        bool readBytes(size_t size);
+
         bool skip();
 
         bool skip(UBJsonTokenType tokenType);
 
+        /**
+         * @brief Skips the next @a size bytes of the input without
+         *  reading them.
+         */
+        bool skipBytes(size_t size);
+
         [[nodiscard]]
         size_t position() const;
 
+        /**
+         * @brief Returns the position of the type marker of the token
+         *  most recently read by next() without a token type.
+         */
+        [[nodiscard]]
+        size_t markerPosition() const;
+
+        /**
+         * @brief Moves to @a position in the input, the next token is
+         *  read from there.
+         *
+         * @throw YsonReaderException if the input doesn't support
+         *  seeking, e.g. if it is compressed.
+         */
+        void seek(size_t position);
+
+        /**
+         * @brief Returns true if the input is read as BJData.
+         *
+         * Tokens and payloads are returned in the byte order of the
+         * input, i.e. little-endian in BJData mode. tokenAs() converts
+         * numeric tokens to native byte order in both modes.
+         */
+        [[nodiscard]]
+        bool isBJData() const;
+
+        /**
+         * @brief Returns the maximum token size from the ReaderOptions,
+         *  0 means there is no limit.
+         */
+        [[nodiscard]]
+        size_t maxTokenSize() const;
+
+        /**
+         * @brief Returns the counters from the ReaderOptions, or nullptr.
+         */
+        [[nodiscard]]
+        ReaderStats* stats() const;
+
+        /**
+         * @brief Returns the memory resource from the ReaderOptions, or
+         *  the default resource.
+         */
+        [[nodiscard]]
+        std::pmr::memory_resource* memoryResource() const;
+
+        void reset(std::istream& stream,
+                   const char* buffer = nullptr,
+                   size_t bufferSize = 0);
+
+        void reset(const char* buffer, size_t bufferSize);
+
         [[nodiscard]]
         const void* tokenData() const;
 
@@ -68,13 +153,36 @@ namespace Yson
         T tokenAs() const
         {
             assert(tokenSize() == sizeof(T));
-            T tmp = *static_cast<const T*>(tokenData());
             T result;
-            fromBigEndian<sizeof(T)>(reinterpret_cast<char*>(&result),
-                                     reinterpret_cast<const char*>(&tmp));
+            if (m_BJData)
+            {
+                fromLittleEndian<sizeof(T)>(&result, tokenData());
+            }
+            else
+            {
+                T tmp = *static_cast<const T*>(tokenData());
+                fromBigEndian<sizeof(T)>(reinterpret_cast<char*>(&result),
+                                         reinterpret_cast<const char*>(&tmp));
+            }
             return result;
         }
     private:
+        bool readToken(UBJsonTokenType tokenType);
+
+        bool skipToken(UBJsonTokenType tokenType);
+
+        bool readCount();
+
+        bool readValue(size_t size);
+
+        void readContainerSize(UBJsonTokenType tokenType);
+
+        void readDimensions();
+
+        void countToken() const;
+
+        void assertTokenSizeIsWithinLimit(size_t size) const;
+
         void readSizedToken();
 
         void skipSizedToken();
@@ -84,5 +192,14 @@ namespace Yson
         size_t m_ContentSize = 0;
         UBJsonTokenType m_ContentType = {};
         std::string m_FileName;
+        size_t m_ChunkSize;
+        size_t m_MaxTokenSize;
+        Compression m_Compression;
+        Compression m_StreamCompression;
+        ReaderStats* m_Stats;
+        std::pmr::memory_resource* m_MemoryResource;
+        bool m_BJData;
+        size_t m_MarkerPosition = 0;
+        std::pmr::vector<size_t> m_Dimensions;
     };
 }
@@ -15,23 +15,37 @@ namespace Yson
 {
     template <typename T, typename U,
               typename std::enable_if<sizeof(U) == 1, int>::type = 0>
-    T convertIntegerImpl(const void* value)
+    T convertIntegerImpl(const void* value, bool /*littleEndian*/)
     {
         return static_cast<T>(*static_cast<const U*>(value));
     }
 
     template <typename T, typename U,
               typename std::enable_if<sizeof(U) != 1, int>::type = 0>
-    T convertIntegerImpl(const void* value)
+    T convertIntegerImpl(const void* value, bool littleEndian)
     {
-        U tmp = *static_cast<const U*>(value);
         U result;
-        fromBigEndian<sizeof(U)>(&result, &tmp);
+        if (littleEndian)
+        {
+            fromLittleEndian<sizeof(U)>(&result, value);
+        }
+        else
+        {
+            U tmp = *static_cast<const U*>(value);
+            fromBigEndian<sizeof(U)>(&result, &tmp);
+        }
         return static_cast<T>(result);
     }
 
+    /**
+     * @brief Converts the integer of type @a type at @a value to T.
+     *
+     * @param littleEndian True if the integer is in BJData's little-endian
+     *  byte order rather than UBJSON's big-endian.
+     */
     template <typename T>
-    T convertInteger(UBJsonTokenType type, const void* value)
+    T convertInteger(UBJsonTokenType type, const void* value,
+                     bool littleEndian = false)
     {
         switch (type)
         {
@@ -41,17 +55,23 @@ namespace Yson
         case UBJsonTokenType::TRUE_TOKEN:
             return 1;
         case UBJsonTokenType::INT8_TOKEN:
-            return convertIntegerImpl<T, int8_t>(value);
+            return convertIntegerImpl<T, int8_t>(value, littleEndian);
         case UBJsonTokenType::UINT8_TOKEN:
-            return convertIntegerImpl<T, uint8_t>(value);
+            return convertIntegerImpl<T, uint8_t>(value, littleEndian);
         case UBJsonTokenType::INT16_TOKEN:
-            return convertIntegerImpl<T, int16_t>(value);
+            return convertIntegerImpl<T, int16_t>(value, littleEndian);
         case UBJsonTokenType::INT32_TOKEN:
-            return convertIntegerImpl<T, int32_t>(value);
+            return convertIntegerImpl<T, int32_t>(value, littleEndian);
         case UBJsonTokenType::INT64_TOKEN:
-            return convertIntegerImpl<T, int64_t>(value);
+            return convertIntegerImpl<T, int64_t>(value, littleEndian);
+        case UBJsonTokenType::UINT16_TOKEN:
+            return convertIntegerImpl<T, uint16_t>(value, littleEndian);
+        case UBJsonTokenType::UINT32_TOKEN:
+            return convertIntegerImpl<T, uint32_t>(value, littleEndian);
+        case UBJsonTokenType::UINT64_TOKEN:
+            return convertIntegerImpl<T, uint64_t>(value, littleEndian);
         case UBJsonTokenType::CHAR_TOKEN:
-            return convertIntegerImpl<T, char>(value);
+            return convertIntegerImpl<T, char>(value, littleEndian);
         default:
             break;
         }
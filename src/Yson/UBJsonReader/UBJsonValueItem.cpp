@@ -10,6 +10,7 @@
 #include "Yson/YsonException.hpp"
 #include "Yson/Common/AssignInteger.hpp"
 #include "Yson/Common/Base64.hpp"
+#include "Yson/Common/Float16.hpp"
 #include "Yson/Common/GetValueType.hpp"
 #include "Yson/Common/ParseFloatingPoint.hpp"
 #include "Yson/Common/ParseInteger.hpp"
@@ -21,19 +22,27 @@ namespace Yson
     namespace
     {
         template <typename T>
-        T getNativeValue(std::string_view data)
+        T getNativeValue(std::string_view data, bool littleEndian)
         {
             assert(data.size() == sizeof(T));
-            T tmp = *reinterpret_cast<const T*>(data.data());
             T result;
-            fromBigEndian<sizeof(T)>(reinterpret_cast<char*>(&result),
-                                     reinterpret_cast<const char*>(&tmp));
+            if (littleEndian)
+            {
+                fromLittleEndian<sizeof(T)>(&result, data.data());
+            }
+            else
+            {
+                T tmp = *reinterpret_cast<const T*>(data.data());
+                fromBigEndian<sizeof(T)>(reinterpret_cast<char*>(&result),
+                                         reinterpret_cast<const char*>(&tmp));
+            }
             return result;
         }
 
         template <typename T>
         bool setIntegerValue(T& value,
                              UBJsonTokenType type,
+                             int64_t integer,
                              std::string_view data)
         {
             switch (type)
@@ -49,15 +58,15 @@ namespace Yson
                 return true;
             case UBJsonTokenType::CHAR_TOKEN:
             case UBJsonTokenType::INT8_TOKEN:
-                return assignInteger(value, getNativeValue<int8_t>(data));
             case UBJsonTokenType::UINT8_TOKEN:
-                return assignInteger(value, getNativeValue<uint8_t>(data));
             case UBJsonTokenType::INT16_TOKEN:
-                return assignInteger(value, getNativeValue<int16_t>(data));
             case UBJsonTokenType::INT32_TOKEN:
-                return assignInteger(value, getNativeValue<int32_t>(data));
             case UBJsonTokenType::INT64_TOKEN:
-                return assignInteger(value, getNativeValue<int64_t>(data));
+            case UBJsonTokenType::UINT16_TOKEN:
+            case UBJsonTokenType::UINT32_TOKEN:
+                return assignInteger(value, integer);
+            case UBJsonTokenType::UINT64_TOKEN:
+                return assignInteger(value, static_cast<uint64_t>(integer));
             case UBJsonTokenType::STRING_TOKEN:
                 return parse(data, value, true);
             default:
@@ -68,6 +77,8 @@ namespace Yson
         template <typename T>
         bool setFloatingPointValue(T& value,
                                    UBJsonTokenType type,
+                                   int64_t integer,
+                                   double floatingPoint,
                                    std::string_view data)
         {
             switch (type)
@@ -83,25 +94,21 @@ namespace Yson
                 return true;
             case UBJsonTokenType::CHAR_TOKEN:
             case UBJsonTokenType::INT8_TOKEN:
-                value = T(getNativeValue<int8_t>(data));
-                return true;
             case UBJsonTokenType::UINT8_TOKEN:
-                value = T(getNativeValue<uint8_t>(data));
-                return true;
             case UBJsonTokenType::INT16_TOKEN:
-                value = T(getNativeValue<int16_t>(data));
-                return true;
             case UBJsonTokenType::INT32_TOKEN:
-                value = T(getNativeValue<int32_t>(data));
-                return true;
             case UBJsonTokenType::INT64_TOKEN:
-                value = T(getNativeValue<int64_t>(data));
+            case UBJsonTokenType::UINT16_TOKEN:
+            case UBJsonTokenType::UINT32_TOKEN:
+                value = T(integer);
                 return true;
-            case UBJsonTokenType::FLOAT32_TOKEN:
-                value = T(getNativeValue<float>(data));
+            case UBJsonTokenType::UINT64_TOKEN:
+                value = T(static_cast<uint64_t>(integer));
                 return true;
+            case UBJsonTokenType::FLOAT16_TOKEN:
+            case UBJsonTokenType::FLOAT32_TOKEN:
             case UBJsonTokenType::FLOAT64_TOKEN:
-                value = T(getNativeValue<double>(data));
+                value = T(floatingPoint);
                 return true;
             case UBJsonTokenType::STRING_TOKEN:
             case UBJsonTokenType::HIGH_PRECISION_TOKEN:
@@ -112,11 +119,69 @@ namespace Yson
         }
     }
 
-    UBJsonValueItem::UBJsonValueItem(std::string value, UBJsonTokenType type)
-        : m_Value(std::move(value)),
-          m_Type(type)
+    UBJsonValueItem::UBJsonValueItem(std::string value,
+                                     UBJsonTokenType type,
+                                     UBJsonTokenType contentType,
+                                     bool littleEndian)
+        : UBJsonValueItem(std::pmr::string(value), type, contentType,
+                          littleEndian)
     {}
 
+    UBJsonValueItem::UBJsonValueItem(std::pmr::string value,
+                                     UBJsonTokenType type,
+                                     UBJsonTokenType contentType,
+                                     bool littleEndian)
+        : m_Value(value.get_allocator()),
+          m_Type(type),
+          m_ContentType(contentType)
+    {
+        switch (m_Type)
+        {
+        case UBJsonTokenType::CHAR_TOKEN:
+            // get(std::string&) returns chars as strings.
+            m_Value = value;
+            [[fallthrough]];
+        case UBJsonTokenType::INT8_TOKEN:
+            m_Integer = getNativeValue<int8_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::UINT8_TOKEN:
+            m_Integer = getNativeValue<uint8_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::INT16_TOKEN:
+            m_Integer = getNativeValue<int16_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::INT32_TOKEN:
+            m_Integer = getNativeValue<int32_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::INT64_TOKEN:
+            m_Integer = getNativeValue<int64_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::UINT16_TOKEN:
+            m_Integer = getNativeValue<uint16_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::UINT32_TOKEN:
+            m_Integer = getNativeValue<uint32_t>(value, littleEndian);
+            break;
+        case UBJsonTokenType::UINT64_TOKEN:
+            // Values greater than INT64_MAX are stored as negative numbers.
+            m_Integer = int64_t(getNativeValue<uint64_t>(value, littleEndian));
+            break;
+        case UBJsonTokenType::FLOAT16_TOKEN:
+            m_FloatingPoint = float16ToFloat(
+                getNativeValue<uint16_t>(value, littleEndian));
+            break;
+        case UBJsonTokenType::FLOAT32_TOKEN:
+            m_FloatingPoint = getNativeValue<float>(value, littleEndian);
+            break;
+        case UBJsonTokenType::FLOAT64_TOKEN:
+            m_FloatingPoint = getNativeValue<double>(value, littleEndian);
+            break;
+        default:
+            m_Value = std::move(value);
+            break;
+        }
+    }
+
     ValueType UBJsonValueItem::valueType() const
     {
         return valueType(false);
@@ -136,8 +201,12 @@ namespace Yson
         case UBJsonTokenType::INT16_TOKEN:
         case UBJsonTokenType::INT32_TOKEN:
         case UBJsonTokenType::INT64_TOKEN:
+        case UBJsonTokenType::UINT16_TOKEN:
+        case UBJsonTokenType::UINT32_TOKEN:
+        case UBJsonTokenType::UINT64_TOKEN:
         case UBJsonTokenType::CHAR_TOKEN:
             return ValueType::INTEGER;
+        case UBJsonTokenType::FLOAT16_TOKEN:
         case UBJsonTokenType::FLOAT32_TOKEN:
         case UBJsonTokenType::FLOAT64_TOKEN:
         case UBJsonTokenType::HIGH_PRECISION_TOKEN:
@@ -177,62 +246,65 @@ namespace Yson
 
     bool UBJsonValueItem::get(int8_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(int16_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(int32_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(int64_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(uint8_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(uint16_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(uint32_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(uint64_t& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(float& value) const
     {
-        return setFloatingPointValue(value, m_Type, m_Value);
+        return setFloatingPointValue(value, m_Type, m_Integer,
+                                     m_FloatingPoint, m_Value);
     }
 
     bool UBJsonValueItem::get(double& value) const
     {
-        return setFloatingPointValue(value, m_Type, m_Value);
+        return setFloatingPointValue(value, m_Type, m_Integer,
+                                     m_FloatingPoint, m_Value);
     }
 
     bool UBJsonValueItem::get(long double& value) const
     {
-        return setFloatingPointValue(value, m_Type, m_Value);
+        return setFloatingPointValue(value, m_Type, m_Integer,
+                                     m_FloatingPoint, m_Value);
     }
 
     bool UBJsonValueItem::get(char& value) const
     {
-        return setIntegerValue(value, m_Type, m_Value);
+        return setIntegerValue(value, m_Type, m_Integer, m_Value);
     }
 
     bool UBJsonValueItem::get(std::string& value) const
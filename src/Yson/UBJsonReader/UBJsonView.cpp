@@ -0,0 +1,546 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/UBJsonView.hpp"
+
+#include <string>
+#include "Yson/Common/AssignInteger.hpp"
+#include "FromBigEndian.hpp"
+#include "UBJsonTokenizerUtilities.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        [[noreturn]]
+        void throwEndOfData()
+        {
+            YSON_THROW("Unexpected end of UBJSON data.");
+        }
+
+        void checkSize(const char* pos, const char* end, size_t size)
+        {
+            if (pos > end || size_t(end - pos) < size)
+                throwEndOfData();
+        }
+
+        size_t getFixedSize(UBJsonValueType valueType)
+        {
+            switch (valueType)
+            {
+            case UBJsonValueType::UINT_16:
+            case UBJsonValueType::UINT_32:
+            case UBJsonValueType::UINT_64:
+            case UBJsonValueType::FLOAT_16:
+                // BJData isn't supported.
+                return 0;
+            default:
+                return getValueSize(static_cast<UBJsonTokenType>(valueType));
+            }
+        }
+
+        bool isIntegerType(UBJsonValueType valueType)
+        {
+            switch (valueType)
+            {
+            case UBJsonValueType::INT_8:
+            case UBJsonValueType::UINT_8:
+            case UBJsonValueType::INT_16:
+            case UBJsonValueType::INT_32:
+            case UBJsonValueType::INT_64:
+                return true;
+            default:
+                return false;
+            }
+        }
+
+        bool hasNoPayload(UBJsonValueType valueType)
+        {
+            return valueType == UBJsonValueType::NULL_VALUE
+                   || valueType == UBJsonValueType::TRUE_VALUE
+                   || valueType == UBJsonValueType::FALSE_VALUE;
+        }
+
+        UBJsonValueType readMarker(const char*& pos, const char* end)
+        {
+            // Skip no-ops.
+            while (pos != end && *pos == 'N')
+                ++pos;
+            checkSize(pos, end, 1);
+            return static_cast<UBJsonValueType>(*pos++);
+        }
+
+        int64_t readInteger(const char*& pos, const char* end,
+                            UBJsonValueType valueType)
+        {
+            const auto size = getFixedSize(valueType);
+            checkSize(pos, end, size);
+            const auto value = convertInteger<int64_t>(
+                static_cast<UBJsonTokenType>(valueType), pos);
+            pos += size;
+            return value;
+        }
+
+        size_t readLength(const char*& pos, const char* end)
+        {
+            const auto valueType = readMarker(pos, end);
+            if (!isIntegerType(valueType))
+                YSON_THROW("Invalid length marker in UBJSON data: "
+                           + toString(valueType));
+            const auto length = readInteger(pos, end, valueType);
+            if (length < 0)
+                YSON_THROW("Negative length in UBJSON data.");
+            return size_t(length);
+        }
+
+        std::string_view readString(const char*& pos, const char* end)
+        {
+            const auto length = readLength(pos, end);
+            checkSize(pos, end, length);
+            std::string_view result(pos, length);
+            pos += length;
+            return result;
+        }
+
+        /**
+         * @brief Reads the optional value type and count at the start of
+         *  an array or object.
+         *
+         * @return The position of the first value.
+         */
+        const char* readStructureHeader(const char* pos, const char* end,
+                                        UBJsonValueType& valueType,
+                                        int64_t& size)
+        {
+            valueType = UBJsonValueType::UNKNOWN;
+            size = -1;
+            if (pos != end && *pos == '$')
+            {
+                checkSize(pos, end, 3);
+                valueType = static_cast<UBJsonValueType>(pos[1]);
+                if (pos[2] != '#')
+                    YSON_THROW("Optimized object or array doesn't specify"
+                               " length.");
+                pos += 2;
+            }
+            if (pos != end && *pos == '#')
+            {
+                ++pos;
+                size = int64_t(readLength(pos, end));
+                // Every value takes up at least its fixed size, or one
+                // byte for its marker if there is no value type.
+                const auto minValueSize = valueType == UBJsonValueType::UNKNOWN
+                                          ? 1 : getFixedSize(valueType);
+                if (minValueSize != 0)
+                {
+                    if (uint64_t(size) > SIZE_MAX / minValueSize)
+                        throwEndOfData();
+                    checkSize(pos, end, size_t(size) * minValueSize);
+                }
+            }
+            return pos;
+        }
+
+        const char* skipValue(const char* payload, const char* end,
+                              UBJsonValueType valueType);
+
+        const char* skipStructure(const char* payload, const char* end,
+                                  UBJsonValueType structureType)
+        {
+            const auto isObject = structureType == UBJsonValueType::OBJECT;
+            const auto endMarker = isObject ? '}' : ']';
+            UBJsonValueType valueType;
+            int64_t size;
+            auto pos = readStructureHeader(payload, end, valueType, size);
+
+            if (!isObject && size >= 0)
+            {
+                if (hasNoPayload(valueType))
+                    return pos;
+                // readStructureHeader has checked that the values fit.
+                if (const auto valueSize = getFixedSize(valueType))
+                    return pos + size * valueSize;
+            }
+
+            for (int64_t i = 0; size < 0 || i < size; ++i)
+            {
+                if (size < 0)
+                {
+                    while (pos != end && *pos == 'N')
+                        ++pos;
+                    checkSize(pos, end, 1);
+                    if (*pos == endMarker)
+                        return pos + 1;
+                }
+                if (isObject)
+                    readString(pos, end);
+                auto type = valueType;
+                if (type == UBJsonValueType::UNKNOWN)
+                    type = readMarker(pos, end);
+                pos = skipValue(pos, end, type);
+            }
+            return pos;
+        }
+
+        const char* skipValue(const char* payload, const char* end,
+                              UBJsonValueType valueType)
+        {
+            switch (valueType)
+            {
+            case UBJsonValueType::NULL_VALUE:
+            case UBJsonValueType::TRUE_VALUE:
+            case UBJsonValueType::FALSE_VALUE:
+                return payload;
+            case UBJsonValueType::STRING:
+            case UBJsonValueType::HIGH_PRECISION_NUMBER:
+                readString(payload, end);
+                return payload;
+            case UBJsonValueType::ARRAY:
+            case UBJsonValueType::OBJECT:
+                return skipStructure(payload, end, valueType);
+            default:
+                break;
+            }
+
+            if (const auto size = getFixedSize(valueType))
+            {
+                checkSize(payload, end, size);
+                return payload + size;
+            }
+            YSON_THROW("Invalid type marker in UBJSON data: "
+                       + toString(valueType));
+        }
+    }
+
+    UBJsonView::UBJsonView(const char* buffer, size_t bufferSize)
+        : m_End(buffer + bufferSize)
+    {
+        m_Payload = buffer;
+        m_ValueType = readMarker(m_Payload, m_End);
+    }
+
+    UBJsonView::UBJsonView(const char* payload, const char* end,
+                           UBJsonValueType valueType, std::string_view key)
+        : m_Payload(payload),
+          m_End(end),
+          m_ValueType(valueType),
+          m_Key(key)
+    {}
+
+    UBJsonView::operator bool() const
+    {
+        return m_Payload != nullptr;
+    }
+
+    ValueType UBJsonView::valueType() const
+    {
+        switch (m_ValueType)
+        {
+        case UBJsonValueType::UNKNOWN:
+            return ValueType::UNKNOWN;
+        case UBJsonValueType::NULL_VALUE:
+            return ValueType::NULL_VALUE;
+        case UBJsonValueType::TRUE_VALUE:
+        case UBJsonValueType::FALSE_VALUE:
+            return ValueType::BOOLEAN;
+        case UBJsonValueType::INT_8:
+        case UBJsonValueType::UINT_8:
+        case UBJsonValueType::INT_16:
+        case UBJsonValueType::INT_32:
+        case UBJsonValueType::INT_64:
+        case UBJsonValueType::CHAR:
+            return ValueType::INTEGER;
+        case UBJsonValueType::FLOAT_32:
+        case UBJsonValueType::FLOAT_64:
+        case UBJsonValueType::HIGH_PRECISION_NUMBER:
+            return ValueType::FLOAT;
+        case UBJsonValueType::STRING:
+            return ValueType::STRING;
+        case UBJsonValueType::ARRAY:
+            return ValueType::ARRAY;
+        case UBJsonValueType::OBJECT:
+            return ValueType::OBJECT;
+        default:
+            return ValueType::INVALID;
+        }
+    }
+
+    UBJsonValueType UBJsonView::ubJsonValueType() const
+    {
+        return m_ValueType;
+    }
+
+    std::string_view UBJsonView::key() const
+    {
+        return m_Key;
+    }
+
+    bool UBJsonView::isNull() const
+    {
+        return m_ValueType == UBJsonValueType::NULL_VALUE;
+    }
+
+    bool UBJsonView::get(bool& value) const
+    {
+        if (m_ValueType == UBJsonValueType::TRUE_VALUE)
+            value = true;
+        else if (m_ValueType == UBJsonValueType::FALSE_VALUE)
+            value = false;
+        else
+            return false;
+        return true;
+    }
+
+    bool UBJsonView::get(int32_t& value) const
+    {
+        int64_t tmp;
+        return get(tmp) && assignInteger(value, tmp);
+    }
+
+    bool UBJsonView::get(int64_t& value) const
+    {
+        if (!isIntegerType(m_ValueType)
+            && m_ValueType != UBJsonValueType::CHAR)
+        {
+            return false;
+        }
+        auto pos = m_Payload;
+        value = readInteger(pos, m_End, m_ValueType);
+        return true;
+    }
+
+    bool UBJsonView::get(uint32_t& value) const
+    {
+        int64_t tmp;
+        return get(tmp) && assignInteger(value, tmp);
+    }
+
+    bool UBJsonView::get(uint64_t& value) const
+    {
+        int64_t tmp;
+        return get(tmp) && assignInteger(value, tmp);
+    }
+
+    bool UBJsonView::get(float& value) const
+    {
+        double tmp;
+        if (!get(tmp))
+            return false;
+        value = static_cast<float>(tmp);
+        return true;
+    }
+
+    bool UBJsonView::get(double& value) const
+    {
+        if (m_ValueType == UBJsonValueType::FLOAT_32)
+        {
+            checkSize(m_Payload, m_End, sizeof(float));
+            float tmp;
+            fromBigEndian<sizeof(float)>(reinterpret_cast<char*>(&tmp),
+                                         m_Payload);
+            value = tmp;
+            return true;
+        }
+        if (m_ValueType == UBJsonValueType::FLOAT_64)
+        {
+            checkSize(m_Payload, m_End, sizeof(double));
+            fromBigEndian<sizeof(double)>(reinterpret_cast<char*>(&value),
+                                          m_Payload);
+            return true;
+        }
+        int64_t tmp;
+        if (!get(tmp))
+            return false;
+        value = double(tmp);
+        return true;
+    }
+
+    bool UBJsonView::get(std::string_view& value) const
+    {
+        switch (m_ValueType)
+        {
+        case UBJsonValueType::STRING:
+        case UBJsonValueType::HIGH_PRECISION_NUMBER:
+            {
+                auto pos = m_Payload;
+                value = readString(pos, m_End);
+                return true;
+            }
+        case UBJsonValueType::CHAR:
+            checkSize(m_Payload, m_End, 1);
+            value = {m_Payload, 1};
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    size_t UBJsonView::size() const
+    {
+        const auto header = structureHeader();
+        if (header.size >= 0)
+            return size_t(header.size);
+        size_t count = 0;
+        for (auto it = begin(), last = end(); it != last; ++it)
+            ++count;
+        return count;
+    }
+
+    std::span<const char> UBJsonView::arrayData() const
+    {
+        if (m_ValueType != UBJsonValueType::ARRAY)
+            return {};
+        const auto header = structureHeader();
+        const auto valueSize = getFixedSize(header.valueType);
+        if (header.size < 0 || valueSize == 0)
+            return {};
+        return {header.firstValue, size_t(encodedSize()
+                                          - (header.firstValue - m_Payload))};
+    }
+
+    UBJsonView UBJsonView::operator[](size_t index) const
+    {
+        if (auto value = find(index))
+            return *value;
+        YSON_THROW("Index is too great: " + std::to_string(index));
+    }
+
+    UBJsonView UBJsonView::operator[](std::string_view key) const
+    {
+        if (auto value = find(key))
+            return *value;
+        YSON_THROW("No such key: " + std::string(key));
+    }
+
+    std::optional<UBJsonView> UBJsonView::find(size_t index) const
+    {
+        if (m_ValueType != UBJsonValueType::ARRAY)
+            YSON_THROW("Value isn't an array.");
+
+        const auto header = structureHeader();
+        if (header.size >= 0 && index >= size_t(header.size))
+            return {};
+        if (const auto valueSize = getFixedSize(header.valueType))
+        {
+            const auto payload = header.firstValue + index * valueSize;
+            checkSize(payload, m_End, valueSize);
+            return UBJsonView(payload, m_End, header.valueType, {});
+        }
+
+        auto it = begin();
+        const auto last = end();
+        for (size_t i = 0; i < index && it != last; ++i)
+            ++it;
+        if (it == last)
+            return {};
+        return *it;
+    }
+
+    std::optional<UBJsonView> UBJsonView::find(std::string_view key) const
+    {
+        if (m_ValueType != UBJsonValueType::OBJECT)
+            YSON_THROW("Value isn't an object.");
+
+        for (const auto& value : *this)
+        {
+            if (value.key() == key)
+                return value;
+        }
+        return {};
+    }
+
+    size_t UBJsonView::encodedSize() const
+    {
+        return size_t(skipValue(m_Payload, m_End, m_ValueType) - m_Payload);
+    }
+
+    UBJsonView::Iterator UBJsonView::begin() const
+    {
+        const auto header = structureHeader();
+        return {header.firstValue, m_End,
+                m_ValueType == UBJsonValueType::OBJECT,
+                header.valueType, header.size};
+    }
+
+    UBJsonView::Iterator UBJsonView::end() const
+    {
+        if (!isStructure())
+            YSON_THROW("Value isn't an array or object.");
+        return {};
+    }
+
+    UBJsonView::StructureHeader UBJsonView::structureHeader() const
+    {
+        if (!isStructure())
+            YSON_THROW("Value isn't an array or object.");
+
+        StructureHeader header;
+        header.firstValue = readStructureHeader(m_Payload, m_End,
+                                                header.valueType,
+                                                header.size);
+        return header;
+    }
+
+    bool UBJsonView::isStructure() const
+    {
+        return m_ValueType == UBJsonValueType::ARRAY
+               || m_ValueType == UBJsonValueType::OBJECT;
+    }
+
+    UBJsonView::Iterator::Iterator(const char* position, const char* end,
+                                   bool isObject, UBJsonValueType valueType,
+                                   int64_t remaining)
+        : m_Position(position),
+          m_End(end),
+          m_IsObject(isObject),
+          m_StructureValueType(valueType),
+          m_Remaining(remaining)
+    {
+        readValue();
+    }
+
+    UBJsonView::Iterator& UBJsonView::Iterator::operator++()
+    {
+        if (!m_Position)
+            return *this;
+        m_Position = skipValue(m_Value.m_Payload, m_End, m_Value.m_ValueType);
+        if (m_Remaining > 0)
+            --m_Remaining;
+        readValue();
+        return *this;
+    }
+
+    void UBJsonView::Iterator::readValue()
+    {
+        if (m_Remaining == 0)
+        {
+            m_Position = nullptr;
+            return;
+        }
+
+        auto pos = m_Position;
+        if (m_Remaining < 0)
+        {
+            while (pos != m_End && *pos == 'N')
+                ++pos;
+            checkSize(pos, m_End, 1);
+            if (*pos == (m_IsObject ? '}' : ']'))
+            {
+                m_Position = nullptr;
+                return;
+            }
+        }
+
+        std::string_view key;
+        if (m_IsObject)
+            key = readString(pos, m_End);
+        auto valueType = m_StructureValueType;
+        if (valueType == UBJsonValueType::UNKNOWN)
+            valueType = readMarker(pos, m_End);
+        m_Value = UBJsonView(pos, m_End, valueType, key);
+    }
+}
@@ -0,0 +1,92 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Validate.hpp"
+
+#include "Yson/Common/ScopeStack.hpp"
+#include "Yson/UBJsonReader.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        void validateDocument(UBJsonReader& reader, ScopeStack& scopes)
+        {
+            // The values are never read, the reader only has to skip them.
+            while (true)
+            {
+                bool hasValue;
+                if (!scopes.empty() && scopes.isObject())
+                    hasValue = reader.nextKey() && reader.nextValue();
+                else
+                    hasValue = reader.nextValue();
+
+                if (hasValue)
+                {
+                    auto type = reader.valueType();
+                    if (type == ValueType::OBJECT || type == ValueType::ARRAY)
+                    {
+                        reader.enter();
+                        scopes.push(type == ValueType::OBJECT);
+                    }
+                }
+                else if (!scopes.empty())
+                {
+                    reader.leave();
+                    scopes.pop();
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        ValidationResult validate(UBJsonReader& reader)
+        {
+            try
+            {
+                ScopeStack scopes;
+                do
+                {
+                    validateDocument(reader, scopes);
+                } while (reader.nextDocument());
+                return {};
+            }
+            catch (YsonReaderException& ex)
+            {
+                return {false, ex.offset, ex.line, ex.column, ex.message};
+            }
+            catch (YsonException& ex)
+            {
+                return {false, reader.columnNumber(), 0,
+                        reader.columnNumber(), ex.message};
+            }
+        }
+    }
+
+    ValidationResult validateUBJson(const char* buffer, size_t bufferSize,
+                                    const ReaderOptions& options)
+    {
+        UBJsonReader reader(buffer, bufferSize, options);
+        return validate(reader);
+    }
+
+    ValidationResult validateUBJson(std::istream& stream,
+                                    const ReaderOptions& options)
+    {
+        UBJsonReader reader(stream, options);
+        return validate(reader);
+    }
+
+    ValidationResult validateUBJson(const std::filesystem::path& fileName,
+                                    const ReaderOptions& options)
+    {
+        UBJsonReader reader(fileName, options);
+        return validate(reader);
+    }
+}
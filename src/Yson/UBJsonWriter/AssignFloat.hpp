@@ -26,7 +26,7 @@ namespace Yson
             && sizeof(T) < sizeof(U), int>::type = 0>
     bool assignFloat(T& destination, U source)
     {
-        if ((std::numeric_limits<T>::min() <= source
+        if ((std::numeric_limits<T>::lowest() <= source
              && source <= std::numeric_limits<T>::max())
             || !std::isfinite(source))
         {
@@ -0,0 +1,333 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "CompactStructure.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string_view>
+#include "UBJsonWriterUtilities.hpp"
+
+namespace Yson
+{
+    namespace
+    {
+        template <typename T>
+        T loadValue(const char* src, bool littleEndian)
+        {
+            // storeValue only reorders the bytes, doing it a second time
+            // restores the original order.
+            T value;
+            storeValue<sizeof(T)>(reinterpret_cast<char*>(&value), src,
+                                  littleEndian);
+            return value;
+        }
+
+        /**
+         * @brief A number or string value in the buffer.
+         */
+        struct Element
+        {
+            char marker = 0;
+            /// The value after the marker.
+            std::string_view payload;
+            int64_t integer = 0;
+            /// Set for BJData uint64 values greater than INT64_MAX.
+            uint64_t bigInteger = 0;
+            double floatingPoint = 0;
+        };
+
+        class ElementReader
+        {
+        public:
+            ElementReader(const char* begin, const char* end,
+                          bool littleEndian)
+                : m_Pos(begin),
+                  m_End(end),
+                  m_LittleEndian(littleEndian)
+            {}
+
+            [[nodiscard]]
+            bool atEnd() const
+            {
+                return m_Pos == m_End;
+            }
+
+            /**
+             * @brief Reads the next value. Returns false if it is neither
+             *  a number nor a string.
+             */
+            bool next(Element& element)
+            {
+                element = {};
+                element.marker = *m_Pos++;
+                const auto payloadStart = m_Pos;
+                if (element.marker == 'S')
+                {
+                    int64_t length;
+                    if (!readInteger(*m_Pos++, length))
+                        return false;
+                    m_Pos += length;
+                }
+                else if (!readNumber(element))
+                {
+                    return false;
+                }
+                element.payload = {payloadStart,
+                                   size_t(m_Pos - payloadStart)};
+                return true;
+            }
+
+            /**
+             * @brief Reads the next object key, including its length.
+             */
+            bool nextKey(std::string_view& key)
+            {
+                const auto keyStart = m_Pos;
+                int64_t length;
+                if (!readInteger(*m_Pos++, length))
+                    return false;
+                m_Pos += length;
+                key = {keyStart, size_t(m_Pos - keyStart)};
+                return true;
+            }
+        private:
+            bool readInteger(char marker, int64_t& value)
+            {
+                switch (marker)
+                {
+                case 'i':
+                    value = int8_t(*m_Pos);
+                    m_Pos += 1;
+                    return true;
+                case 'U':
+                    value = uint8_t(*m_Pos);
+                    m_Pos += 1;
+                    return true;
+                case 'I':
+                    value = read<int16_t>();
+                    return true;
+                case 'u':
+                    value = read<uint16_t>();
+                    return true;
+                case 'l':
+                    value = read<int32_t>();
+                    return true;
+                case 'm':
+                    value = read<uint32_t>();
+                    return true;
+                case 'L':
+                    value = read<int64_t>();
+                    return true;
+                default:
+                    return false;
+                }
+            }
+
+            bool readNumber(Element& element)
+            {
+                switch (element.marker)
+                {
+                case 'd':
+                    element.floatingPoint = read<float>();
+                    return true;
+                case 'D':
+                    element.floatingPoint = read<double>();
+                    return true;
+                case 'M':
+                    {
+                        const auto value = read<uint64_t>();
+                        if (value > INT64_MAX)
+                            element.bigInteger = value;
+                        else
+                            element.integer = int64_t(value);
+                        return true;
+                    }
+                default:
+                    return readInteger(element.marker, element.integer);
+                }
+            }
+
+            template <typename T>
+            T read()
+            {
+                auto value = loadValue<T>(m_Pos, m_LittleEndian);
+                m_Pos += sizeof(T);
+                return value;
+            }
+
+            const char* m_Pos;
+            const char* m_End;
+            bool m_LittleEndian;
+        };
+
+        bool isFloat(char marker)
+        {
+            return marker == 'd' || marker == 'D';
+        }
+
+        /**
+         * @brief Collects the properties of the values in a container
+         *  that determine its value type.
+         */
+        struct ValueRange
+        {
+            void add(const Element& element)
+            {
+                ++count;
+                if (element.marker == 'S')
+                {
+                    hasStrings = true;
+                }
+                else if (isFloat(element.marker))
+                {
+                    hasFloats = true;
+                    if (element.marker == 'D'
+                        && !std::isnan(element.floatingPoint)
+                        && double(float(element.floatingPoint))
+                           != element.floatingPoint)
+                    {
+                        allFloatsAreExact = false;
+                    }
+                }
+                else if (element.bigInteger)
+                {
+                    hasBigIntegers = true;
+                }
+                else
+                {
+                    minInteger = std::min(minInteger, element.integer);
+                    maxInteger = std::max(maxInteger, element.integer);
+                }
+            }
+
+            [[nodiscard]]
+            UBJsonValueType valueType(bool bjdata) const
+            {
+                const bool hasIntegers = minInteger <= maxInteger;
+                if (hasStrings)
+                {
+                    return hasFloats || hasIntegers || hasBigIntegers
+                           ? UBJsonValueType::UNKNOWN
+                           : UBJsonValueType::STRING;
+                }
+                if (hasBigIntegers)
+                {
+                    return hasFloats || minInteger < 0
+                           ? UBJsonValueType::UNKNOWN
+                           : UBJsonValueType::UINT_64;
+                }
+                if (hasFloats)
+                {
+                    // Integers would be read back as floating point
+                    // values, so mixed structures are left as they are.
+                    if (hasIntegers)
+                        return UBJsonValueType::UNKNOWN;
+                    return allFloatsAreExact ? UBJsonValueType::FLOAT_32
+                                             : UBJsonValueType::FLOAT_64;
+                }
+                if (minInteger >= INT8_MIN && maxInteger <= INT8_MAX)
+                    return UBJsonValueType::INT_8;
+                if (minInteger >= 0 && maxInteger <= UINT8_MAX)
+                    return UBJsonValueType::UINT_8;
+                if (minInteger >= INT16_MIN && maxInteger <= INT16_MAX)
+                    return UBJsonValueType::INT_16;
+                if (bjdata && minInteger >= 0 && maxInteger <= UINT16_MAX)
+                    return UBJsonValueType::UINT_16;
+                if (minInteger >= INT32_MIN && maxInteger <= INT32_MAX)
+                    return UBJsonValueType::INT_32;
+                if (bjdata && minInteger >= 0 && maxInteger <= UINT32_MAX)
+                    return UBJsonValueType::UINT_32;
+                return UBJsonValueType::INT_64;
+            }
+
+            size_t count = 0;
+            int64_t minInteger = INT64_MAX;
+            int64_t maxInteger = INT64_MIN;
+            bool hasBigIntegers = false;
+            bool hasFloats = false;
+            bool allFloatsAreExact = true;
+            bool hasStrings = false;
+        };
+
+        void writeElement(std::pmr::vector<char>& buffer,
+                          const Element& element,
+                          UBJsonValueType valueType,
+                          bool littleEndian)
+        {
+            if (element.marker == 'S')
+                buffer.insert(buffer.end(), element.payload.begin(),
+                              element.payload.end());
+            else if (isFloat(element.marker))
+                writeFloatAs(buffer, element.floatingPoint, valueType,
+                             littleEndian);
+            else if (element.bigInteger)
+                writeIntegerAs(buffer, element.bigInteger, valueType,
+                               littleEndian);
+            else
+                writeIntegerAs(buffer, element.integer, valueType,
+                               littleEndian);
+        }
+    }
+
+    bool compactStructure(std::pmr::vector<char>& buffer, size_t start,
+                          size_t countSize, bool littleEndian)
+    {
+        const auto isObject = buffer[start] == '{';
+        const auto begin = buffer.data() + start + 1 + countSize;
+        const auto end = buffer.data() + buffer.size();
+
+        ValueRange range;
+        ElementReader reader(begin, end, littleEndian);
+        while (!reader.atEnd())
+        {
+            std::string_view key;
+            Element element;
+            if ((isObject && !reader.nextKey(key)) || !reader.next(element))
+                return false;
+            range.add(element);
+        }
+
+        if (range.count == 0)
+            return false;
+        const auto valueType = range.valueType(littleEndian);
+        if (valueType == UBJsonValueType::UNKNOWN)
+            return false;
+
+        std::pmr::vector<char> result(buffer.get_allocator());
+        result.reserve(buffer.size() - start);
+        result.push_back(buffer[start]);
+        result.push_back('$');
+        result.push_back(char(valueType));
+        result.push_back('#');
+        writeMinimalInteger(result, int64_t(range.count), littleEndian);
+        reader = ElementReader(begin, end, littleEndian);
+        while (!reader.atEnd())
+        {
+            std::string_view key;
+            Element element;
+            if (isObject)
+            {
+                reader.nextKey(key);
+                result.insert(result.end(), key.begin(), key.end());
+            }
+            reader.next(element);
+            writeElement(result, element, valueType, littleEndian);
+        }
+
+        // Without a count the original container still needs its
+        // closing bracket.
+        const auto size = buffer.size() - start + (countSize == 0 ? 1 : 0);
+        if (result.size() >= size)
+            return false;
+
+        buffer.resize(start);
+        buffer.insert(buffer.end(), result.begin(), result.end());
+        return true;
+    }
+}
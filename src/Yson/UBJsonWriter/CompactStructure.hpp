@@ -0,0 +1,35 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Yson
+{
+    /**
+     * @brief Rewrites the array or object at the end of @a buffer as an
+     *  optimized container with a value type and a count, if that makes
+     *  it smaller.
+     *
+     * The container starts with the '[' or '{' at @a start and must not
+     * have been closed. If the container has a placeholder count, it
+     * takes up the @a countSize bytes after the '[' or '{'. It can only be rewritten if its values are
+     * either all numbers or all strings. Numbers are written with the
+     * narrowest type that can represent all of them without loss, e.g.
+     * floats if every double in the container is exactly representable
+     * as a float.
+     *
+     * @param littleEndian true if the container is written as BJData.
+     * @return true if the container was rewritten, in which case it
+     *  must neither be closed with ']' or '}', nor have its count
+     *  updated.
+     */
+    bool compactStructure(std::pmr::vector<char>& buffer, size_t start,
+                          size_t countSize, bool littleEndian);
+}
@@ -30,6 +30,9 @@ namespace Yson
     YSON_DEFINE_UBJSONVALUE_TRAITS(int16_t, UBJsonValueType::INT_16);
     YSON_DEFINE_UBJSONVALUE_TRAITS(int32_t, UBJsonValueType::INT_32);
     YSON_DEFINE_UBJSONVALUE_TRAITS(int64_t, UBJsonValueType::INT_64);
+    YSON_DEFINE_UBJSONVALUE_TRAITS(uint16_t, UBJsonValueType::UINT_16);
+    YSON_DEFINE_UBJSONVALUE_TRAITS(uint32_t, UBJsonValueType::UINT_32);
+    YSON_DEFINE_UBJSONVALUE_TRAITS(uint64_t, UBJsonValueType::UINT_64);
     YSON_DEFINE_UBJSONVALUE_TRAITS(float, UBJsonValueType::FLOAT_32);
     YSON_DEFINE_UBJSONVALUE_TRAITS(double, UBJsonValueType::FLOAT_64);
     YSON_DEFINE_UBJSONVALUE_TRAITS(char, UBJsonValueType::CHAR);
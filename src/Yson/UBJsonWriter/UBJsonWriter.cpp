@@ -8,12 +8,18 @@
 #include "Yson/UBJsonWriter.hpp"
 
 #include <cassert>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <stack>
 #include <Yconvert/Convert.hpp>
+#include "Yson/JsonItem.hpp"
 #include "Yson/YsonException.hpp"
 #include "Yson/Common/Base64.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
+#include "Yson/Common/MemoryResource.hpp"
+#include "Yson/UBJsonReader/UBJsonTokenType.hpp"
+#include "CompactStructure.hpp"
 #include "UBJsonWriterUtilities.hpp"
 
 namespace Yson
@@ -22,6 +28,28 @@ namespace Yson
     {
         constexpr size_t MAX_BUFFER_SIZE = 64 * 1024;
 
+        /// The size of a back-patched count: '#', 'L' and an int64.
+        constexpr size_t COUNT_SIZE = 10;
+
+        void writeToStream(std::ostream& stream, const char* data,
+                           size_t size, uint64_t& streamOffset,
+                           WriterStats* stats)
+        {
+            stream.write(data, std::streamsize(size));
+            streamOffset += size;
+            if (stats)
+            {
+                ++stats->flushes;
+                stats->bytesFlushed += size;
+            }
+        }
+
+        void updateMaxScopeDepth(WriterStats* stats, size_t depth)
+        {
+            if (stats && depth > stats->maxScopeDepth)
+                stats->maxScopeDepth = depth;
+        }
+
         struct Context
         {
             Context() = default;
@@ -38,37 +66,61 @@ namespace Yson
             ptrdiff_t size = -1;
             UBJsonValueType structureType = UBJsonValueType::UNKNOWN;
             UBJsonValueType valueType = UBJsonValueType::UNKNOWN;
+            /// The position of the structure's marker in the buffer if
+            /// it can still be written as an optimized structure in
+            /// compact mode, otherwise SIZE_MAX.
+            size_t compactStart = SIZE_MAX;
+            /// The output offset of the structure's back-patched count,
+            /// or UINT64_MAX.
+            uint64_t countOffset = UINT64_MAX;
         };
     }
 
     struct UBJsonWriter::Members
     {
+        explicit Members(std::pmr::memory_resource* memoryResource)
+            : buffer(memoryResource),
+              contexts(std::pmr::deque<Context>(memoryResource))
+        {}
+
         std::unique_ptr<std::ostream> streamPtr;
         std::ostream* stream = nullptr;
-        mutable std::vector<char> buffer;
+        mutable std::pmr::vector<char> buffer;
         std::string key;
-        std::stack<Context> contexts;
+        std::stack<Context, std::pmr::deque<Context>> contexts;
         size_t maxBufferSize = MAX_BUFFER_SIZE;
         bool strictIntegerSizes = false;
+        bool bjdata = false;
+        bool compact = false;
+        bool countPatching = false;
+        /// The number of bytes written to the stream.
+        uint64_t streamOffset = 0;
+        WriterStats* stats = nullptr;
     };
 
-    UBJsonWriter::UBJsonWriter()
-        : UBJsonWriter(std::unique_ptr<std::ostream>(), nullptr)
+    UBJsonWriter::UBJsonWriter(std::pmr::memory_resource* memoryResource)
+        : UBJsonWriter(std::unique_ptr<std::ostream>(), nullptr,
+                       memoryResource)
     {}
 
-    UBJsonWriter::UBJsonWriter(const std::filesystem::path& fileName)
-        : UBJsonWriter(std::make_unique<std::ofstream>(fileName,
-                                                       std::ios_base::binary),
-                       nullptr)
+    UBJsonWriter::UBJsonWriter(const std::filesystem::path& fileName,
+                               std::pmr::memory_resource* memoryResource)
+        : UBJsonWriter(openOutputFile(fileName, true),
+                       nullptr,
+                       memoryResource)
     {}
 
-    UBJsonWriter::UBJsonWriter(std::ostream& stream)
-        : UBJsonWriter(std::unique_ptr<std::ostream>(), &stream)
+    UBJsonWriter::UBJsonWriter(std::ostream& stream,
+                               std::pmr::memory_resource* memoryResource)
+        : UBJsonWriter(std::unique_ptr<std::ostream>(), &stream,
+                       memoryResource)
     {}
 
     UBJsonWriter::UBJsonWriter(std::unique_ptr<std::ostream> streamPtr,
-                               std::ostream* stream)
-        : m_Members(std::make_unique<Members>())
+                               std::ostream* stream,
+                               std::pmr::memory_resource* memoryResource)
+        : m_Members(std::make_unique<Members>(
+              getMemoryResource(memoryResource)))
     {
         m_Members->streamPtr = std::move(streamPtr);
         m_Members->stream = m_Members->streamPtr
@@ -211,6 +263,8 @@ namespace Yson
     {
         if (value <= INT16_MAX)
             return writeInteger(static_cast<int16_t>(value));
+        if (members().bjdata)
+            return writeInteger(static_cast<uint16_t>(value));
         if (!members().strictIntegerSizes)
             return writeInteger<int32_t>(value);
         YSON_THROW("uint16_t value " + std::to_string(value)
@@ -221,6 +275,8 @@ namespace Yson
     {
         if (value <= INT32_MAX)
             return writeInteger(static_cast<int32_t>(value));
+        if (members().bjdata)
+            return writeInteger(static_cast<uint32_t>(value));
         if (!members().strictIntegerSizes)
             return writeInteger<int64_t>(value);
         YSON_THROW("uint32_t value " + std::to_string(value)
@@ -231,6 +287,8 @@ namespace Yson
     {
         if (value <= INT64_MAX)
             return writeInteger(static_cast<int64_t>(value));
+        if (members().bjdata)
+            return writeInteger(static_cast<uint64_t>(value));
         YSON_THROW("uint64_t value " + std::to_string(value)
             + " is greater than INT64_MAX");
     }
@@ -239,6 +297,8 @@ namespace Yson
     {
         if (value <= INT64_MAX)
             return writeInteger(static_cast<int64_t>(value));
+        if (members().bjdata)
+            return writeInteger(static_cast<uint64_t>(value));
         YSON_THROW("uint64_t value " + std::to_string(value)
             + " is greater than INT64_MAX");
     }
@@ -255,14 +315,7 @@ namespace Yson
 
     UBJsonWriter& UBJsonWriter::value(std::string_view text)
     {
-        beginValue();
-        auto& m = members();
-        const auto& context = m.contexts.top();
-        if (context.valueType == UBJsonValueType::UNKNOWN)
-            m.buffer.push_back('S');
-        writeMinimalInteger(m.buffer, text.size());
-        m.buffer.insert(m.buffer.end(), text.begin(), text.end());
-        return *this;
+        return writeText(UBJsonValueType::STRING, text);
     }
 
     UBJsonWriter& UBJsonWriter::value(std::wstring_view text)
@@ -274,12 +327,28 @@ namespace Yson
     }
 
     UBJsonWriter& UBJsonWriter::binary(const void* data, size_t size)
+    {
+        return writeByteArray(UBJsonValueType::UINT_8, data, size);
+    }
+
+    UBJsonWriter& UBJsonWriter::writeByteArray(UBJsonValueType type,
+                                               const void* data,
+                                               size_t size)
     {
         const auto s_size = ptrdiff_t(size);
-        beginArray(UBJsonParameters(s_size, UBJsonValueType::UINT_8));
-        flush();
+        beginArray(UBJsonParameters(s_size, type));
         auto& m = members();
-        m.stream->write(static_cast<const char*>(data), s_size);
+        if (m.stream)
+        {
+            flush();
+            writeToStream(*m.stream, static_cast<const char*>(data), size,
+                          m.streamOffset, m.stats);
+        }
+        else
+        {
+            auto bytes = static_cast<const char*>(data);
+            m.buffer.insert(m.buffer.end(), bytes, bytes + size);
+        }
         m.contexts.top().index = s_size;
         return endArray();
     }
@@ -289,6 +358,12 @@ namespace Yson
         return value(toBase64(data, size));
     }
 
+    UBJsonWriter& UBJsonWriter::write(const JsonItem& item)
+    {
+        Writer::write(item);
+        return *this;
+    }
+
     UBJsonWriter& UBJsonWriter::noop()
     {
         members().buffer.push_back('N');
@@ -307,6 +382,112 @@ namespace Yson
         return *this;
     }
 
+    bool UBJsonWriter::isBJDataEnabled() const
+    {
+        return members().bjdata;
+    }
+
+    UBJsonWriter& UBJsonWriter::setBJDataEnabled(bool value)
+    {
+        members().bjdata = value;
+        return *this;
+    }
+
+    bool UBJsonWriter::isCompactModeEnabled() const
+    {
+        return members().compact;
+    }
+
+    UBJsonWriter& UBJsonWriter::setCompactModeEnabled(bool value)
+    {
+        members().compact = value;
+        return *this;
+    }
+
+    bool UBJsonWriter::isCountPatchingEnabled() const
+    {
+        return members().countPatching;
+    }
+
+    UBJsonWriter& UBJsonWriter::setCountPatchingEnabled(bool value)
+    {
+        auto& m = members();
+        if (value && m.stream && m.stream->tellp() == -1)
+            YSON_THROW("Count patching requires a seekable stream.");
+        m.countPatching = value;
+        return *this;
+    }
+
+    UBJsonWriter& UBJsonWriter::ndArray(UBJsonValueType valueType,
+                                        std::span<const size_t> dimensions,
+                                        const void* data)
+    {
+        auto& m = members();
+        if (!m.bjdata)
+            YSON_THROW("N-dimensional arrays require BJData.");
+        const auto valueSize = getValueSize(
+            static_cast<UBJsonTokenType>(valueType));
+        if (valueSize == 0)
+            YSON_THROW("Can't write N-dimensional array of "
+                       + toString(valueType) + ".");
+        size_t count = 1;
+        for (auto dimension : dimensions)
+        {
+            if (dimension != 0 && count > SIZE_MAX / valueSize / dimension)
+                YSON_THROW("Array dimensions are too large.");
+            count *= dimension;
+        }
+
+        if (m.contexts.top().valueType != UBJsonValueType::UNKNOWN)
+            YSON_THROW("Can't write N-dimensional arrays to optimized"
+                       " structures with a value type.");
+
+        beginValue();
+        m.contexts.top().compactStart = SIZE_MAX;
+        m.buffer.push_back('[');
+        m.buffer.push_back('$');
+        m.buffer.push_back(char(valueType));
+        m.buffer.push_back('#');
+        m.buffer.push_back('[');
+        for (auto dimension : dimensions)
+            writeMinimalInteger(m.buffer, dimension, true);
+        m.buffer.push_back(']');
+
+        const auto bytes = static_cast<const char*>(data);
+        const auto size = count * valueSize;
+        #ifdef IS_BIG_ENDIAN
+        const auto first = m.buffer.size();
+        m.buffer.resize(first + size);
+        for (size_t i = 0; i < size; i += valueSize)
+        {
+            std::reverse_copy(bytes + i, bytes + i + valueSize,
+                              m.buffer.data() + first + i);
+        }
+        #else
+        if (m.stream && m.buffer.size() + size > m.maxBufferSize)
+        {
+            flush();
+            writeToStream(*m.stream, bytes, size, m.streamOffset, m.stats);
+        }
+        else
+        {
+            m.buffer.insert(m.buffer.end(), bytes, bytes + size);
+        }
+        #endif
+        return *this;
+    }
+
+    WriterStats* UBJsonWriter::stats() const
+    {
+        return members().stats;
+    }
+
+    UBJsonWriter& UBJsonWriter::setStats(WriterStats* stats)
+    {
+        members().stats = stats;
+        return *this;
+    }
+
     UBJsonWriter::Members& UBJsonWriter::members() const
     {
         if (m_Members)
@@ -324,9 +505,18 @@ namespace Yson
 
         beginValue();
         auto& m = members();
-        const auto& context = m.contexts.top();
+        auto& context = m.contexts.top();
+        // Only structures that contain nothing but numbers or strings
+        // can be compacted.
+        context.compactStart = SIZE_MAX;
+        size_t compactStart = SIZE_MAX;
         if (context.valueType == UBJsonValueType::UNKNOWN)
+        {
+            if (m.compact && parameters.size < 0)
+                compactStart = m.buffer.size();
             m.buffer.push_back(char(structureType));
+        }
+        uint64_t countOffset = UINT64_MAX;
         if (parameters.size >= 0)
         {
             if (parameters.valueType != UBJsonValueType::UNKNOWN)
@@ -335,11 +525,23 @@ namespace Yson
                 m.buffer.push_back(char(parameters.valueType));
             }
             m.buffer.push_back('#');
-            writeMinimalInteger(m.buffer, int64_t(parameters.size));
+            writeMinimalInteger(m.buffer, int64_t(parameters.size),
+                                m.bjdata);
+        }
+        else if (m.countPatching)
+        {
+            // Reserve a full int64 for the count, it is written when the
+            // structure is closed.
+            m.buffer.push_back('#');
+            countOffset = m.streamOffset + m.buffer.size() + 1;
+            writeValueWithMarker(m.buffer, int64_t(0), m.bjdata);
         }
         m.contexts.emplace(structureType,
                            parameters.size,
                            parameters.valueType);
+        m.contexts.top().compactStart = compactStart;
+        m.contexts.top().countOffset = countOffset;
+        updateMaxScopeDepth(m.stats, m.contexts.size() - 1);
         return *this;
     }
 
@@ -352,7 +554,17 @@ namespace Yson
         {
             if (context.size == -1)
             {
-                m.buffer.push_back(endChar);
+                const auto hasCount = context.countOffset != UINT64_MAX;
+                if (context.compactStart == SIZE_MAX
+                    || !compactStructure(m.buffer, context.compactStart,
+                                         hasCount ? COUNT_SIZE : 0,
+                                         m.bjdata))
+                {
+                    if (hasCount)
+                        patchCount(context.countOffset, context.index);
+                    else
+                        m.buffer.push_back(endChar);
+                }
             }
             else if (context.index != context.size)
             {
@@ -379,16 +591,58 @@ namespace Yson
         return *this;
     }
 
-    void UBJsonWriter::beginValue()
+    std::unique_ptr<UBJsonWriter> UBJsonWriter::makeFragmentWriter() const
+    {
+        auto writer = std::make_unique<UBJsonWriter>();
+        writer->members().strictIntegerSizes = members().strictIntegerSizes;
+        writer->members().bjdata = members().bjdata;
+        writer->members().compact = members().compact;
+        writer->members().countPatching = members().countPatching;
+        return writer;
+    }
+
+    bool UBJsonWriter::isCompleteFragment() const
     {
         auto& m = members();
-        if (m.buffer.size() >= m.maxBufferSize)
+        return m.contexts.size() == 1 && m.contexts.top().index == 1;
+    }
+
+    UBJsonWriter& UBJsonWriter::writeFragment(std::string_view data)
+    {
+        beginValue();
+        auto& m = members();
+        if (m.contexts.top().valueType != UBJsonValueType::UNKNOWN)
+            YSON_THROW("Can't write fragments to optimized structures with"
+                       " a value type.");
+        m.contexts.top().compactStart = SIZE_MAX;
+        if (m.stream && m.buffer.size() + data.size() > m.maxBufferSize)
+        {
             flush();
+            writeToStream(*m.stream, data.data(), data.size(),
+                          m.streamOffset, m.stats);
+        }
+        else
+        {
+            m.buffer.insert(m.buffer.end(), data.begin(), data.end());
+        }
+        return *this;
+    }
+
+    void UBJsonWriter::beginValue()
+    {
+        auto& m = members();
         auto& context = m.contexts.top();
+        // The structure must stay in the buffer until it has been
+        // compacted.
+        if (m.buffer.size() >= m.maxBufferSize
+            && context.compactStart == SIZE_MAX)
+        {
+            flush();
+        }
         auto& key = m.key;
         if (context.structureType == UBJsonValueType::OBJECT)
         {
-            writeMinimalInteger(m.buffer, m.key.size());
+            writeMinimalInteger(m.buffer, m.key.size(), m.bjdata);
             m.buffer.insert(m.buffer.end(), key.begin(), key.end());
         }
         key.clear();
@@ -397,46 +651,172 @@ namespace Yson
         ++context.index;
     }
 
+    void UBJsonWriter::patchCount(uint64_t offset, int64_t count)
+    {
+        auto& m = members();
+        char bytes[8];
+        storeValue<8>(bytes, &count, m.bjdata);
+        if (offset >= m.streamOffset)
+        {
+            std::copy(bytes, bytes + 8,
+                      m.buffer.data() + (offset - m.streamOffset));
+            return;
+        }
+
+        // The count has already been written to the stream.
+        flush();
+        auto& stream = *m.stream;
+        const auto end = stream.tellp();
+        stream.seekp(end - std::streamoff(m.streamOffset - offset));
+        stream.write(bytes, sizeof(bytes));
+        stream.seekp(end);
+        if (!stream)
+            YSON_THROW("Unable to update the count in the stream.");
+    }
+
     UBJsonWriter& UBJsonWriter::flush()
     {
-        const auto& m = members();
+        auto& m = members();
         if (m.stream && !m.buffer.empty())
         {
-            m.stream->write(m.buffer.data(), std::streamsize(m.buffer.size()));
+            m.contexts.top().compactStart = SIZE_MAX;
+            writeToStream(*m.stream, m.buffer.data(), m.buffer.size(),
+                          m.streamOffset, m.stats);
             m.buffer.clear();
         }
         return *this;
     }
 
+    void UBJsonWriter::writeValueItem(const ValueItem& item)
+    {
+        const auto* ubItem = dynamic_cast<const UBJsonValueItem*>(&item);
+        if (!ubItem)
+        {
+            Writer::writeValueItem(item);
+            return;
+        }
+
+        const auto valueType = members().contexts.top().valueType;
+        switch (ubItem->m_Type)
+        {
+        case UBJsonTokenType::INT8_TOKEN:
+            writeInteger(int8_t(ubItem->m_Integer), false);
+            return;
+        case UBJsonTokenType::UINT8_TOKEN:
+            writeInteger(uint8_t(ubItem->m_Integer), false);
+            return;
+        case UBJsonTokenType::INT16_TOKEN:
+            writeInteger(int16_t(ubItem->m_Integer), false);
+            return;
+        case UBJsonTokenType::INT32_TOKEN:
+            writeInteger(int32_t(ubItem->m_Integer), false);
+            return;
+        case UBJsonTokenType::INT64_TOKEN:
+            writeInteger(ubItem->m_Integer, false);
+            return;
+        case UBJsonTokenType::UINT16_TOKEN:
+            value(static_cast<uint16_t>(ubItem->m_Integer));
+            return;
+        case UBJsonTokenType::UINT32_TOKEN:
+            value(static_cast<uint32_t>(ubItem->m_Integer));
+            return;
+        case UBJsonTokenType::UINT64_TOKEN:
+            value(static_cast<uint64_t>(ubItem->m_Integer));
+            return;
+        case UBJsonTokenType::FLOAT16_TOKEN:
+        case UBJsonTokenType::FLOAT32_TOKEN:
+            writeFloat(float(ubItem->m_FloatingPoint));
+            return;
+        case UBJsonTokenType::FLOAT64_TOKEN:
+            writeFloat(ubItem->m_FloatingPoint);
+            return;
+        case UBJsonTokenType::STRING_TOKEN:
+            writeText(UBJsonValueType::STRING, ubItem->m_Value);
+            return;
+        case UBJsonTokenType::CHAR_TOKEN:
+            if (valueType == UBJsonValueType::UNKNOWN
+                || valueType == UBJsonValueType::CHAR)
+            {
+                writeText(UBJsonValueType::CHAR, ubItem->m_Value);
+                return;
+            }
+            break;
+        case UBJsonTokenType::HIGH_PRECISION_TOKEN:
+            if (valueType == UBJsonValueType::UNKNOWN
+                || valueType == UBJsonValueType::HIGH_PRECISION_NUMBER)
+            {
+                writeText(UBJsonValueType::HIGH_PRECISION_NUMBER,
+                          ubItem->m_Value);
+                return;
+            }
+            break;
+        case UBJsonTokenType::START_OPTIMIZED_ARRAY_TOKEN:
+            switch (ubItem->m_ContentType)
+            {
+            case UBJsonTokenType::INT8_TOKEN:
+                writeByteArray(UBJsonValueType::INT_8,
+                               ubItem->m_Value.data(), ubItem->m_Value.size());
+                return;
+            case UBJsonTokenType::CHAR_TOKEN:
+                writeByteArray(UBJsonValueType::CHAR,
+                               ubItem->m_Value.data(), ubItem->m_Value.size());
+                return;
+            default:
+                binary(ubItem->m_Value.data(), ubItem->m_Value.size());
+                return;
+            }
+        default:
+            break;
+        }
+        Writer::writeValueItem(item);
+    }
+
+    UBJsonWriter& UBJsonWriter::writeText(UBJsonValueType type,
+                                          std::string_view text)
+    {
+        beginValue();
+        auto& m = members();
+        const auto& context = m.contexts.top();
+        if (context.valueType == UBJsonValueType::UNKNOWN)
+            m.buffer.push_back(char(type));
+        if (type != UBJsonValueType::CHAR)
+            writeMinimalInteger(m.buffer, text.size(), m.bjdata);
+        m.buffer.insert(m.buffer.end(), text.begin(), text.end());
+        return *this;
+    }
+
     template <typename T>
     UBJsonWriter& UBJsonWriter::writeFloat(T value)
     {
         beginValue();
         auto& m = members();
         auto& context = m.contexts.top();
-        if (context.valueType == UBJsonValueType::UNKNOWN)
-            writeValueWithMarker(m.buffer, value);
+        if (context.valueType != UBJsonValueType::UNKNOWN)
+            writeFloatAs(m.buffer, value, context.valueType, m.bjdata);
+        else if (m.compact && sizeof(T) > sizeof(float)
+                 && double(float(value)) == value)
+            writeValueWithMarker(m.buffer, float(value), m.bjdata);
         else
-            writeFloatAs(m.buffer, value, context.valueType);
+            writeValueWithMarker(m.buffer, value, m.bjdata);
         return *this;
     }
 
     template <typename T>
-    UBJsonWriter& UBJsonWriter::writeInteger(T value)
+    UBJsonWriter& UBJsonWriter::writeInteger(T value, bool minimalSize)
     {
         beginValue();
         auto& m = members();
         auto& context = m.contexts.top();
         if (context.valueType == UBJsonValueType::UNKNOWN)
         {
-            if (!m.strictIntegerSizes)
-                writeMinimalInteger(m.buffer, value);
+            if (minimalSize && !m.strictIntegerSizes)
+                writeMinimalInteger(m.buffer, value, m.bjdata);
             else
-                writeValueWithMarker(m.buffer, value);
+                writeValueWithMarker(m.buffer, value, m.bjdata);
         }
         else
         {
-            writeIntegerAs(m.buffer, value, context.valueType);
+            writeIntegerAs(m.buffer, value, context.valueType, m.bjdata);
         }
         return *this;
     }
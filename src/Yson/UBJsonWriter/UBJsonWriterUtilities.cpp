@@ -11,75 +11,72 @@
 
 namespace Yson
 {
-    void writeMinimalInteger(std::vector<char>& buffer, size_t value)
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, size_t value,
+                             bool littleEndian)
     {
         if (value <= UINT8_MAX)
             writeValueWithMarker(buffer, static_cast<uint8_t>(value));
-        else if (value <= INT16_MAX)
-            writeValueWithMarker(buffer, static_cast<int16_t>(value));
-        else if (value <= INT32_MAX)
-            writeValueWithMarker(buffer, static_cast<int32_t>(value));
         else if (value <= INT64_MAX)
-            writeValueWithMarker(buffer, static_cast<int64_t>(value));
+            writeMinimalInteger(buffer, static_cast<int64_t>(value),
+                                littleEndian);
+        else if (littleEndian)
+            writeValueWithMarker(buffer, static_cast<uint64_t>(value), true);
         else
             YSON_THROW("uint64_t-value is too large: "
                        + std::to_string(value));
     }
 
-    void writeMinimalInteger(std::vector<char>& buffer, int16_t value)
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int16_t value,
+                             bool littleEndian)
     {
-        if (INT8_MIN <= value)
-        {
-            if (value <= INT8_MAX)
-                writeValueWithMarker(buffer, static_cast<int8_t>(value));
-            else if (value <= UINT8_MAX)
-                writeValueWithMarker(buffer, static_cast<uint8_t>(value));
-            else
-                writeValueWithMarker(buffer, value);
-        }
-        else
-            writeValueWithMarker(buffer, value);
+        writeMinimalInteger(buffer, static_cast<int64_t>(value),
+                            littleEndian);
     }
 
-    void writeMinimalInteger(std::vector<char>& buffer, int32_t value)
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, uint16_t value,
+                             bool littleEndian)
     {
-        if (INT8_MIN <= value)
-        {
-            if (value <= INT8_MAX)
-                writeValueWithMarker(buffer, static_cast<int8_t>(value));
-            else if (value <= UINT8_MAX)
-                writeValueWithMarker(buffer, static_cast<uint8_t>(value));
-            else if (value <= INT16_MAX)
-                writeValueWithMarker(buffer, static_cast<int16_t>(value));
-            else
-                writeValueWithMarker(buffer, value);
-        }
-        else if (INT16_MIN <= value)
-            writeValueWithMarker(buffer, static_cast<int16_t>(value));
-        else
-            writeValueWithMarker(buffer, value);
+        writeMinimalInteger(buffer, static_cast<int64_t>(value),
+                            littleEndian);
+    }
+
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int32_t value,
+                             bool littleEndian)
+    {
+        writeMinimalInteger(buffer, static_cast<int64_t>(value),
+                            littleEndian);
     }
 
-    void writeMinimalInteger(std::vector<char>& buffer, int64_t value)
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, uint32_t value,
+                             bool littleEndian)
     {
-        if (INT8_MIN <= value)
-        {
-            if (value <= INT8_MAX)
-                writeValueWithMarker(buffer, static_cast<int8_t>(value));
-            else if (value <= UINT8_MAX)
-                writeValueWithMarker(buffer, static_cast<uint8_t>(value));
-            else if (value <= INT16_MAX)
-                writeValueWithMarker(buffer, static_cast<int16_t>(value));
-            else if (value <= INT32_MAX)
-                writeValueWithMarker(buffer, static_cast<int32_t>(value));
-            else
-                writeValueWithMarker(buffer, value);
-        }
-        else if (INT16_MIN <= value)
-            writeValueWithMarker(buffer, static_cast<int16_t>(value));
-        else if (INT32_MIN <= value)
-            writeValueWithMarker(buffer, static_cast<int32_t>(value));
+        writeMinimalInteger(buffer, static_cast<int64_t>(value),
+                            littleEndian);
+    }
+
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int64_t value,
+                             bool littleEndian)
+    {
+        // Offsetting by the type's minimum value in unsigned arithmetic
+        // turns each range check into a single comparison. BJData's
+        // unsigned markers are only used for values that the signed
+        // marker of the same size can't hold.
+        const auto u = static_cast<uint64_t>(value);
+        if (u - static_cast<uint64_t>(INT8_MIN) <= UINT8_MAX)
+            writeValueWithMarker(buffer, static_cast<int8_t>(value));
+        else if (u <= UINT8_MAX)
+            writeValueWithMarker(buffer, static_cast<uint8_t>(value));
+        else if (u - static_cast<uint64_t>(INT16_MIN) <= UINT16_MAX)
+            writeValueWithMarker(buffer, static_cast<int16_t>(value),
+                                 littleEndian);
+        else if (littleEndian && u <= UINT16_MAX)
+            writeValueWithMarker(buffer, static_cast<uint16_t>(value), true);
+        else if (u - static_cast<uint64_t>(INT32_MIN) <= UINT32_MAX)
+            writeValueWithMarker(buffer, static_cast<int32_t>(value),
+                                 littleEndian);
+        else if (littleEndian && u <= UINT32_MAX)
+            writeValueWithMarker(buffer, static_cast<uint32_t>(value), true);
         else
-            writeValueWithMarker(buffer, value);
+            writeValueWithMarker(buffer, value, littleEndian);
     }
 }
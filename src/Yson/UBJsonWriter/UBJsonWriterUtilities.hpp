@@ -8,6 +8,8 @@
 #pragma once
 
 #include <cstdint>
+#include <cstring>
+#include <memory_resource>
 #include <string>
 #include <vector>
 #include "Yson/YsonException.hpp"
@@ -21,46 +23,52 @@ namespace Yson
     #ifdef IS_BIG_ENDIAN
 
     template <size_t N>
-    void appendBigEndian(std::vector<char>& buffer, const void* value)
+    void storeBigEndian(char* dst, const void* value)
     {
-        auto bytes = static_cast<const char*>(&value);
-        buffer.insert(buffer.end(), bytes, bytes + N);
+        std::memcpy(dst, value, N);
+    }
+
+    template <size_t N>
+    void storeLittleEndian(char* dst, const void* value)
+    {
+        auto src = static_cast<const char*>(value);
+        for (unsigned i = 0; i < N; ++i)
+            dst[i] = src[N - i - 1];
     }
 
     #else
 
     template <size_t N>
-    void appendBigEndian(std::vector<char>& buffer, const void* value)
+    void storeLittleEndian(char* dst, const void* value)
     {
-        auto first = buffer.size();
-        buffer.resize(first + N);
+        std::memcpy(dst, value, N);
+    }
+
+    template <size_t N>
+    void storeBigEndian(char* dst, const void* value)
+    {
+        auto src = static_cast<const char*>(value);
         for (unsigned i = 0; i < N; ++i)
-            buffer[first + i] = static_cast<const char*>(value)[N - i - 1];
+            dst[i] = src[N - i - 1];
     }
 
     template <>
-    inline void appendBigEndian<1>(std::vector<char>& buffer, const void* value)
+    inline void storeBigEndian<1>(char* dst, const void* value)
     {
-        buffer.push_back(static_cast<const char*>(value)[0]);
+        dst[0] = static_cast<const char*>(value)[0];
     }
 
     template <>
-    inline void appendBigEndian<2>(std::vector<char>& buffer, const void* value)
+    inline void storeBigEndian<2>(char* dst, const void* value)
     {
-        auto first = buffer.size();
-        buffer.resize(first + 2);
-        auto dst = buffer.data() + first;
         auto src = static_cast<const char*>(value);
         dst[0] = src[1];
         dst[1] = src[0];
     }
 
     template <>
-    inline void appendBigEndian<4>(std::vector<char>& buffer, const void* value)
+    inline void storeBigEndian<4>(char* dst, const void* value)
     {
-        auto first = buffer.size();
-        buffer.resize(first + 4);
-        auto dst = buffer.data() + first;
         auto src = static_cast<const char*>(value);
         dst[0] = src[3];
         dst[1] = src[2];
@@ -69,11 +77,8 @@ namespace Yson
     }
 
     template <>
-    inline void appendBigEndian<8>(std::vector<char>& buffer, const void* value)
+    inline void storeBigEndian<8>(char* dst, const void* value)
     {
-        auto first = buffer.size();
-        buffer.resize(first + 8);
-        auto dst = buffer.data() + first;
         auto src = static_cast<const char*>(value);
         dst[0] = src[7];
         dst[1] = src[6];
@@ -87,79 +92,145 @@ namespace Yson
 
     #endif
 
-    void writeMinimalInteger(std::vector<char>& buffer, size_t value);
+    /**
+     * @brief Stores @a value in little-endian byte order (BJData) if
+     *  @a littleEndian is true, otherwise in big-endian byte order.
+     */
+    template <size_t N>
+    void storeValue(char* dst, const void* value, bool littleEndian)
+    {
+        if (littleEndian)
+            storeLittleEndian<N>(dst, value);
+        else
+            storeBigEndian<N>(dst, value);
+    }
+
+    template <size_t N>
+    void appendBigEndian(std::pmr::vector<char>& buffer, const void* value)
+    {
+        const auto first = buffer.size();
+        buffer.resize(first + N);
+        storeBigEndian<N>(buffer.data() + first, value);
+    }
 
-    void writeMinimalInteger(std::vector<char>& buffer, int16_t value);
+    /**
+     * @brief Writes @a value with the smallest marker that can hold it.
+     *
+     * When @a littleEndian is true the value is written as BJData, which
+     * also has markers for unsigned 16, 32 and 64-bit integers.
+     */
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, size_t value,
+                             bool littleEndian = false);
 
-    void writeMinimalInteger(std::vector<char>& buffer, int32_t value);
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int16_t value,
+                             bool littleEndian = false);
 
-    void writeMinimalInteger(std::vector<char>& buffer, int64_t value);
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, uint16_t value,
+                             bool littleEndian = false);
+
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int32_t value,
+                             bool littleEndian = false);
+
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, uint32_t value,
+                             bool littleEndian = false);
+
+    void writeMinimalInteger(std::pmr::vector<char>& buffer, int64_t value,
+                             bool littleEndian = false);
 
     template <typename IntT>
-    void writeValue(std::vector<char>& buffer, IntT value)
+    void writeValue(std::pmr::vector<char>& buffer, IntT value,
+                    bool littleEndian = false)
     {
-        appendBigEndian<sizeof(IntT)>(buffer, &value);
+        const auto first = buffer.size();
+        buffer.resize(first + sizeof(IntT));
+        storeValue<sizeof(IntT)>(buffer.data() + first, &value,
+                                 littleEndian);
     }
 
     template <>
-    inline void writeValue(std::vector<char>& buffer, int8_t value)
+    inline void writeValue(std::pmr::vector<char>& buffer, int8_t value,
+                           bool)
     {
         buffer.push_back(char(value));
     }
 
     template <>
-    inline void writeValue(std::vector<char>& buffer, uint8_t value)
+    inline void writeValue(std::pmr::vector<char>& buffer, uint8_t value,
+                           bool)
     {
         buffer.push_back(char(value));
     }
 
+    /**
+     * @brief Appends the marker for @a value's type followed by @a value
+     *  in big-endian byte order, or little-endian if @a littleEndian is
+     *  true.
+     *
+     * The buffer is grown once and the marker and value are written
+     * directly into the new space.
+     */
     template <typename IntT>
-    void writeValueWithMarker(std::vector<char>& buffer, IntT value)
+    void writeValueWithMarker(std::pmr::vector<char>& buffer, IntT value,
+                              bool littleEndian = false)
     {
-        buffer.push_back(UBJsonValueTraits<IntT>::marker());
-        writeValue(buffer, value);
+        const auto first = buffer.size();
+        buffer.resize(first + 1 + sizeof(IntT));
+        const auto dst = buffer.data() + first;
+        dst[0] = UBJsonValueTraits<IntT>::marker();
+        storeValue<sizeof(IntT)>(dst + 1, &value, littleEndian);
     }
 
     template <typename T, typename U>
-    void writeIntegerAsImpl(std::vector<char>& buffer, U value)
+    void writeIntegerAsImpl(std::pmr::vector<char>& buffer, U value,
+                            bool littleEndian)
     {
         T tmp;
         if (assignInteger(tmp, value))
-            writeValue(buffer, tmp);
+            writeValue(buffer, tmp, littleEndian);
         else
             YSON_THROW("Value is too great or small to be converted: "
                        + std::to_string(value));
     }
 
     template <typename T>
-    void writeIntegerAs(std::vector<char>& buffer, T value,
-                        UBJsonValueType valueType)
+    void writeIntegerAs(std::pmr::vector<char>& buffer, T value,
+                        UBJsonValueType valueType,
+                        bool littleEndian = false)
     {
         switch (valueType)
         {
         case UBJsonValueType::FLOAT_32:
-            writeValue(buffer, static_cast<float>(value));
+            writeValue(buffer, static_cast<float>(value), littleEndian);
             break;
         case UBJsonValueType::FLOAT_64:
-            writeValue(buffer, static_cast<double>(value));
+            writeValue(buffer, static_cast<double>(value), littleEndian);
             break;
         case UBJsonValueType::CHAR:
-            writeIntegerAsImpl<char>(buffer, value);
+            writeIntegerAsImpl<char>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::UINT_8:
-            writeIntegerAsImpl<uint8_t>(buffer, value);
+            writeIntegerAsImpl<uint8_t>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::INT_8:
-            writeIntegerAsImpl<int8_t>(buffer, value);
+            writeIntegerAsImpl<int8_t>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::INT_16:
-            writeIntegerAsImpl<int16_t>(buffer, value);
+            writeIntegerAsImpl<int16_t>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::INT_32:
-            writeIntegerAsImpl<int32_t>(buffer, value);
+            writeIntegerAsImpl<int32_t>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::INT_64:
-            writeIntegerAsImpl<int64_t>(buffer, value);
+            writeIntegerAsImpl<int64_t>(buffer, value, littleEndian);
+            break;
+        case UBJsonValueType::UINT_16:
+            writeIntegerAsImpl<uint16_t>(buffer, value, littleEndian);
+            break;
+        case UBJsonValueType::UINT_32:
+            writeIntegerAsImpl<uint32_t>(buffer, value, littleEndian);
+            break;
+        case UBJsonValueType::UINT_64:
+            writeIntegerAsImpl<uint64_t>(buffer, value, littleEndian);
             break;
         default:
             YSON_THROW("Can't convert value to " + toString(valueType) + ".");
@@ -167,27 +238,29 @@ namespace Yson
     }
 
     template <typename T, typename U>
-    void writeFloatAsImpl(std::vector<char>& buffer, U value)
+    void writeFloatAsImpl(std::pmr::vector<char>& buffer, U value,
+                          bool littleEndian)
     {
         T tmp;
         if (assignFloat(tmp, value))
-            writeValue(buffer, tmp);
+            writeValue(buffer, tmp, littleEndian);
         else
             YSON_THROW("Value is too great or small to be converted: "
                        + std::to_string(value));
     }
 
     template <typename T>
-    void writeFloatAs(std::vector<char>& buffer, T value,
-                      UBJsonValueType valueType)
+    void writeFloatAs(std::pmr::vector<char>& buffer, T value,
+                      UBJsonValueType valueType,
+                      bool littleEndian = false)
     {
         switch (valueType)
         {
         case UBJsonValueType::FLOAT_32:
-            writeFloatAsImpl<float>(buffer, value);
+            writeFloatAsImpl<float>(buffer, value, littleEndian);
             break;
         case UBJsonValueType::FLOAT_64:
-            writeFloatAsImpl<double>(buffer, value);
+            writeFloatAsImpl<double>(buffer, value, littleEndian);
             break;
         default:
             YSON_THROW("Can't convert value to " + toString(valueType) + ".");
@@ -0,0 +1,351 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Benchmarks.hpp"
+
+#include <memory>
+#include <sstream>
+#include "Yson/Transcode.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    // Reads every value in the current document.
+    void traverse(Reader& reader, std::string& buffer) // NOLINT(*-no-recursion)
+    {
+        switch (reader.valueType())
+        {
+        case ValueType::OBJECT:
+            reader.enter();
+            while (reader.nextKey())
+            {
+                reader.read(buffer);
+                if (reader.nextValue())
+                    traverse(reader, buffer);
+            }
+            reader.leave();
+            break;
+        case ValueType::ARRAY:
+            reader.enter();
+            while (reader.nextValue())
+                traverse(reader, buffer);
+            reader.leave();
+            break;
+        case ValueType::INTEGER:
+            if (int64_t i; !reader.read(i))
+            {
+                double d;
+                reader.read(d);
+            }
+            break;
+        case ValueType::FLOAT:
+        {
+            double d;
+            reader.read(d);
+            break;
+        }
+        case ValueType::BOOLEAN:
+        {
+            bool b;
+            reader.read(b);
+            break;
+        }
+        case ValueType::NULL_VALUE:
+            break;
+        default:
+            reader.read(buffer);
+            break;
+        }
+    }
+
+    void traverseDocuments(Reader& reader)
+    {
+        std::string buffer;
+        do
+        {
+            if (reader.nextValue())
+                traverse(reader, buffer);
+        } while (reader.nextDocument());
+    }
+
+    void readItems(Reader& reader)
+    {
+        do
+        {
+            if (reader.nextValue())
+                reader.readItem();
+        } while (reader.nextDocument());
+    }
+
+    void transcodeDocuments(Reader& reader, Writer& writer)
+    {
+        do
+        {
+            transcode(reader, writer);
+        } while (reader.nextDocument());
+        writer.flush();
+    }
+
+    /**
+     * @brief A recording of all the values in a corpus, so that the
+     *  writers can be measured without the readers.
+     */
+    class Recording
+    {
+    public:
+        explicit Recording(const Corpus& corpus)
+        {
+            JsonReader reader(corpus.json.data(), corpus.json.size());
+            do
+            {
+                if (reader.nextValue())
+                    record(reader);
+            } while (reader.nextDocument());
+        }
+
+        /// Returns the number of values, not counting the ends of
+        /// objects and arrays.
+        size_t valueCount() const
+        {
+            return m_ValueCount;
+        }
+
+        void replay(Writer& writer) const
+        {
+            for (const auto& event : m_Events)
+            {
+                switch (event.type)
+                {
+                case EventType::BEGIN_OBJECT:
+                    writer.beginObject();
+                    break;
+                case EventType::END_OBJECT:
+                    writer.endObject();
+                    break;
+                case EventType::BEGIN_ARRAY:
+                    writer.beginArray();
+                    break;
+                case EventType::END_ARRAY:
+                    writer.endArray();
+                    break;
+                case EventType::KEY:
+                    writer.key(m_Strings[event.index]);
+                    break;
+                case EventType::NULL_VALUE:
+                    writer.null();
+                    break;
+                case EventType::BOOLEAN:
+                    writer.boolean(event.integer != 0);
+                    break;
+                case EventType::INTEGER:
+                    writer.value(event.integer);
+                    break;
+                case EventType::FLOAT:
+                    writer.value(event.real);
+                    break;
+                case EventType::STRING:
+                    writer.value(std::string_view(m_Strings[event.index]));
+                    break;
+                }
+            }
+            writer.flush();
+        }
+    private:
+        enum class EventType
+        {
+            BEGIN_OBJECT, END_OBJECT, BEGIN_ARRAY, END_ARRAY, KEY,
+            NULL_VALUE, BOOLEAN, INTEGER, FLOAT, STRING
+        };
+
+        struct Event
+        {
+            EventType type;
+            union
+            {
+                int64_t integer = 0;
+                double real;
+                size_t index;
+            };
+        };
+
+        void add(EventType type)
+        {
+            add(Event{type, {}});
+        }
+
+        void add(const Event& event)
+        {
+            if (event.type != EventType::END_OBJECT
+                && event.type != EventType::END_ARRAY)
+            {
+                ++m_ValueCount;
+            }
+            m_Events.push_back(event);
+        }
+
+        void addString(EventType type, JsonReader& reader)
+        {
+            Event event{type, {}};
+            event.index = m_Strings.size();
+            m_Strings.push_back(read<std::string>(reader));
+            add(event);
+        }
+
+        void record(JsonReader& reader) // NOLINT(*-no-recursion)
+        {
+            switch (reader.valueType())
+            {
+            case ValueType::OBJECT:
+                add(EventType::BEGIN_OBJECT);
+                reader.enter();
+                while (reader.nextKey())
+                {
+                    addString(EventType::KEY, reader);
+                    if (reader.nextValue())
+                        record(reader);
+                }
+                reader.leave();
+                add(EventType::END_OBJECT);
+                break;
+            case ValueType::ARRAY:
+                add(EventType::BEGIN_ARRAY);
+                reader.enter();
+                while (reader.nextValue())
+                    record(reader);
+                reader.leave();
+                add(EventType::END_ARRAY);
+                break;
+            case ValueType::NULL_VALUE:
+                add(EventType::NULL_VALUE);
+                break;
+            case ValueType::BOOLEAN:
+            {
+                Event event{EventType::BOOLEAN, {}};
+                event.integer = read<bool>(reader) ? 1 : 0;
+                add(event);
+                break;
+            }
+            case ValueType::INTEGER:
+                if (int64_t i; reader.read(i))
+                {
+                    Event event{EventType::INTEGER, {}};
+                    event.integer = i;
+                    add(event);
+                    break;
+                }
+                [[fallthrough]];
+            case ValueType::FLOAT:
+            {
+                Event event{EventType::FLOAT, {}};
+                event.real = read<double>(reader);
+                add(event);
+                break;
+            }
+            default:
+                addString(EventType::STRING, reader);
+                break;
+            }
+        }
+
+        std::vector<Event> m_Events;
+        std::vector<std::string> m_Strings;
+        size_t m_ValueCount = 0;
+    };
+
+    size_t getSize(std::ostringstream& stream)
+    {
+        return size_t(stream.tellp());
+    }
+}
+
+std::vector<Benchmark> makeBenchmarks(const Corpus& corpus)
+{
+    auto recording = std::make_shared<Recording>(corpus);
+    const auto values = recording->valueCount();
+    const auto& json = corpus.json;
+    const auto& ubjson = corpus.ubjson;
+
+    std::vector<Benchmark> result;
+    result.push_back({"json_traverse", values, [&json]
+    {
+        JsonReader reader(json.data(), json.size());
+        traverseDocuments(reader);
+        return json.size();
+    }});
+    result.push_back({"json_read_item", values, [&json]
+    {
+        JsonReader reader(json.data(), json.size());
+        readItems(reader);
+        return json.size();
+    }});
+    result.push_back({"json_make_reader", values, [&json]
+    {
+        auto reader = makeReader(json.data(), json.size());
+        traverseDocuments(*reader);
+        return json.size();
+    }});
+    result.push_back({"ubjson_traverse", values, [&ubjson]
+    {
+        UBJsonReader reader(ubjson.data(), ubjson.size());
+        traverseDocuments(reader);
+        return ubjson.size();
+    }});
+    result.push_back({"ubjson_read_item", values, [&ubjson]
+    {
+        UBJsonReader reader(ubjson.data(), ubjson.size());
+        readItems(reader);
+        return ubjson.size();
+    }});
+    result.push_back({"ubjson_make_reader", values, [&ubjson]
+    {
+        auto reader = makeReader(ubjson.data(), ubjson.size());
+        traverseDocuments(*reader);
+        return ubjson.size();
+    }});
+
+    const std::pair<const char*, JsonFormatting> formats[] = {
+        {"json_write_none", JsonFormatting::NONE},
+        {"json_write_flat", JsonFormatting::FLAT},
+        {"json_write_format", JsonFormatting::FORMAT}
+    };
+    for (auto [name, formatting] : formats)
+    {
+        result.push_back({name, values, [recording, formatting]
+        {
+            std::ostringstream stream;
+            JsonWriter writer(stream, formatting);
+            recording->replay(writer);
+            return getSize(stream);
+        }});
+    }
+    result.push_back({"ubjson_write", values, [recording]
+    {
+        std::ostringstream stream(std::ios::out | std::ios::binary);
+        UBJsonWriter writer(stream);
+        recording->replay(writer);
+        return getSize(stream);
+    }});
+
+    result.push_back({"transcode_json_to_ubjson", values, [&json]
+    {
+        JsonReader reader(json.data(), json.size());
+        std::ostringstream stream(std::ios::out | std::ios::binary);
+        UBJsonWriter writer(stream);
+        transcodeDocuments(reader, writer);
+        return json.size();
+    }});
+    result.push_back({"transcode_ubjson_to_json", values, [&ubjson]
+    {
+        UBJsonReader reader(ubjson.data(), ubjson.size());
+        std::ostringstream stream;
+        JsonWriter writer(stream, JsonFormatting::NONE);
+        transcodeDocuments(reader, writer);
+        return ubjson.size();
+    }});
+    return result;
+}
@@ -0,0 +1,30 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <functional>
+#include <string>
+#include <vector>
+#include "Corpora.hpp"
+
+struct Benchmark
+{
+    std::string name;
+    /// The number of values, including keys, objects and arrays, that
+    /// are read or written by each run.
+    size_t values = 0;
+    /// Runs the benchmark once and returns the number of bytes that were
+    /// read or written.
+    std::function<size_t()> run;
+};
+
+/**
+ * @brief Returns the benchmarks for @a corpus.
+ *
+ * The benchmarks refer to @a corpus, it must outlive them.
+ */
+std::vector<Benchmark> makeBenchmarks(const Corpus& corpus);
@@ -0,0 +1,276 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Corpora.hpp"
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include "Yson/Transcode.hpp"
+
+namespace
+{
+    constexpr size_t MEGABYTE = 1024 * 1024;
+
+    class Generator
+    {
+    public:
+        int64_t integer(int64_t min, int64_t max)
+        {
+            return std::uniform_int_distribution<int64_t>(min, max)(m_Engine);
+        }
+
+        double real(double min, double max)
+        {
+            return std::uniform_real_distribution<double>(min, max)(m_Engine);
+        }
+
+        bool boolean()
+        {
+            return integer(0, 1) == 1;
+        }
+
+        std::string word(size_t minLength, size_t maxLength)
+        {
+            auto length = size_t(integer(int64_t(minLength),
+                                         int64_t(maxLength)));
+            std::string result;
+            for (size_t i = 0; i < length; ++i)
+                result.push_back(char('a' + integer(0, 25)));
+            return result;
+        }
+
+        std::string text(size_t words)
+        {
+            static const char* const SPECIALS[] = {
+                "\"quoted\"", "tab\tbed", "line\nbreak", "back\\slash",
+                "caf\xC3\xA9", "\xE2\x82\xAC" "5", "\xF0\x9F\x98\x80"
+            };
+            std::string result;
+            for (size_t i = 0; i < words; ++i)
+            {
+                if (i != 0)
+                    result.push_back(' ');
+                if (integer(0, 15) == 0)
+                    result += SPECIALS[integer(0, std::size(SPECIALS) - 1)];
+                else
+                    result += word(1, 10);
+            }
+            return result;
+        }
+    private:
+        std::mt19937_64 m_Engine{20261018};
+    };
+
+    void writeTweet(Yson::JsonWriter& writer, Generator& gen, int64_t id)
+    {
+        writer.beginObject()
+            .key("created_at").value("Sun Oct 18 12:34:56 +0000 2026")
+            .key("id").value(id)
+            .key("id_str").value(std::to_string(id))
+            .key("text").value(gen.text(size_t(gen.integer(3, 25))))
+            .key("truncated").boolean(false)
+            .key("in_reply_to_status_id");
+        if (gen.boolean())
+            writer.null();
+        else
+            writer.value(id - gen.integer(1, 1000000));
+        writer.key("user").beginObject()
+            .key("id").value(gen.integer(1, 1LL << 40))
+            .key("name").value(gen.word(3, 15))
+            .key("screen_name").value(gen.word(3, 15))
+            .key("description").value(gen.text(size_t(gen.integer(0, 20))))
+            .key("followers_count").value(gen.integer(0, 100000))
+            .key("verified").boolean(gen.boolean())
+            .endObject();
+        writer.key("entities").beginObject()
+            .key("hashtags").beginArray();
+        for (auto n = gen.integer(0, 3); n > 0; --n)
+        {
+            writer.beginObject()
+                .key("text").value(gen.word(3, 12))
+                .key("indices").beginArray(Yson::JsonParameters(
+                    Yson::JsonFormatting::FLAT))
+                .value(gen.integer(0, 70)).value(gen.integer(70, 140))
+                .endArray()
+                .endObject();
+        }
+        writer.endArray()
+            .endObject()
+            .key("retweet_count").value(gen.integer(0, 5000))
+            .key("favorited").boolean(gen.boolean())
+            .key("lang").value("en")
+            .endObject();
+    }
+
+    std::string makeTwitter(Generator& gen, size_t size)
+    {
+        std::ostringstream stream;
+        Yson::JsonWriter writer(stream);
+        writer.beginObject().key("statuses").beginArray();
+        int64_t id = 1049000000000000000;
+        while (size_t(stream.tellp()) < size)
+        {
+            writeTweet(writer, gen, id);
+            id += gen.integer(1, 100000);
+            writer.flush();
+        }
+        writer.endArray().endObject().flush();
+        return stream.str();
+    }
+
+    std::string makeNumeric(Generator& gen, size_t size)
+    {
+        std::ostringstream stream;
+        Yson::JsonWriter writer(stream, Yson::JsonFormatting::NONE);
+        writer.beginObject()
+            .key("type").value("FeatureCollection")
+            .key("features").beginArray()
+            .beginObject()
+            .key("type").value("Feature")
+            .key("geometry").beginObject()
+            .key("type").value("Polygon")
+            .key("coordinates").beginArray();
+        while (size_t(stream.tellp()) < size)
+        {
+            writer.beginArray();
+            double lon = gen.real(-140, -50);
+            double lat = gen.real(40, 80);
+            for (int i = 0; i < 1000; ++i)
+            {
+                lon += gen.real(-0.01, 0.01);
+                lat += gen.real(-0.01, 0.01);
+                writer.beginArray().value(lon).value(lat).endArray();
+            }
+            writer.endArray().flush();
+        }
+        writer.endArray().endObject().endObject().endArray().endObject();
+        writer.flush();
+        return stream.str();
+    }
+
+    std::string makeStrings(Generator& gen, size_t size)
+    {
+        std::ostringstream stream;
+        Yson::JsonWriter writer(stream);
+        writer.beginArray();
+        while (size_t(stream.tellp()) < size)
+        {
+            writer.value(gen.text(size_t(gen.integer(1, 200))));
+            writer.flush();
+        }
+        writer.endArray().flush();
+        return stream.str();
+    }
+
+    void writeNested(Yson::JsonWriter& writer, Generator& gen, int depth)
+    {
+        if (depth == 0)
+        {
+            writer.value(gen.integer(0, 1000));
+        }
+        else if (depth % 2 == 0)
+        {
+            writer.beginObject().key(gen.word(1, 5));
+            writeNested(writer, gen, depth - 1);
+            writer.endObject();
+        }
+        else
+        {
+            writer.beginArray();
+            writeNested(writer, gen, depth - 1);
+            writer.endArray();
+        }
+    }
+
+    std::string makeNested(Generator& gen, size_t size)
+    {
+        std::ostringstream stream;
+        Yson::JsonWriter writer(stream, Yson::JsonFormatting::NONE);
+        writer.beginArray();
+        while (size_t(stream.tellp()) < size)
+        {
+            writeNested(writer, gen, int(gen.integer(50, 500)));
+            writer.flush();
+        }
+        writer.endArray().flush();
+        return stream.str();
+    }
+
+    std::string makeNdjson(Generator& gen, size_t size)
+    {
+        std::string result;
+        int64_t id = 1049000000000000000;
+        while (result.size() < size)
+        {
+            std::ostringstream stream;
+            Yson::JsonWriter writer(stream, Yson::JsonFormatting::NONE);
+            writeTweet(writer, gen, id++);
+            writer.flush();
+            result += stream.str();
+            result.push_back('\n');
+        }
+        return result;
+    }
+
+    std::string toUBJson(const std::string& json, bool isMultiDocument)
+    {
+        std::ostringstream stream(std::ios::out | std::ios::binary);
+        Yson::JsonReader reader(json.data(), json.size());
+        Yson::UBJsonWriter writer(stream);
+        if (isMultiDocument)
+        {
+            while (Yson::transcode(reader, writer))
+            {
+                if (!reader.nextDocument())
+                    break;
+            }
+        }
+        else
+        {
+            Yson::transcode(reader, writer);
+        }
+        writer.flush();
+        return stream.str();
+    }
+
+    Corpus makeCorpus(std::string name, std::string json,
+                      bool isMultiDocument = false)
+    {
+        auto ubjson = toUBJson(json, isMultiDocument);
+        return {std::move(name), std::move(json), std::move(ubjson),
+                isMultiDocument};
+    }
+}
+
+std::vector<Corpus> generateCorpora(size_t scale)
+{
+    Generator gen;
+    auto size = scale * MEGABYTE;
+    std::vector<Corpus> result;
+    result.push_back(makeCorpus("twitter", makeTwitter(gen, size)));
+    result.push_back(makeCorpus("numeric", makeNumeric(gen, size)));
+    result.push_back(makeCorpus("strings", makeStrings(gen, size)));
+    result.push_back(makeCorpus("nested", makeNested(gen, size)));
+    result.push_back(makeCorpus("ndjson", makeNdjson(gen, size), true));
+    return result;
+}
+
+Corpus loadCorpus(const std::filesystem::path& path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file)
+        throw std::runtime_error("Can't open " + path.string());
+    std::string json((std::istreambuf_iterator<char>(file)),
+                     std::istreambuf_iterator<char>());
+
+    Yson::JsonReader reader(json.data(), json.size());
+    bool isMultiDocument = reader.nextValue() && reader.nextDocument()
+                           && reader.nextValue();
+    return makeCorpus(path.stem().string(), std::move(json),
+                      isMultiDocument);
+}
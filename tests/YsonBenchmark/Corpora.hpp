@@ -0,0 +1,40 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#pragma once
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/**
+ * @brief An input document, or a sequence of documents, in both JSON and
+ *  UBJSON.
+ */
+struct Corpus
+{
+    std::string name;
+    std::string json;
+    std::string ubjson;
+    /// True if json contains several newline-separated documents.
+    bool isMultiDocument = false;
+};
+
+/**
+ * @brief Generates the built-in corpora.
+ *
+ * The corpora imitate the structure of the standard JSON benchmark files
+ * (twitter.json, canada.json etc.) and are generated with a fixed seed,
+ * so the results of different runs can be compared.
+ *
+ * @param scale Each corpus is roughly @a scale MB of JSON.
+ */
+std::vector<Corpus> generateCorpora(size_t scale);
+
+/**
+ * @brief Reads a JSON or NDJSON file and creates its UBJSON equivalent.
+ */
+Corpus loadCorpus(const std::filesystem::path& path);
@@ -0,0 +1,154 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include "Yson/JsonWriter.hpp"
+#include "YsonVersion.hpp"
+#include "Benchmarks.hpp"
+
+namespace
+{
+    const char USAGE[] =
+        "Usage: YsonBenchmark [options] [file ...]\n"
+        "\n"
+        "Measures the speed of Yson's readers and writers and writes the\n"
+        "results as JSON to stdout. Each file is added as a corpus in\n"
+        "addition to the generated ones, e.g. twitter.json or canada.json.\n"
+        "\n"
+        "Options:\n"
+        "  --scale N      Make each generated corpus about N MB (default 4).\n"
+        "  --min-time S   Repeat each benchmark for at least S seconds\n"
+        "                 (default 0.5).\n"
+        "  --filter TEXT  Only run benchmarks whose corpus or benchmark\n"
+        "                 name contains TEXT.\n"
+        "  --no-generated Don't use the generated corpora.\n";
+
+    struct Options
+    {
+        size_t scale = 4;
+        double minTime = 0.5;
+        std::string filter;
+        bool generated = true;
+        std::vector<std::string> files;
+    };
+
+    Options parseArguments(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            auto arg = std::string_view(argv[i]);
+            auto hasValue = i + 1 < argc;
+            if (arg == "--scale" && hasValue)
+                options.scale = std::stoul(argv[++i]);
+            else if (arg == "--min-time" && hasValue)
+                options.minTime = std::stod(argv[++i]);
+            else if (arg == "--filter" && hasValue)
+                options.filter = argv[++i];
+            else if (arg == "--no-generated")
+                options.generated = false;
+            else if (arg == "-h" || arg == "--help" || arg.starts_with("-"))
+                throw std::invalid_argument(USAGE);
+            else
+                options.files.emplace_back(arg);
+        }
+        return options;
+    }
+
+    struct Measurement
+    {
+        size_t iterations = 0;
+        size_t bytes = 0;
+        double seconds = 0;
+    };
+
+    Measurement measure(const Benchmark& benchmark, double minTime)
+    {
+        using Clock = std::chrono::steady_clock;
+        // Warm up caches and allocators before starting the clock.
+        benchmark.run();
+
+        Measurement result;
+        auto start = Clock::now();
+        do
+        {
+            result.bytes += benchmark.run();
+            ++result.iterations;
+            result.seconds = std::chrono::duration<double>(
+                Clock::now() - start).count();
+        } while (result.seconds < minTime);
+        return result;
+    }
+
+    bool matches(const std::string& filter, const Corpus& corpus,
+                 const Benchmark& benchmark)
+    {
+        return filter.empty()
+               || corpus.name.find(filter) != std::string::npos
+               || benchmark.name.find(filter) != std::string::npos;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        auto options = parseArguments(argc, argv);
+
+        std::vector<Corpus> corpora;
+        if (options.generated)
+            corpora = generateCorpora(options.scale);
+        for (const auto& file : options.files)
+            corpora.push_back(loadCorpus(file));
+
+        Yson::JsonWriter writer(std::cout, Yson::JsonFormatting::FORMAT);
+        writer.beginObject()
+            .key("version").value(YSON_VERSION)
+            .key("min_time").value(options.minTime)
+            .key("results").beginArray();
+        for (const auto& corpus : corpora)
+        {
+            for (const auto& benchmark : makeBenchmarks(corpus))
+            {
+                if (!matches(options.filter, corpus, benchmark))
+                    continue;
+                auto m = measure(benchmark, options.minTime);
+                auto bytesPerRun = m.bytes / m.iterations;
+                auto secondsPerRun = m.seconds / double(m.iterations);
+                writer.beginObject(Yson::JsonParameters(
+                        Yson::JsonFormatting::FLAT))
+                    .key("corpus").value(corpus.name)
+                    .key("benchmark").value(benchmark.name)
+                    .key("bytes").value(bytesPerRun)
+                    .key("values").value(benchmark.values)
+                    .key("iterations").value(m.iterations)
+                    .key("seconds").value(m.seconds)
+                    .key("mb_per_s").value(double(bytesPerRun)
+                                           / secondsPerRun / 1e6)
+                    .key("ns_per_value").value(secondsPerRun * 1e9
+                                               / double(benchmark.values))
+                    .endObject().flush();
+            }
+        }
+        writer.endArray().endObject();
+        writer.flush();
+        std::cout << std::endl;
+    }
+    catch (std::invalid_argument& ex)
+    {
+        std::cerr << ex.what();
+        return 1;
+    }
+    catch (std::exception& ex)
+    {
+        std::cerr << "Error: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
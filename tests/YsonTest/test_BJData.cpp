@@ -0,0 +1,221 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include <cstring>
+#include <sstream>
+#include "Yson/ArrayItem.hpp"
+#include "Yson/UBJsonReader.hpp"
+#include "Yson/UBJsonWriter.hpp"
+#include "Yson/YsonReaderException.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    std::string_view toStringView(const UBJsonWriter& writer)
+    {
+        auto [data, size] = writer.buffer();
+        return {static_cast<const char*>(data), size};
+    }
+
+    ReaderOptions bjdataOptions()
+    {
+        ReaderOptions options;
+        options.bjdata = true;
+        return options;
+    }
+
+    void test_WriteLittleEndian()
+    {
+        UBJsonWriter writer;
+        writer.setBJDataEnabled(true);
+        writer.beginArray()
+            .value(1000)
+            .value(static_cast<unsigned short>(40000))
+            .value(3000000000u)
+            .value(UINT64_MAX)
+            .value(1.0f)
+            .endArray();
+        Y_EQUAL(toStringView(writer),
+                std::string_view("[I\xE8\x03" "u\x40\x9C" "m\x00\x5E\xD0\xB2"
+                                 "M\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF"
+                                 "d\x00\x00\x80\x3F]", 27));
+    }
+
+    void test_ReadValues()
+    {
+        std::string doc("[I\xE8\x03" "u\x40\x9C" "m\x00\x5E\xD0\xB2"
+                        "M\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF"
+                        "h\x00\xC0" "Si\x03" "abc]", 31);
+        UBJsonReader reader(doc.data(), doc.size(), bjdataOptions());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 1000);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(reader.detailedValueType(), DetailedValueType::UINT_16);
+        Y_EQUAL(read<unsigned>(reader), 40000u);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<uint32_t>(reader), 3000000000u);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<uint64_t>(reader), UINT64_MAX);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(reader.valueType(), ValueType::FLOAT);
+        Y_EQUAL(read<double>(reader), -2.0);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "abc");
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_ReadItem()
+    {
+        std::string doc("[u\x40\x9C" "h\x00\x3C]", 8);
+        UBJsonReader reader(doc.data(), doc.size(), bjdataOptions());
+        auto item = reader.readItem();
+        Y_EQUAL(item.array().size(), 2);
+        Y_EQUAL(get<uint16_t>(item[0]), 40000);
+        Y_EQUAL(get<float>(item[1]), 1.0f);
+
+        std::string optimized("[$u#i\x02\x40\x9C\x01\x00", 10);
+        reader.reset(optimized.data(), optimized.size());
+        item = reader.readItem();
+        Y_EQUAL(item.array().size(), 2);
+        Y_EQUAL(get<uint16_t>(item[0]), 40000);
+        Y_EQUAL(get<uint16_t>(item[1]), 1);
+    }
+
+    void test_UBJsonRejectsBJDataMarkers()
+    {
+        std::string doc("u\x40\x9C", 3);
+        UBJsonReader reader(doc.data(), doc.size());
+        Y_THROWS(reader.nextValue(), YsonReaderException);
+    }
+
+    void test_NDArray()
+    {
+        const float values[] = {1, 2, 3, 4, 5, 6};
+        const size_t dimensions[] = {2, 3};
+        UBJsonWriter writer;
+        writer.setBJDataEnabled(true);
+        writer.beginArray()
+            .ndArray(UBJsonValueType::FLOAT_32, dimensions, values)
+            .value(7)
+            .endArray();
+
+        auto doc = toStringView(writer);
+        UBJsonReader reader(doc.data(), doc.size(), bjdataOptions());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        auto dims = reader.arrayDimensions();
+        Y_EQUAL(dims.size(), 2);
+        Y_EQUAL(dims[0], 2);
+        Y_EQUAL(dims[1], 3);
+        Y_EQUAL(reader.optimizedArrayProperties().first, 6);
+        std::span<const char> data;
+        Y_ASSERT(reader.readArrayData(data));
+        Y_EQUAL(data.size(), sizeof(values));
+        float result[6];
+        std::memcpy(result, data.data(), data.size());
+        for (int i = 0; i < 6; ++i)
+            Y_EQUAL(result[i], values[i]);
+        // The payload is read directly from the input buffer.
+        Y_ASSERT(data.data() > doc.data()
+                 && data.data() < doc.data() + doc.size());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 7);
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_NDArrayInTypedArray()
+    {
+        const uint8_t values[] = {1, 2};
+        const size_t dimensions[] = {2};
+        UBJsonWriter writer;
+        writer.setBJDataEnabled(true);
+        writer.beginArray(UBJsonParameters(1, UBJsonValueType::ARRAY));
+        Y_THROWS(writer.ndArray(UBJsonValueType::UINT_8, dimensions, values),
+                 YsonException);
+    }
+
+    void test_ReadLittleEndianCounts()
+    {
+        std::string doc("[$U#[I\x02\x00I\x02\x00]\x01\x02\x03\x04"
+                        "[#I\x02\x00i\x05i\x06", 25);
+        std::istringstream stream(doc);
+        UBJsonReader reader(stream, bjdataOptions());
+        Y_ASSERT(reader.nextValue());
+        auto dims = reader.arrayDimensions();
+        Y_EQUAL(dims.size(), 2);
+        Y_EQUAL(dims[0], 2);
+        Y_EQUAL(dims[1], 2);
+        uint8_t buffer[4];
+        size_t size = 4;
+        Y_ASSERT(reader.readOptimizedArray(buffer, size));
+        Y_EQUAL(size, 4);
+        Y_ASSERT(reader.nextDocument());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(reader.optimizedArrayProperties().first, 2);
+    }
+
+    void test_DimensionVectorForms()
+    {
+        std::string docs[] = {
+            "[$U#[i\x02U\x03]\x01\x02\x03\x04\x05\x06",
+            "[$U#[$i#i\x02\x02\x03\x01\x02\x03\x04\x05\x06",
+            "[$U#[#i\x02i\x02U\x03\x01\x02\x03\x04\x05\x06"
+        };
+        for (auto& doc : docs)
+        {
+            std::istringstream stream(doc);
+            UBJsonReader reader(stream, bjdataOptions());
+            Y_ASSERT(reader.nextValue());
+            Y_EQUAL(reader.arrayDimensions().size(), 2);
+            uint8_t buffer[6];
+            size_t size = 6;
+            Y_ASSERT(reader.readOptimizedArray(buffer, size));
+            Y_EQUAL(size, 6);
+            Y_EQUAL(int(buffer[5]), 6);
+        }
+    }
+
+    void test_ReadOptimizedArray()
+    {
+        for (bool bjdata : {false, true})
+        {
+            UBJsonWriter writer;
+            writer.setBJDataEnabled(bjdata);
+            writer.beginArray(UBJsonParameters(3, UBJsonValueType::INT_32))
+                .value(-1).value(0x10000).value(3)
+                .endArray();
+            auto doc = toStringView(writer);
+            ReaderOptions options;
+            options.bjdata = bjdata;
+            UBJsonReader reader(doc.data(), doc.size(), options);
+            Y_ASSERT(reader.nextValue());
+            int32_t buffer[4];
+            size_t size = 4;
+            Y_ASSERT(reader.readOptimizedArray(buffer, size));
+            Y_EQUAL(size, 3);
+            Y_EQUAL(buffer[0], -1);
+            Y_EQUAL(buffer[1], 0x10000);
+            Y_EQUAL(buffer[2], 3);
+        }
+    }
+
+    Y_TEST(test_WriteLittleEndian,
+           test_ReadValues,
+           test_ReadItem,
+           test_UBJsonRejectsBJDataMarkers,
+           test_NDArray,
+           test_NDArrayInTypedArray,
+           test_ReadLittleEndianCounts,
+           test_DimensionVectorForms,
+           test_ReadOptimizedArray);
+}
@@ -7,6 +7,8 @@
 //****************************************************************************
 #include "Yson/Common/Base64.hpp"
 
+#include "Yson/YsonException.hpp"
+
 #include "Ytest/Ytest.hpp"
 
 namespace
@@ -61,5 +63,51 @@ namespace
         Y_EQUAL_RANGES(buffer, std::vector<char>({0, 0, 0, 0}));
     }
 
-    Y_TEST(test_toBase64, test_fromBase64, test_fromBase64_raw);
+    std::vector<uint8_t> makeData(size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        uint32_t value = 12345;
+        for (auto& c : data)
+        {
+            value = value * 1103515245 + 12345;
+            c = uint8_t(value >> 16);
+        }
+        return data;
+    }
+
+    void test_RoundTrip()
+    {
+        // Long enough to exercise the vectorized loops, if enabled, as
+        // well as the scalar code handling the remainders.
+        for (size_t size = 0; size < 100; ++size)
+        {
+            auto data = makeData(size);
+            auto text = toBase64(data);
+            Y_EQUAL(text.size(), 4 * ((size + 2) / 3));
+            auto decoded = fromBase64(text);
+            Y_EQUAL(decoded.size(), size);
+            Y_EQUAL_RANGES(decoded, std::vector<char>(data.begin(),
+                                                      data.end()));
+        }
+    }
+
+    void test_InvalidCharacters()
+    {
+        auto text = toBase64(makeData(60));
+        for (size_t i = 0; i < text.size(); i += 7)
+        {
+            for (char c : {'*', '\x80', '\0'})
+            {
+                auto invalid = text;
+                invalid[i] = c;
+                Y_THROWS(fromBase64(invalid), YsonException);
+            }
+        }
+    }
+
+    Y_TEST(test_toBase64,
+           test_fromBase64,
+           test_fromBase64_raw,
+           test_RoundTrip,
+           test_InvalidCharacters);
 }
@@ -0,0 +1,117 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/BasicJsonWriter.hpp"
+
+#include <limits>
+#include <sstream>
+#include "Yson/JsonWriter.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    void writeDocument(Writer& writer)
+    {
+        writer.beginObject()
+            .key("name").value("Quote \" and tab\t")
+            .key("values").beginArray()
+                .value(1).value(-2.5).boolean(true).null()
+                .beginArray().endArray()
+                .endArray()
+            .key("empty").beginObject().endObject()
+            .key("nested").beginObject().key("a").value(10u).endObject()
+            .endObject();
+    }
+
+    template <JsonFormatting Formatting>
+    void testSameAsJsonWriter()
+    {
+        JsonWriter expected(Formatting);
+        writeDocument(expected);
+        BasicJsonWriter<Formatting> writer;
+        writeDocument(writer);
+        Y_EQUAL(writer.str(), expected.str());
+    }
+
+    void test_SameAsJsonWriter_NONE()
+    {
+        Y_CALL(testSameAsJsonWriter<JsonFormatting::NONE>());
+    }
+
+    void test_SameAsJsonWriter_FLAT()
+    {
+        Y_CALL(testSameAsJsonWriter<JsonFormatting::FLAT>());
+    }
+
+    void test_SameAsJsonWriter_FORMAT()
+    {
+        Y_CALL(testSameAsJsonWriter<JsonFormatting::FORMAT>());
+    }
+
+    void test_Stream()
+    {
+        std::ostringstream os;
+        {
+            CompactJsonWriter writer(os);
+            writer.beginArray().value(1).value("a").endArray();
+            Y_EQUAL(writer.str(), "");
+        }
+        Y_EQUAL(os.str(), R"([1,"a"])");
+    }
+
+    void test_Extensions()
+    {
+        BasicJsonWriter<JsonFormatting::NONE,
+                        JSON_NON_FINITE_FLOATS
+                        | JSON_UNQUOTED_VALUE_NAMES
+                        | JSON_ESCAPE_NON_ASCII_CHARACTERS> writer;
+        writer.beginObject()
+            .key("a").value(std::numeric_limits<double>::infinity())
+            .key("b c").value("\xC3\xA6")
+            .endObject();
+        Y_EQUAL(writer.str(), R"({a:Infinity,"b c":"\u00E6"})");
+    }
+
+    void test_NonFiniteFloatException()
+    {
+        CompactJsonWriter writer;
+        Y_THROWS(writer.value(std::numeric_limits<double>::quiet_NaN()),
+                 YsonException);
+    }
+
+    void test_MismatchedEnd()
+    {
+        CompactJsonWriter writer;
+        writer.beginArray();
+        Y_THROWS(writer.endObject(), YsonException);
+    }
+
+    void test_StructureParameters()
+    {
+        BasicJsonWriter<JsonFormatting::FLAT> writer;
+        writer.beginArray(JsonParameters(JsonFormatting::FLAT))
+            .beginObject(UBJsonParameters(2))
+            .endObject();
+        Y_THROWS(writer.beginArray(JsonParameters(JsonFormatting::NONE)),
+                 YsonException);
+        Y_THROWS(writer.beginObject(JsonParameters(4)), YsonException);
+        writer.endArray();
+        Y_EQUAL(writer.str(), "[{}]");
+    }
+
+    Y_TEST(test_SameAsJsonWriter_NONE,
+           test_SameAsJsonWriter_FLAT,
+           test_SameAsJsonWriter_FORMAT,
+           test_Stream,
+           test_Extensions,
+           test_NonFiniteFloatException,
+           test_MismatchedEnd,
+           test_StructureParameters);
+}
@@ -0,0 +1,215 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Compression.hpp"
+
+#include <filesystem>
+#include <sstream>
+#include "Yson/JsonReader.hpp"
+#include "Yson/JsonWriter.hpp"
+#include "Yson/UBJsonReader.hpp"
+#include "Yson/UBJsonWriter.hpp"
+#include "Yson/YsonException.hpp"
+#include "Yson/Common/CompressedStreams.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    constexpr int COUNT = 100000;
+
+    std::string compress(const std::string& data, Compression compression)
+    {
+        std::ostringstream os;
+        makeCompressingStream(os, compression)->write(
+            data.data(), std::streamsize(data.size()));
+        return os.str();
+    }
+
+    void writeValues(Writer& writer)
+    {
+        writer.beginArray();
+        for (int i = 0; i < COUNT; ++i)
+            writer.value(i);
+        writer.endArray();
+    }
+
+    void readValues(Reader& reader)
+    {
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        int64_t sum = 0;
+        int count = 0;
+        for (; reader.nextValue(); ++count)
+            sum += read<int>(reader);
+        reader.leave();
+        Y_EQUAL(count, COUNT);
+        Y_EQUAL(sum, int64_t(COUNT) * (COUNT - 1) / 2);
+    }
+
+    void readAll(Reader& reader)
+    {
+        reader.nextValue();
+        reader.enter();
+        while (reader.nextValue())
+        {}
+        reader.leave();
+    }
+
+    void test_DetectCompression()
+    {
+        Y_EQUAL(detectCompression("\x1F\x8B\x08", 3), Compression::GZIP);
+        Y_EQUAL(detectCompression("\x78\x9C", 2), Compression::ZLIB);
+        Y_EQUAL(detectCompression("\x78\x9D", 2), Compression::NONE);
+        Y_EQUAL(detectCompression("\x28\xB5\x2F\xFD", 4), Compression::ZSTD);
+        Y_EQUAL(detectCompression("\x1F\x8B", 2), Compression::GZIP);
+        Y_EQUAL(detectCompression("\x1F", 1), Compression::NONE);
+        Y_EQUAL(detectCompression("x", 1), Compression::NONE);
+        Y_EQUAL(detectCompression("xy", 2), Compression::NONE);
+        Y_EQUAL(detectCompression("[1]", 3), Compression::NONE);
+        Y_EQUAL(detectCompression("", 0), Compression::NONE);
+    }
+
+    void test_JsonFile()
+    {
+        if (!isCompressionSupported(Compression::GZIP))
+            return;
+        auto path = std::filesystem::temp_directory_path()
+                    / "YsonTest_Compression.json.gz";
+        {
+            JsonWriter writer(path, JsonFormatting::FLAT);
+            writeValues(writer);
+        }
+        JsonReader reader(path);
+        Y_CALL(readValues(reader));
+        auto anyReader = makeReader(path);
+        Y_ASSERT(dynamic_cast<JsonReader*>(anyReader.get()));
+        Y_CALL(readValues(*anyReader));
+        std::filesystem::remove(path);
+    }
+
+    void test_UBJsonStream()
+    {
+        if (!isCompressionSupported(Compression::ZLIB))
+            return;
+        std::ostringstream os;
+        {
+            auto stream = makeCompressingStream(os, Compression::ZLIB, 9);
+            UBJsonWriter writer(*stream);
+            writeValues(writer);
+        }
+        std::istringstream is(os.str());
+        ReaderOptions options;
+        options.detectStreamCompression = true;
+        UBJsonReader reader(is, options);
+        Y_CALL(readValues(reader));
+
+        is.clear();
+        is.seekg(0);
+        auto anyReader = makeReader(is, options);
+        Y_ASSERT(dynamic_cast<UBJsonReader*>(anyReader.get()));
+        Y_CALL(readValues(*anyReader));
+    }
+
+    void test_UBJsonBuffer_Skip()
+    {
+        if (!isCompressionSupported(Compression::GZIP))
+            return;
+        UBJsonWriter writer;
+        writer.beginArray()
+            .value(std::string(700000, 'a'))
+            .value(5)
+            .endArray();
+        auto [data, size] = writer.buffer();
+        auto compressed = compress(
+            std::string(static_cast<const char*>(data), size),
+            Compression::GZIP);
+
+        UBJsonReader reader(compressed.data(), compressed.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 5);
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_ConcatenatedMembers()
+    {
+        if (!isCompressionSupported(Compression::GZIP))
+            return;
+        auto compressed = compress("[1, ", Compression::GZIP)
+                          + compress("2]", Compression::GZIP);
+        JsonReader reader(compressed.data(), compressed.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 2);
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_TruncatedInput()
+    {
+        if (!isCompressionSupported(Compression::GZIP))
+            return;
+        auto compressed = compress("[1, 2, 3, 4]", Compression::GZIP);
+        compressed.resize(compressed.size() - 4);
+        std::istringstream is(compressed);
+        ReaderOptions options;
+        options.compression = Compression::GZIP;
+        JsonReader reader(is, options);
+        Y_THROWS(readAll(reader), YsonException);
+    }
+
+    void test_StreamsAreNotExaminedByDefault()
+    {
+        if (!isCompressionSupported(Compression::GZIP))
+            return;
+        UBJsonWriter writer;
+        writer.beginArray().value(1).endArray();
+        auto [data, size] = writer.buffer();
+        std::istringstream is(compress(
+            std::string(static_cast<const char*>(data), size),
+            Compression::GZIP));
+        // The gzip header is read as UBJSON, and isn't a valid marker.
+        UBJsonReader reader(is);
+        Y_THROWS(readAll(reader), YsonException);
+    }
+
+    void test_StreamStartingWithZlibByte()
+    {
+        // 'x' is the first byte of the zlib header, but "xy" isn't one.
+        std::istringstream is("xyz");
+        ReaderOptions options;
+        options.detectStreamCompression = true;
+        JsonReader reader(is, options);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "xyz");
+    }
+
+    void test_Uncompressed()
+    {
+        std::string doc = "[1]";
+        ReaderOptions options;
+        options.compression = Compression::NONE;
+        JsonReader reader(doc.data(), doc.size(), options);
+        Y_ASSERT(reader.nextValue());
+    }
+
+    Y_TEST(test_DetectCompression,
+           test_JsonFile,
+           test_UBJsonStream,
+           test_UBJsonBuffer_Skip,
+           test_ConcatenatedMembers,
+           test_TruncatedInput,
+           test_StreamsAreNotExaminedByDefault,
+           test_StreamStartingWithZlibByte,
+           test_Uncompressed);
+}
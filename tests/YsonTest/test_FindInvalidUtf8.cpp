@@ -0,0 +1,45 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Common/FindInvalidUtf8.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    void doFindInvalidUtf8(std::string_view str, size_t expectedOffset,
+                           bool expectedIsIncomplete = false)
+    {
+        bool isIncomplete;
+        Y_EQUAL(findInvalidUtf8(str, isIncomplete), expectedOffset);
+        Y_EQUAL(isIncomplete, expectedIsIncomplete);
+    }
+
+    void test_findInvalidUtf8()
+    {
+        Y_CALL(doFindInvalidUtf8("", 0));
+        Y_CALL(doFindInvalidUtf8("[\"abcdefghijklmnopqrstuvwxyz\"]", 30));
+        Y_CALL(doFindInvalidUtf8("abcdefgh\xC3\xA6\xE2\x82\xAC\xF0\x9F\x98\x80xyz", 20));
+        Y_CALL(doFindInvalidUtf8("abcdefghij\x80", 10));
+        // Overlong encodings.
+        Y_CALL(doFindInvalidUtf8("a\xC0\xAF", 1));
+        Y_CALL(doFindInvalidUtf8("a\xE0\x80\xAF", 1));
+        Y_CALL(doFindInvalidUtf8("a\xF0\x80\x80\xAF", 1));
+        // Surrogate and code point above U+10FFFF.
+        Y_CALL(doFindInvalidUtf8("a\xED\xA0\x80", 1));
+        Y_CALL(doFindInvalidUtf8("a\xF4\x90\x80\x80", 1));
+        Y_CALL(doFindInvalidUtf8("a\xF5\x80\x80\x80", 1));
+        // Truncated characters.
+        Y_CALL(doFindInvalidUtf8("abc\xE2\x82", 3, true));
+        Y_CALL(doFindInvalidUtf8("abc\xF0", 3, true));
+        Y_CALL(doFindInvalidUtf8("abc\xE2\x82x", 3, false));
+    }
+
+    Y_TEST(test_findInvalidUtf8);
+}
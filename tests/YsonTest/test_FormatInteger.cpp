@@ -0,0 +1,44 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Common/FormatInteger.hpp"
+
+#include <limits>
+#include <string>
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    template <typename T>
+    std::string format(T value)
+    {
+        char buffer[MAX_INTEGER_CHARACTERS];
+        return {buffer, formatInteger(buffer, value)};
+    }
+
+    void test_formatInteger()
+    {
+        Y_EQUAL(format(0), "0");
+        Y_EQUAL(format(7), "7");
+        Y_EQUAL(format(10), "10");
+        Y_EQUAL(format(-99), "-99");
+        Y_EQUAL(format(100), "100");
+        Y_EQUAL(format(12345), "12345");
+        Y_EQUAL(format(int8_t(-128)), "-128");
+        Y_EQUAL(format(uint16_t(65535)), "65535");
+        Y_EQUAL(format(std::numeric_limits<int64_t>::min()),
+                "-9223372036854775808");
+        Y_EQUAL(format(std::numeric_limits<int64_t>::max()),
+                "9223372036854775807");
+        Y_EQUAL(format(std::numeric_limits<uint64_t>::max()),
+                "18446744073709551615");
+    }
+
+    Y_TEST(test_formatInteger);
+}
@@ -0,0 +1,135 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/FragmentWriter.hpp"
+
+#include <thread>
+#include <vector>
+#include "Yson/YsonException.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    void writeElement(Writer& writer, int i)
+    {
+        writer.beginObject().key("id").value(i)
+            .key("squares").beginArray().value(i * i).endArray()
+            .endObject();
+    }
+
+    void writeExpected(Writer& writer, size_t count)
+    {
+        writer.beginArray();
+        for (size_t i = 0; i < count; ++i)
+            writeElement(writer, int(i));
+        writer.endArray();
+    }
+
+    void test_JsonArray_Threads()
+    {
+        JsonWriter expected;
+        expected.beginObject().key("items");
+        writeExpected(expected, 6);
+        expected.endObject();
+
+        JsonWriter writer;
+        writer.beginObject().key("items");
+        FragmentWriter fragments(writer, 6);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 3; ++t)
+        {
+            threads.emplace_back([&fragments, t]
+            {
+                for (int i = t; i < 6; i += 3)
+                    writeElement(fragments.fragment(i), i);
+            });
+        }
+        for (auto& thread : threads)
+            thread.join();
+        fragments.writeArray();
+        writer.endObject();
+
+        Y_EQUAL(writer.str(), expected.str());
+    }
+
+    void test_JsonObject()
+    {
+        JsonWriter writer(JsonFormatting::FLAT);
+        FragmentWriter fragments(writer, 2);
+        fragments.fragment(1, "b").value("text");
+        fragments.fragment(0, "a").beginArray().value(1).value(2).endArray();
+        fragments.writeObject();
+        Y_EQUAL(writer.str(), R"({"a": [1, 2], "b": "text"})");
+    }
+
+    void test_UBJsonArray()
+    {
+        UBJsonWriter expected;
+        expected.beginArray(UBJsonParameters(3));
+        for (int i = 0; i < 3; ++i)
+            writeElement(expected, i);
+        expected.endArray();
+
+        UBJsonWriter writer;
+        FragmentWriter fragments(writer, 3);
+        for (int i = 2; i >= 0; --i)
+            writeElement(fragments.fragment(i), i);
+        fragments.writeArray();
+
+        auto [expectedData, expectedSize] = expected.buffer();
+        auto [data, size] = writer.buffer();
+        Y_EQUAL(std::string_view(static_cast<const char*>(data), size),
+                std::string_view(static_cast<const char*>(expectedData),
+                                 expectedSize));
+    }
+
+    void test_MissingFragment()
+    {
+        JsonWriter writer;
+        FragmentWriter fragments(writer, 2);
+        fragments.fragment(0).value(1);
+        Y_THROWS(fragments.writeArray(), YsonException);
+        Y_EQUAL(writer.str(), "");
+    }
+
+    void test_BadFragments()
+    {
+        JsonWriter writer;
+        FragmentWriter fragments(writer, 3);
+        fragments.fragment(0).value(1);
+        fragments.fragment(1).value(2).value(3);
+        fragments.fragment(2).beginArray().value(4);
+        Y_THROWS(fragments.writeArray(), YsonException);
+        Y_EQUAL(writer.str(), "");
+
+        UBJsonWriter ubWriter;
+        FragmentWriter ubFragments(ubWriter, 2);
+        ubFragments.fragment(0).value(1);
+        ubFragments.fragment(1).value(2).value(3);
+        Y_THROWS(ubFragments.writeArray(), YsonException);
+        Y_EQUAL(ubWriter.buffer().second, 0);
+    }
+
+    void test_UnfinishedFragment()
+    {
+        UBJsonWriter writer;
+        FragmentWriter fragments(writer, 1);
+        fragments.fragment(0).beginObject().key("a").value(1);
+        Y_THROWS(fragments.writeObject(), YsonException);
+        Y_EQUAL(writer.buffer().second, 0);
+    }
+
+    Y_TEST(test_JsonArray_Threads,
+           test_JsonObject,
+           test_UBJsonArray,
+           test_MissingFragment,
+           test_BadFragments,
+           test_UnfinishedFragment);
+}
@@ -67,6 +67,9 @@ namespace
         Y_CALL(test("123_456.123_e456", ValueType::INVALID));
         Y_CALL(test("123_456.123e_456", ValueType::INVALID));
         Y_CALL(test("123.", ValueType::FLOAT));
+        Y_CALL(test("0.5", ValueType::FLOAT));
+        Y_CALL(test("-0.25", ValueType::FLOAT));
+        Y_CALL(test("0e1", ValueType::FLOAT));
         Y_CALL(test("-123.", ValueType::FLOAT));
         Y_CALL(test("123.a", ValueType::INVALID));
         Y_CALL(test("123.e", ValueType::INVALID));
@@ -9,6 +9,8 @@
 #include "Yson/UBJsonReader.hpp"
 
 #include <sstream>
+#include "Yson/ArrayItem.hpp"
+#include "Yson/ObjectItem.hpp"
 #include "Ytest/Ytest.hpp"
 
 namespace
@@ -47,6 +49,39 @@ namespace
         Y_ASSERT(get<int32_t>(item) == 1234);
     }
 
+    void test_numberItems()
+    {
+        std::string doc = R"([0x10, 18446744073709551615, -300, 2.5, "ab", "\n", "12"])";
+        JsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        Y_EQUAL(get<int>(item[0]), 16);
+        Y_THROWS(get<double>(item[0]), YsonException);
+        Y_EQUAL(get<uint64_t>(item[1]), UINT64_MAX);
+        Y_THROWS(get<int64_t>(item[1]), YsonException);
+        Y_EQUAL(get<int16_t>(item[2]), -300);
+        Y_EQUAL(get<double>(item[2]), -300.0);
+        Y_THROWS(get<int8_t>(item[2]), YsonException);
+        Y_THROWS(get<uint32_t>(item[2]), YsonException);
+        Y_EQUAL(get<float>(item[3]), 2.5f);
+        Y_EQUAL(get<long double>(item[3]), 2.5L);
+        Y_THROWS(get<int>(item[3]), YsonException);
+        Y_EQUAL(get<std::string>(item[4]), "ab");
+        Y_EQUAL(get<char>(item[5]), '\n');
+        Y_EQUAL(get<int>(item[6]), 12);
+        Y_EQUAL(item[6].value().valueType(), ValueType::STRING);
+        Y_EQUAL(item[6].value().valueType(true), ValueType::INTEGER);
+    }
+
+    void test_invalid_escape_sequence()
+    {
+        std::string doc = R"({"ok": 1, "bad": "\u12"})";
+        JsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        Y_EQUAL(get<int>(item["ok"]), 1);
+        Y_THROWS(get<std::string>(item["bad"]), YsonException);
+        Y_THROWS(get<char>(item["bad"]), YsonException);
+    }
+
     void test_ub_readItem_basics()
     {
         std::string doc("{i\x03KeySi\x0CHello world!"
@@ -58,6 +93,20 @@ namespace
         Y_ASSERT(get<int>(item["Array"][1]) == 240);
     }
 
+    void test_ub_numberItems()
+    {
+        std::string doc("[I\xFF\x38" "d\x40\x20\x00\x00" "C\x41" "L\x01\x00\x00\x00\x00\x00\x00\x00]", 21);
+        UBJsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        Y_EQUAL(get<int>(item[0]), -200);
+        Y_EQUAL(get<double>(item[0]), -200.0);
+        Y_THROWS(get<int8_t>(item[0]), YsonException);
+        Y_EQUAL(get<float>(item[1]), 2.5f);
+        Y_EQUAL(get<char>(item[2]), 'A');
+        Y_EQUAL(get<std::string>(item[2]), "A");
+        Y_EQUAL(get<int64_t>(item[3]), int64_t(1) << 56);
+    }
+
     void test_ub_binary_item()
     {
         const char doc[] = "[$i#i\4AB D";
@@ -80,8 +129,37 @@ namespace
         Y_ASSERT(buffer == "AB D");
     }
 
+    void test_items_from_std_containers()
+    {
+        std::string doc = R"([1, "two"])";
+        JsonReader reader(doc.data(), doc.size());
+        auto array = reader.readItem();
+
+        std::vector<JsonItem> values(array.array().begin(),
+                                     array.array().end());
+        ArrayItem arrayItem(values);
+        Y_EQUAL(arrayItem.size(), 2);
+        std::vector<JsonItem> copy = arrayItem.values();
+        Y_EQUAL(get<int>(copy[0]), 1);
+
+        std::deque<std::string> keys = {"a", "b"};
+        std::unordered_map<std::string_view, JsonItem> map;
+        map.emplace(keys[0], values[0]);
+        map.emplace(keys[1], values[1]);
+        JsonItem item(std::make_shared<ObjectItem>(keys, map));
+        Y_EQUAL(get<int>(item["a"]), 1);
+        Y_EQUAL(get<std::string>(item["b"]), "two");
+        std::deque<std::string> itemKeys = item.object().keys();
+        Y_EQUAL(itemKeys.size(), 2);
+        Y_EQUAL(itemKeys[1], "b");
+    }
+
     Y_TEST(test_readItem_basics,
            test_integerItem,
+           test_numberItems,
+           test_invalid_escape_sequence,
            test_ub_readItem_basics,
-           test_ub_binary_item);
+           test_ub_numberItems,
+           test_ub_binary_item,
+           test_items_from_std_containers);
 }
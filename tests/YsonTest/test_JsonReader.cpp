@@ -8,13 +8,41 @@
 #include "Yson/JsonReader.hpp"
 
 #include <cmath>
+#include <memory_resource>
+#include <optional>
 #include <sstream>
+#include "Yson/ReaderStats.hpp"
+#include "Yson/Common/Base64.hpp"
 #include "Ytest/Ytest.hpp"
 
 namespace
 {
     using namespace Yson;
 
+    class CountingResource : public std::pmr::memory_resource
+    {
+    public:
+        size_t allocations = 0;
+    private:
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+            ++allocations;
+            return std::pmr::new_delete_resource()->allocate(bytes,
+                                                             alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+
+        [[nodiscard]]
+        bool do_is_equal(const memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
     void test_Basics()
     {
         char text[] = R"({"key": 123, "key2": "value"})";
@@ -414,6 +442,67 @@ namespace
         Y_CALL(runScript(R"([1, 2/*, 3*/, 4])", "ve vIvIvI! l!"));
     }
 
+    void test_readArray_vector()
+    {
+        std::string text = R"({"a": [1.5, -2, 3e2, 16], "b": 1})";
+        JsonReader reader(text.data(), text.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(reader.nextValue());
+        std::vector<double> values;
+        Y_ASSERT(reader.readArray(values));
+        Y_EQUAL_RANGES(values, std::vector<double>({1.5, -2, 300, 16}));
+        Y_EQUAL(reader.state(), ReaderState::AFTER_VALUE);
+        Y_ASSERT(reader.nextKey());
+        Y_EQUAL(read<std::string>(reader), "b");
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(!reader.readArray(values));
+        Y_ASSERT(values.empty());
+        double buffer[1];
+        size_t size = 1;
+        Y_ASSERT(!reader.readArray(buffer, size));
+        Y_EQUAL(size, 0);
+        Y_EQUAL(read<int>(reader), 1);
+    }
+
+    void test_readArray_fallback()
+    {
+        std::string text = R"([1, 2, "x", 4])";
+        JsonReader reader(text.data(), text.size());
+        Y_ASSERT(reader.nextValue());
+        std::vector<int32_t> values;
+        Y_ASSERT(!reader.readArray(values));
+        Y_EQUAL_RANGES(values, std::vector<int32_t>({1, 2}));
+        Y_EQUAL(reader.scope(), "[");
+        Y_EQUAL(read<std::string>(reader), "x");
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int32_t>(reader), 4);
+        Y_ASSERT(!reader.nextValue());
+        reader.leave();
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_readArray_buffer()
+    {
+        std::string text = R"([[], [10, 20, 30]])";
+        JsonReader reader(text.data(), text.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        int64_t buffer[2];
+        size_t size = 2;
+        Y_ASSERT(reader.readArray(buffer, size));
+        Y_EQUAL(size, 0);
+        Y_ASSERT(reader.nextValue());
+        size = 2;
+        Y_ASSERT(!reader.readArray(buffer, size));
+        Y_EQUAL(size, 2);
+        Y_EQUAL(buffer[0], 10);
+        Y_EQUAL(buffer[1], 20);
+        Y_EQUAL(read<int64_t>(reader), 30);
+    }
+
     void test_document()
     {
         Y_CALL(runScript(R"({"a":2})", "d^"));
@@ -497,6 +586,469 @@ namespace
         Y_ASSERT(!reader.nextDocument());
     }
 
+    void test_reset()
+    {
+        std::string text1 = R"({"a": [1, 2]})";
+        JsonReader reader(text1.data(), text1.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextKey());
+
+        std::string text2 = "\xEF\xBB\xBF[3]";
+        reader.reset(text2.data(), text2.size());
+        Y_EQUAL(reader.state(), ReaderState::INITIAL_STATE);
+        Y_EQUAL(reader.scope(), "");
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 3);
+        Y_EQUAL(reader.columnNumber(), 3);
+
+        std::istringstream ss("\n\"abc\"");
+        reader.reset(ss);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "abc");
+        Y_EQUAL(reader.lineNumber(), 2);
+
+        std::istringstream ss2("12 13");
+        reader.reset(ss2);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 12);
+        Y_ASSERT(reader.nextDocument());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 13);
+
+        JsonReader emptyReader;
+        emptyReader.reset(text1.data(), text1.size());
+        Y_ASSERT(emptyReader.nextValue());
+    }
+
+    void test_options_chunk_size()
+    {
+        std::string longString(1000, 'x');
+        std::istringstream ss("[\"" + longString + "\", 12345]");
+        ReaderOptions options;
+        options.chunkSize = 4;
+        options.maxChunkSize = 64;
+        JsonReader reader(ss, options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), longString);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 12345);
+    }
+
+    void test_readStringChunk()
+    {
+        std::string escaped, unescaped;
+        for (int i = 0; i < 200; ++i)
+        {
+            escaped += "ab\\n\\u00E6\\uD83D\\uDE00\xE2\x82\xAC\\\n\\\"";
+            unescaped += "ab\n\xC3\xA6\xF0\x9F\x98\x80\xE2\x82\xAC\"";
+        }
+        std::istringstream ss("[\"" + escaped + "\", 12345]");
+        ReaderOptions options;
+        options.chunkSize = 16;
+        JsonReader reader(ss, options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        std::string result, chunk;
+        size_t chunks = 0;
+        while (reader.readStringChunk(chunk))
+        {
+            result += chunk;
+            ++chunks;
+        }
+        Y_EQUAL(result, unescaped);
+        Y_ASSERT(chunks > 100);
+        Y_THROWS(read<std::string>(reader), YsonReaderException);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 12345);
+        Y_EQUAL(reader.lineNumber(), 201);
+    }
+
+    void test_readStringChunks_short_string()
+    {
+        std::string text = R"(["a\tb", ""])";
+        JsonReader reader(text.data(), text.size());
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(!reader.readStringChunks([](std::string_view) {}));
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        std::vector<std::string> chunks;
+        Y_ASSERT(reader.readStringChunks([&](std::string_view chunk)
+                                         {
+                                             chunks.emplace_back(chunk);
+                                         }));
+        Y_EQUAL(chunks.size(), 1);
+        Y_EQUAL(chunks[0], "a\tb");
+        Y_ASSERT(reader.nextValue());
+        chunks.clear();
+        Y_ASSERT(reader.readStringChunks([&](std::string_view chunk)
+                                         {
+                                             chunks.emplace_back(chunk);
+                                         }));
+        Y_ASSERT(chunks.empty());
+    }
+
+    void test_skip_long_string()
+    {
+        std::string longString(10000, 'x');
+        std::string text = "[\"" + longString + "\", \"" + longString
+                           + "\", 12345]";
+        std::istringstream ss(text);
+        ReaderStats stats;
+        ReaderOptions options;
+        options.chunkSize = 64;
+        options.stats = &stats;
+        JsonReader reader(ss, options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(reader.nextValue());
+        std::string chunk;
+        Y_ASSERT(reader.readStringChunk(chunk));
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 12345);
+        Y_EQUAL(reader.columnNumber(), text.size());
+        Y_EQUAL(stats.stringTokens, 2);
+        Y_ASSERT(stats.bytesMoved < 1000);
+
+        // The maximum token size still applies to the entire string.
+        options.maxTokenSize = 1000;
+        std::istringstream ss2(text);
+        JsonReader reader2(ss2, options);
+        Y_ASSERT(reader2.nextValue());
+        reader2.enter();
+        Y_ASSERT(reader2.nextValue());
+        Y_THROWS(reader2.nextValue(), YsonReaderException);
+    }
+
+    void test_readBase64Chunks()
+    {
+        std::vector<char> data(1000);
+        for (size_t i = 0; i < data.size(); ++i)
+            data[i] = char(i * 7);
+        for (size_t size : {size_t(1000), size_t(999), size_t(998)})
+        {
+            auto text = "[\"" + toBase64(data.data(), size) + "\"]";
+            std::istringstream ss(text);
+            ReaderOptions options;
+            options.chunkSize = 30;
+            JsonReader reader(ss, options);
+            Y_ASSERT(reader.nextValue());
+            reader.enter();
+            Y_ASSERT(reader.nextValue());
+            std::vector<char> result;
+            Y_ASSERT(reader.readBase64Chunks([&](std::span<const char> chunk)
+                                             {
+                                                 result.insert(result.end(),
+                                                               chunk.begin(),
+                                                               chunk.end());
+                                             }));
+            Y_EQUAL_RANGES(result, std::vector<char>(data.begin(),
+                                                     data.begin() + size));
+            Y_ASSERT(!reader.nextValue());
+        }
+
+        // Invalid characters and padding that isn't at the end are errors,
+        // like they are for readBase64.
+        auto valid = toBase64(data.data(), 100);
+        auto padded = toBase64(data.data(), 98);
+        for (const auto& text : {valid.substr(0, 50) + "!" + valid.substr(51),
+                                 padded + valid})
+        {
+            std::istringstream ss("\"" + text + "\"");
+            ReaderOptions options;
+            options.chunkSize = 30;
+            JsonReader reader(ss, options);
+            Y_ASSERT(reader.nextValue());
+            Y_THROWS(reader.readBase64Chunks([](std::span<const char>) {}),
+                     YsonException);
+        }
+    }
+
+    void test_options_max_token_size()
+    {
+        std::string text = R"(["abc", "abcdefghijk"])";
+        ReaderOptions options;
+        options.maxTokenSize = 8;
+        JsonReader reader(text.data(), text.size(), options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_THROWS(reader.nextValue(), YsonReaderException);
+    }
+
+    void test_options_encoding()
+    {
+        std::string text("[\x00" "1\x00" "]\x00", 6);
+        ReaderOptions options;
+        options.encoding = TextEncoding::UTF_16_LE;
+        JsonReader reader(text.data(), text.size(), options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 1);
+    }
+
+    void test_options_stats()
+    {
+        std::string text = R"({"a": [1, "x\ny", true], "b": {}})";
+        std::istringstream ss(text);
+        ReaderStats stats;
+        ReaderOptions options;
+        options.chunkSize = 8;
+        options.stats = &stats;
+        JsonReader reader(ss, options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "x\ny");
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(!reader.nextValue());
+        reader.leave();
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(!reader.nextKey());
+        reader.leave();
+        Y_ASSERT(!reader.nextValue());
+
+        Y_EQUAL(stats.bytesRead, text.size());
+        Y_ASSERT(stats.bufferRefills > 1);
+        Y_ASSERT(stats.bytesMoved > 0);
+        Y_EQUAL(stats.objectTokens, 2);
+        Y_EQUAL(stats.arrayTokens, 1);
+        Y_EQUAL(stats.stringTokens, 3);
+        Y_EQUAL(stats.valueTokens, 2);
+        Y_EQUAL(stats.unescapeCalls, 1);
+        Y_EQUAL(stats.maxScopeDepth, 2);
+    }
+
+    void test_options_memory_resource()
+    {
+        CountingResource resource;
+        ReaderOptions options;
+        options.memoryResource = &resource;
+        std::string text = R"({"a": [1, "bcdefghijklmnopqrstuvwxyz"], "b": {}})";
+        std::optional<JsonItem> item;
+        {
+            JsonReader reader(text.data(), text.size(), options);
+            item = reader.readItem();
+        }
+        Y_ASSERT(resource.allocations > 0);
+        // The items must still be valid after the reader is gone.
+        Y_EQUAL(get<std::string>((*item)["a"][1]),
+                "bcdefghijklmnopqrstuvwxyz");
+        Y_ASSERT((*item)["a"].array().pmrValues().get_allocator().resource()
+                 == &resource);
+    }
+
+    void test_options_validate_utf8()
+    {
+        ReaderOptions options;
+        options.validateUtf8 = true;
+        options.chunkSize = 4;
+
+        // The characters are split between chunks.
+        std::string valid = "[\"\xC3\xA6\xE2\x82\xAC\xF0\x9F\x98\x80\"]";
+        std::istringstream validStream(valid);
+        JsonReader reader(validStream, options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), valid.substr(2, 9));
+
+        std::string invalid = "[\"ab\",\n \"c\xC0\xAF\"]";
+        std::istringstream invalidStream(invalid);
+        reader = JsonReader(invalidStream, options);
+        try
+        {
+            Y_ASSERT(reader.nextValue());
+            reader.enter();
+            while (reader.nextValue())
+            {}
+            Y_FATAL_FAILURE("No exception");
+        }
+        catch (YsonReaderException& ex)
+        {
+            Y_EQUAL(ex.offset, 10);
+            Y_EQUAL(ex.line, 2);
+            Y_EQUAL(ex.column, 4);
+        }
+
+        std::string truncated = "[\"\xE2\x82";
+        reader = JsonReader(truncated.data(), truncated.size(), options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        try
+        {
+            reader.nextValue();
+            Y_FATAL_FAILURE("No exception");
+        }
+        catch (YsonReaderException& ex)
+        {
+            Y_EQUAL(ex.offset, 2);
+        }
+
+        // Validation is opt-in.
+        reader = JsonReader(invalid.data(), invalid.size());
+        Y_ASSERT(reader.nextValue());
+    }
+
+    template <typename Op>
+    bool feedUntilDone(JsonReader& reader, Op op,
+                       const std::string& text, size_t& pos, size_t n)
+    {
+        while (true)
+        {
+            auto result = op();
+            if (!reader.needsMoreData())
+                return result;
+            if (pos < text.size())
+            {
+                auto size = std::min(n, text.size() - pos);
+                reader.feed(&text[pos], size);
+                pos += size;
+            }
+            else
+            {
+                reader.finishFeed();
+            }
+        }
+    }
+
+    void test_push_mode()
+    {
+        std::string text = R"({"key": [1, 23, "abc"], "k2": true} 7)";
+        JsonReader reader{ReaderOptions()};
+        size_t pos = 0;
+        auto nextValue = [&] {return reader.nextValue();};
+        auto nextKey = [&] {return reader.nextKey();};
+        auto nextDocument = [&] {return reader.nextDocument();};
+
+        Y_ASSERT(!reader.nextValue());
+        Y_ASSERT(reader.needsMoreData());
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        reader.enter();
+        Y_ASSERT(feedUntilDone(reader, nextKey, text, pos, 1));
+        Y_EQUAL(read<std::string>(reader), "key");
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        reader.enter();
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        Y_EQUAL(read<int>(reader), 1);
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        Y_EQUAL(read<int>(reader), 23);
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        Y_EQUAL(read<std::string>(reader), "abc");
+        Y_ASSERT(!feedUntilDone(reader, nextValue, text, pos, 1));
+        reader.leave();
+        Y_ASSERT(feedUntilDone(reader, nextKey, text, pos, 1));
+        Y_EQUAL(read<std::string>(reader), "k2");
+        Y_EQUAL(reader.columnNumber(), 29);
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        Y_EQUAL(read<bool>(reader), true);
+        Y_ASSERT(!feedUntilDone(reader, nextKey, text, pos, 1));
+        reader.leave();
+        Y_ASSERT(feedUntilDone(reader, nextDocument, text, pos, 1));
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        Y_EQUAL(read<int>(reader), 7);
+        Y_ASSERT(!feedUntilDone(reader, nextDocument, text, pos, 1));
+    }
+
+    void test_push_mode_leave_and_readArray()
+    {
+        std::string text = R"([[1.5, 2.5, 3.5], {"a": [1, 2]}, 4])";
+        JsonReader reader{ReaderOptions()};
+        size_t pos = 0;
+        auto nextValue = [&] {return reader.nextValue();};
+        std::vector<double> values;
+        auto readArray = [&] {return reader.readArray(values);};
+        auto leave = [&] {reader.leave(); return true;};
+
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 3));
+        reader.enter();
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 3));
+        Y_ASSERT(feedUntilDone(reader, readArray, text, pos, 3));
+        Y_EQUAL_RANGES(values, std::vector<double>({1.5, 2.5, 3.5}));
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 3));
+        reader.enter();
+        feedUntilDone(reader, leave, text, pos, 3);
+        Y_EQUAL(reader.scope(), "[");
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 3));
+        Y_EQUAL(read<int>(reader), 4);
+    }
+
+    void test_push_mode_tryReadItem()
+    {
+        std::string text = R"({"a": [1, {"b": "x\"yz"}, []], "c": 2} 3)";
+        JsonReader reader{ReaderOptions()};
+        size_t pos = 0;
+        std::optional<JsonItem> item;
+        auto readItem = [&] {item = reader.tryReadItem(); return true;};
+
+        Y_ASSERT(!reader.tryReadItem());
+        Y_ASSERT(reader.needsMoreData());
+        feedUntilDone(reader, readItem, text, pos, 1);
+        Y_ASSERT(item.has_value());
+        Y_EQUAL(item->object().keys().size(), 2);
+        Y_EQUAL(get<int>((*item)["a"][0]), 1);
+        Y_EQUAL(get<std::string>((*item)["a"][1]["b"]), "x\"yz");
+        Y_EQUAL((*item)["a"][2].array().values().size(), 0);
+        Y_EQUAL(get<int>((*item)["c"]), 2);
+
+        auto nextDocument = [&] {return reader.nextDocument();};
+        Y_ASSERT(feedUntilDone(reader, nextDocument, text, pos, 1));
+        feedUntilDone(reader, readItem, text, pos, 1);
+        Y_EQUAL(get<int>(*item), 3);
+    }
+
+    void test_push_mode_readItem_keeps_progress()
+    {
+        std::string text = R"([1, [2, 3], 4])";
+        JsonReader reader{ReaderOptions()};
+        reader.feed(text.data(), 8);
+        Y_THROWS(reader.readItem(), YsonReaderException);
+        Y_ASSERT(reader.needsMoreData());
+        reader.feed(text.data() + 8, text.size() - 8);
+        reader.finishFeed();
+        auto item = reader.readItem();
+        Y_EQUAL(item.array().values().size(), 3);
+        Y_EQUAL(get<int>(item[1][1]), 3);
+    }
+
+    void test_push_mode_long_string()
+    {
+        std::string value(100000, 'a');
+        for (size_t i = 0; i < value.size(); i += 1000)
+            value.replace(i, 6, "\\u00E6");
+        std::string text = "[\"" + value + "\", 1]";
+        ReaderStats stats;
+        ReaderOptions options;
+        options.stats = &stats;
+        JsonReader reader(options);
+        size_t pos = 0;
+        auto nextValue = [&] {return reader.nextValue();};
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 1));
+        reader.enter();
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 7));
+        auto str = read<std::string>(reader);
+        Y_EQUAL(str.size(), 99600);
+        Y_EQUAL(str.substr(0, 3), "\xC3\xA6" "a");
+        Y_ASSERT(feedUntilDone(reader, nextValue, text, pos, 7));
+        Y_ASSERT(!feedUntilDone(reader, nextValue, text, pos, 7));
+        // Tokens that were read again after running out of data are
+        // only counted once.
+        Y_EQUAL(stats.arrayTokens, 1);
+        Y_EQUAL(stats.stringTokens, 1);
+        Y_EQUAL(stats.valueTokens, 1);
+    }
+
     Y_TEST(test_Basics,
            test_readNull,
            test_read_base64,
@@ -510,6 +1062,9 @@ namespace
            test_read_multiline_string,
            test_read_binary,
            test_array,
+           test_readArray_vector,
+           test_readArray_fallback,
+           test_readArray_buffer,
            test_document,
            test_object,
            test_trailing_commas,
@@ -519,5 +1074,21 @@ namespace
            test_end_of_document,
            test_EscapedString,
            test_LineAndColumnNumbers,
-           test_ValuesAsStrings);
+           test_ValuesAsStrings,
+           test_reset,
+           test_options_chunk_size,
+           test_readStringChunk,
+           test_readStringChunks_short_string,
+           test_skip_long_string,
+           test_readBase64Chunks,
+           test_options_max_token_size,
+           test_options_encoding,
+           test_options_validate_utf8,
+           test_options_stats,
+           test_options_memory_resource,
+           test_push_mode,
+           test_push_mode_leave_and_readArray,
+           test_push_mode_tryReadItem,
+           test_push_mode_readItem_keeps_progress,
+           test_push_mode_long_string);
 }
@@ -199,6 +199,41 @@ namespace
         Y_ASSERT(!tokenizer.next());
     }
 
+    void testIncrementalScan(const std::string& text)
+    {
+        // Scanning a token as it arrives must give the same results as
+        // scanning all of it at once.
+        TokenScanState state;
+        for (size_t i = 1; i <= text.size(); ++i)
+        {
+            std::string_view part(text.data(), i);
+            for (bool isEndOfFile : {false, true})
+            {
+                auto stateCopy = state;
+                auto expected = nextToken(part, isEndOfFile);
+                auto result = nextToken(part, isEndOfFile, stateCopy);
+                Y_EQUAL(result.tokenType, expected.tokenType);
+                Y_EQUAL(result.endOfToken - part.data(),
+                        expected.endOfToken - part.data());
+                Y_EQUAL(result.isIncomplete, expected.isIncomplete);
+                if (!isEndOfFile)
+                    state = stateCopy;
+            }
+        }
+    }
+
+    void test_IncrementalScan()
+    {
+        Y_CALL(testIncrementalScan(R"("ab\"c\u0041\\")"));
+        Y_CALL(testIncrementalScan("\"ab\\\r\ncd\\\rx\" "));
+        Y_CALL(testIncrementalScan("\"a\tb\\\nc\""));
+        Y_CALL(testIncrementalScan("'a\"b\\'c'"));
+        Y_CALL(testIncrementalScan("12345/6 "));
+        Y_CALL(testIncrementalScan("12345//c"));
+        Y_CALL(testIncrementalScan("// comment\n"));
+        Y_CALL(testIncrementalScan("/* a * / **/ "));
+    }
+
     Y_TEST(test_Basics,
            test_StringTokens,
            test_SingleQuotedStringTokens,
@@ -209,5 +244,6 @@ namespace
            test_Whitespaces,
            test_MultilineStrings,
            test_StreamAndBuffer,
-           test_IncompleteUtf8);
+           test_IncompleteUtf8,
+           test_IncrementalScan);
 }
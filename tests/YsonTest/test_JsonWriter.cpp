@@ -7,8 +7,11 @@
 //****************************************************************************
 #include "Yson/JsonWriter.hpp"
 
+#include <array>
 #include <limits>
+#include <memory_resource>
 #include <sstream>
+#include "Yson/JsonReader.hpp"
 
 #include "Ytest/Ytest.hpp"
 
@@ -323,6 +326,55 @@ namespace
         Y_EQUAL(os.str(), "{\"Name\":\"Jan\",\"Id\":200}");
     }
 
+    void test_Stats()
+    {
+        std::ostringstream os;
+        WriterStats stats;
+        JsonWriter writer(os, JsonFormatting::NONE);
+        writer.setStats(&stats);
+        writer.beginArray().beginArray().value(1).endArray()
+                .beginObject().endObject().endArray().flush();
+        Y_EQUAL(os.str(), "[[1],{}]");
+        Y_EQUAL(stats.flushes, 1);
+        Y_EQUAL(stats.bytesFlushed, 8);
+        Y_EQUAL(stats.maxScopeDepth, 2);
+    }
+
+    void test_MemoryResource()
+    {
+        std::array<char, 256 * 1024> arena;
+        std::pmr::monotonic_buffer_resource arenaResource(
+            arena.data(), arena.size(), std::pmr::null_memory_resource());
+        JsonWriter writer(JsonFormatting::NONE, &arenaResource);
+        writer.beginArray().value(1).beginObject().key("a").value(2)
+                .endObject().endArray();
+        Y_EQUAL(writer.str(), "[1,{\"a\":2}]");
+        const std::pmr::string& str = writer.pmrStr();
+        Y_EQUAL(str, "[1,{\"a\":2}]");
+        Y_ASSERT(str.get_allocator().resource() == &arenaResource);
+    }
+
+    void test_WriteJsonItem()
+    {
+        std::string doc = R"({"b": [1.50, -0e+2, 0x1F, true, null],)"
+                          R"( "a": "x\ty\u00E6", "c": {}})";
+        JsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        JsonWriter writer(JsonFormatting::NONE);
+        writer.write(item);
+        Y_EQUAL(writer.str(),
+                R"({"b":[1.50,-0e+2,31,true,null],"a":"x\tyæ","c":{}})");
+    }
+
+    void test_WriteJsonItem_InvalidEscape()
+    {
+        std::string doc = R"({"bad": "\u12"})";
+        JsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        JsonWriter writer(JsonFormatting::NONE);
+        Y_THROWS(writer.write(item), YsonException);
+    }
+
     Y_TEST(test_Basics,
            test_EscapedString,
            test_EscapedKey,
@@ -342,5 +394,9 @@ namespace
            test_MultiLineStringsWithEscape,
            test_EscapeNonAsciiCharacters,
            test_LongWstring,
-           test_IgnoreIncreasedFormatting);
+           test_IgnoreIncreasedFormatting,
+           test_Stats,
+           test_MemoryResource,
+           test_WriteJsonItem,
+           test_WriteJsonItem_InvalidEscape);
 }
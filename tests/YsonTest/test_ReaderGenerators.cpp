@@ -0,0 +1,231 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/ReaderGenerators.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    void test_elements()
+    {
+        std::string doc = R"-([1, 2, 3, 4])-";
+        auto reader = makeReader(doc.data(), doc.size());
+        std::vector<int> values;
+        for (auto value : elements<int>(*reader))
+            values.push_back(value);
+        Y_EQUAL(values.size(), 4);
+        Y_EQUAL(values[0], 1);
+        Y_EQUAL(values[3], 4);
+        Y_EQUAL(reader->scope(), "");
+    }
+
+    void test_elements_JsonItem()
+    {
+        std::string doc = R"-([{"a": 1}, [2, 3], "b"])-";
+        auto reader = makeReader(doc.data(), doc.size());
+        std::vector<JsonItem> items;
+        for (auto& item : elements<JsonItem>(*reader))
+            items.push_back(item);
+        Y_EQUAL(items.size(), 3);
+        Y_EQUAL(get<int>(items[0]["a"]), 1);
+        Y_EQUAL(get<int>(items[1][1]), 3);
+        Y_EQUAL(get<std::string>(items[2]), "b");
+    }
+
+    void test_elements_Reader()
+    {
+        std::string doc = R"-([[1, 2], [3]])-";
+        auto reader = makeReader(doc.data(), doc.size());
+        std::vector<int> values;
+        for (auto& r : elements<Reader&>(*reader))
+        {
+            for (auto value : elements<int>(r))
+                values.push_back(value);
+        }
+        Y_EQUAL(values.size(), 3);
+        Y_EQUAL(values[2], 3);
+    }
+
+    void test_elements_error()
+    {
+        std::string doc = R"-([1, "a"])-";
+        auto reader = makeReader(doc.data(), doc.size());
+        auto gen = elements<int>(*reader);
+        auto it = gen.begin();
+        Y_EQUAL(*it, 1);
+        Y_THROWS(++it, YsonReaderException);
+    }
+
+    void test_documents()
+    {
+        std::string doc = R"-([1, 2] [3] 4)-";
+        auto reader = makeReader(doc.data(), doc.size());
+        std::vector<int> values;
+        for (auto& r : documents(*reader))
+        {
+            if (r.valueType() == ValueType::ARRAY)
+            {
+                for (auto value : elements<int>(r))
+                    values.push_back(value);
+            }
+            else
+            {
+                values.push_back(read<int>(r));
+            }
+        }
+        Y_EQUAL(values.size(), 4);
+        Y_EQUAL(values[2], 3);
+        Y_EQUAL(values[3], 4);
+    }
+
+    // A minimal eagerly started coroutine for driving AsyncGenerator.
+    struct Task
+    {
+        struct promise_type
+        {
+            Task get_return_object()
+            {
+                return {};
+            }
+
+            std::suspend_never initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            std::suspend_never final_suspend() noexcept
+            {
+                return {};
+            }
+
+            void return_void() noexcept
+            {}
+
+            void unhandled_exception()
+            {
+                throw;
+            }
+        };
+    };
+
+    // An input source that suspends on every read, the caller must
+    // resume the pending coroutine to simulate the read completing.
+    struct ChunkSource
+    {
+        std::string text;
+        size_t chunkSize = 0;
+        size_t pos = 0;
+        std::coroutine_handle<> pending = nullptr;
+
+        struct ReadAwaiter
+        {
+            ChunkSource* source;
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> handle) noexcept
+            {
+                source->pending = handle;
+            }
+
+            std::string await_resume()
+            {
+                auto size = std::min(source->chunkSize,
+                                     source->text.size() - source->pos);
+                auto result = source->text.substr(source->pos, size);
+                source->pos += size;
+                return result;
+            }
+        };
+
+        ReadAwaiter operator()()
+        {
+            return {this};
+        }
+
+        void run()
+        {
+            while (pending)
+                std::exchange(pending, {}).resume();
+        }
+    };
+
+    template <typename T>
+    Task collect(AsyncGenerator<T> gen, std::vector<T>& values, bool& done)
+    {
+        while (auto value = co_await gen.next())
+            values.push_back(*value);
+        done = true;
+    }
+
+    void test_asyncElements()
+    {
+        ChunkSource source{R"-([12, 345, 6789])-", 2};
+        JsonReader reader{ReaderOptions()};
+        std::vector<int> values;
+        bool done = false;
+        collect(asyncElements<int>(reader, [&] {return source();}),
+                values, done);
+        Y_ASSERT(!done);
+        source.run();
+        Y_ASSERT(done);
+        Y_EQUAL(values.size(), 3);
+        Y_EQUAL(values[0], 12);
+        Y_EQUAL(values[1], 345);
+        Y_EQUAL(values[2], 6789);
+    }
+
+    void test_asyncElements_JsonItem()
+    {
+        ChunkSource source{R"-([{"a": [1, 2]}, "bcd"])-", 3};
+        JsonReader reader{ReaderOptions()};
+        std::vector<JsonItem> values;
+        bool done = false;
+        collect(asyncElements<JsonItem>(reader, [&] {return source();}),
+                values, done);
+        source.run();
+        Y_ASSERT(done);
+        Y_EQUAL(values.size(), 2);
+        Y_EQUAL(get<int>(values[0]["a"][1]), 2);
+        Y_EQUAL(get<std::string>(values[1]), "bcd");
+    }
+
+    void test_asyncElements_large_JsonItem()
+    {
+        std::string text = "[[";
+        for (int i = 0; i < 20000; ++i)
+            text += std::to_string(i) + ", ";
+        text += R"("end"], {"a": 1}])";
+        ChunkSource source{text, 5};
+        JsonReader reader{ReaderOptions()};
+        std::vector<JsonItem> values;
+        bool done = false;
+        collect(asyncElements<JsonItem>(reader, [&] {return source();}),
+                values, done);
+        source.run();
+        Y_ASSERT(done);
+        Y_EQUAL(values.size(), 2);
+        Y_EQUAL(values[0].array().values().size(), 20001);
+        Y_EQUAL(get<int>(values[0][19999]), 19999);
+        Y_EQUAL(get<int>(values[1]["a"]), 1);
+    }
+
+    Y_TEST(test_elements,
+           test_elements_JsonItem,
+           test_elements_Reader,
+           test_elements_error,
+           test_documents,
+           test_asyncElements,
+           test_asyncElements_JsonItem,
+           test_asyncElements_large_JsonItem);
+}
@@ -0,0 +1,143 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Transcode.hpp"
+
+#include <sstream>
+#include "Yson/YsonException.hpp"
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    template <int N>
+    std::string S(const char (&s)[N])
+    {
+        return std::string(s, s + N - 1);
+    }
+
+    std::string toUBJson(const std::string& json)
+    {
+        std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
+        JsonReader reader(json.data(), json.size());
+        UBJsonWriter writer(stream);
+        Y_ASSERT(transcode(reader, writer));
+        writer.flush();
+        return stream.str();
+    }
+
+    std::string toJson(const std::string& ubjson)
+    {
+        std::ostringstream stream;
+        UBJsonReader reader(ubjson.data(), ubjson.size());
+        JsonWriter writer(stream, JsonFormatting::NONE);
+        Y_ASSERT(transcode(reader, writer));
+        writer.flush();
+        return stream.str();
+    }
+
+    void test_json_to_ubjson()
+    {
+        Y_EQUAL(toUBJson(R"-({"a": null, "b": [true, "x\n"]})-"),
+                S("{U\x01" "aZU\x01" "b[TSU\x02" "x\n]}"));
+    }
+
+    void test_json_to_ubjson_integer_array()
+    {
+        Y_EQUAL(toUBJson("[1, 200, 3]"), S("[$U#i\x03\x01\xC8\x03"));
+        Y_EQUAL(toUBJson("[1, -200]"), S("[$I#i\x02\x00\x01\xFF\x38"));
+        Y_EQUAL(toUBJson("[]"), S("[]"));
+    }
+
+    void test_json_to_ubjson_float_array()
+    {
+        Y_EQUAL(toUBJson("[0.5, 2.0]"),
+                S("[$D#i\x02?\xE0\x00\x00\x00\x00\x00\x00"
+                  "@\x00\x00\x00\x00\x00\x00\x00"));
+    }
+
+    void test_json_to_ubjson_mixed_arrays()
+    {
+        Y_EQUAL(toUBJson(R"-([1, 2, "a", [3]])-"),
+                S("[i\x01i\x02SU\x01" "a[$i#i\x01\x03]"));
+        Y_EQUAL(toUBJson(R"-([1, "2", null])-"),
+                S("[i\x01SU\x01" "2Z]"));
+        Y_EQUAL(toUBJson("[0.5, 1]"),
+                S("[D?\xE0\x00\x00\x00\x00\x00\x00i\x01]"));
+    }
+
+    void test_json_to_ubjson_unconvertible_number()
+    {
+        for (std::string json : {"1e400", "[1e400]", "[0.5, 1e400]"})
+        {
+            JsonReader reader(json.data(), json.size());
+            UBJsonWriter writer;
+            Y_THROWS(transcode(reader, writer), YsonException);
+        }
+    }
+
+    void test_json_to_ubjson_long_array()
+    {
+        std::string json = "[";
+        for (int i = 0; i < 5000; ++i)
+            json += std::to_string(i % 100) + ",";
+        json.back() = ']';
+        auto ubjson = toUBJson(json);
+        // Too long to be buffered and written as an optimized array.
+        Y_EQUAL(ubjson.substr(0, 3), S("[i\x00"));
+        Y_EQUAL(ubjson.back(), ']');
+        Y_EQUAL(toJson(ubjson), json);
+
+        UBJsonWriter writer;
+        writer.beginArray(UBJsonParameters(5000, UBJsonValueType::INT_8));
+        for (int i = 0; i < 5000; ++i)
+            writer.value(i % 100);
+        writer.endArray();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(toJson(std::string(static_cast<const char*>(buffer), size)),
+                json);
+    }
+
+    void test_ubjson_to_json()
+    {
+        Y_EQUAL(toJson(S("{U\x01" "a[$i#U\x03\x01\xFF\x03" "U\x01" "bSU\x01" "c}")),
+                R"-({"a":[1,-1,3],"b":"c"})-");
+    }
+
+    void test_round_trip()
+    {
+        std::string json = R"-({"a":[[1,2],{"b":[0.5,"c"]}],"d":false})-";
+        Y_EQUAL(toJson(toUBJson(json)), json);
+    }
+
+    void test_generic_overload()
+    {
+        std::string json = R"-([1, {"a": 2}] [3])-";
+        JsonReader reader(json.data(), json.size());
+        std::ostringstream stream;
+        JsonWriter writer(stream, JsonFormatting::NONE);
+        Writer& w = writer;
+        Reader& r = reader;
+        Y_ASSERT(transcode(r, w));
+        Y_ASSERT(!transcode(r, w));
+        Y_ASSERT(reader.nextDocument());
+        Y_ASSERT(transcode(r, w));
+        writer.flush();
+        Y_EQUAL(stream.str(), R"-([1,{"a":2}],[3])-");
+    }
+
+    Y_TEST(test_json_to_ubjson,
+           test_json_to_ubjson_integer_array,
+           test_json_to_ubjson_float_array,
+           test_json_to_ubjson_mixed_arrays,
+           test_json_to_ubjson_unconvertible_number,
+           test_json_to_ubjson_long_array,
+           test_ubjson_to_json,
+           test_round_trip,
+           test_generic_overload);
+}
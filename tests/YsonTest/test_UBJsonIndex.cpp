@@ -0,0 +1,179 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/UBJsonIndex.hpp"
+
+#include <sstream>
+#include "Yson/UBJsonReader.hpp"
+#include "Yson/UBJsonWriter.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    std::string makeDocument()
+    {
+        UBJsonWriter writer;
+        writer.beginObject()
+            .key("list").beginArray()
+            .value(1).value("two").beginObject().key("x").value(3).endObject()
+            .endArray()
+            .key("a/b").value(4)
+            .key("values")
+            .beginArray(UBJsonParameters(3, UBJsonValueType::INT_8))
+            .value(5).value(6).value(7)
+            .endArray()
+            .endObject();
+        auto [buffer, size] = writer.buffer();
+        return {static_cast<const char*>(buffer), size};
+    }
+
+    std::string makeRecords(int count)
+    {
+        UBJsonWriter writer;
+        writer.beginArray();
+        for (int i = 0; i < count; ++i)
+        {
+            writer.beginObject()
+                .key("id").value(i)
+                .key("name").value("record " + std::to_string(i))
+                .endObject();
+        }
+        writer.endArray();
+        auto [buffer, size] = writer.buffer();
+        return {static_cast<const char*>(buffer), size};
+    }
+
+    void test_Build()
+    {
+        auto doc = makeDocument();
+        UBJsonReader reader(doc.data(), doc.size());
+        auto index = UBJsonIndex::build(reader, 2);
+        Y_EQUAL(index.size(), 7);
+        const auto rootOffset = index.find("");
+        Y_ASSERT(rootOffset.has_value());
+        Y_EQUAL(*rootOffset, 0);
+        Y_ASSERT(index.find("/list/2"));
+        Y_ASSERT(index.find("/a~1b"));
+        Y_ASSERT(index.find("/values"));
+        // Values in optimized arrays with a value type don't have offsets.
+        Y_ASSERT(!index.find("/values/0"));
+        // Below maxDepth.
+        Y_ASSERT(!index.find("/list/2/x"));
+
+        Y_ASSERT(reader.seek(index, "/list/2"));
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextKey());
+        Y_EQUAL(read<std::string>(reader), "x");
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<int>(reader), 3);
+        reader.leave();
+        Y_ASSERT(!reader.nextValue());
+
+        Y_ASSERT(reader.seek(index, "/list/1"));
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "two");
+
+        Y_ASSERT(!reader.seek(index, "/missing"));
+    }
+
+    void test_ValueOffset()
+    {
+        auto doc = makeDocument();
+        UBJsonReader reader(doc.data(), doc.size());
+        Y_ASSERT(reader.nextValue());
+        auto offset = reader.valueOffset();
+        Y_ASSERT(offset.has_value());
+        Y_EQUAL(*offset, 0);
+        reader.enter();
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(reader.nextValue());
+        offset = reader.valueOffset();
+        Y_ASSERT(offset.has_value());
+        Y_EQUAL(*offset, 7);
+        Y_EQUAL(doc[*reader.valueOffset()], '[');
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(doc[*reader.valueOffset()], 'i');
+        Y_ASSERT(reader.nextKey());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(!reader.valueOffset());
+    }
+
+    void test_SeekInStream()
+    {
+        const int count = 1000;
+        auto doc = makeRecords(count);
+        std::istringstream stream(doc);
+        ReaderOptions options;
+        options.chunkSize = 256;
+        UBJsonReader reader(stream, options);
+        auto index = UBJsonIndex::build(reader, 2);
+        Y_EQUAL(index.size(), 1 + 3 * count);
+
+        // Backwards, so most of the records are outside the buffer.
+        for (int i = count - 1; i >= 0; i -= 97)
+        {
+            Y_ASSERT(reader.seek(index, "/" + std::to_string(i) + "/name"));
+            Y_ASSERT(reader.nextValue());
+            Y_EQUAL(read<std::string>(reader),
+                    "record " + std::to_string(i));
+            Y_ASSERT(reader.seek(index, "/" + std::to_string(i)));
+            auto item = reader.readItem();
+            Y_EQUAL(get<int>(item["id"]), i);
+        }
+    }
+
+    void test_SeekInStreamAfterPrefix()
+    {
+        const int count = 100;
+        const std::string prefix = "HEADER";
+        std::istringstream stream(prefix + makeRecords(count));
+        stream.seekg(std::streamoff(prefix.size()));
+        ReaderOptions options;
+        options.chunkSize = 64;
+        UBJsonReader reader(stream, options);
+        auto index = UBJsonIndex::build(reader, 2);
+        const auto rootOffset = index.find("");
+        Y_ASSERT(rootOffset.has_value());
+        Y_EQUAL(*rootOffset, 0);
+
+        for (int i = count - 1; i >= 0; i -= 33)
+        {
+            Y_ASSERT(reader.seek(index, "/" + std::to_string(i)));
+            auto item = reader.readItem();
+            Y_EQUAL(get<int>(item["id"]), i);
+        }
+        reader.seek(0);
+        Y_ASSERT(reader.readItem().isArray());
+    }
+
+    void test_SaveAndLoad()
+    {
+        auto doc = makeDocument();
+        UBJsonReader reader(doc.data(), doc.size());
+        auto index = UBJsonIndex::build(reader, 1);
+        Y_EQUAL(index.size(), 4);
+
+        std::stringstream stream;
+        index.save(stream);
+        auto loaded = UBJsonIndex::load(stream);
+        Y_EQUAL(loaded.size(), index.size());
+        Y_ASSERT(loaded.entries() == index.entries());
+    }
+
+    Y_TEST(test_Build,
+           test_ValueOffset,
+           test_SeekInStream,
+           test_SeekInStreamAfterPrefix,
+           test_SaveAndLoad);
+}
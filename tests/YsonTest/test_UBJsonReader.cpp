@@ -6,6 +6,10 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Yson/UBJsonReader.hpp"
+
+#include <sstream>
+#include "Yson/ArrayItem.hpp"
+#include "Yson/ReaderStats.hpp"
 #include "Ytest/Ytest.hpp"
 #include "Yson/YsonException.hpp"
 #include "Yson/Common/DefaultBufferSize.hpp"
@@ -294,11 +298,125 @@ namespace
         }
     }
 
+    void test_Reset()
+    {
+        std::string doc1("[i\x01i\x02]");
+        UBJsonReader reader(doc1.data(), doc1.size());
+        reader.setExpandOptimizedByteArraysEnabled(false);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+
+        std::string doc2("[$U#i\x02" "AB");
+        reader.reset(doc2.data(), doc2.size());
+        Y_EQUAL(reader.state(), ReaderState::INITIAL_STATE);
+        Y_ASSERT(!reader.isExpandOptimizedByteArraysEnabled());
+        auto item = reader.readItem();
+        Y_ASSERT(item.isValue());
+
+        std::stringstream ss(std::ios_base::binary | std::ios_base::in
+                             | std::ios_base::out);
+        ss.write("SU\x03" "abc", 6);
+        ss.seekg(0);
+        reader.reset(ss);
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(Yson::read<std::string>(reader), "abc");
+        Y_ASSERT(!reader.nextValue());
+
+        reader.reset(doc1.data(), doc1.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(Yson::read<int>(reader), 1);
+    }
+
+    void test_MaxTokenSize()
+    {
+        std::string doc("[SU\x03" "abcSU\x09" "abcdefghi]");
+        ReaderOptions options;
+        options.maxTokenSize = 8;
+        UBJsonReader reader(doc.data(), doc.size(), options);
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(Yson::read<std::string>(reader), "abc");
+        Y_THROWS(reader.nextValue(), YsonReaderException);
+    }
+
+    void test_MaxTokenSize_ArrayData()
+    {
+        std::string doc("[$D#l\x7F\xFF\xFF\xFF" "abcdefgh", 16);
+        ReaderOptions options;
+        options.maxTokenSize = 1024;
+        std::istringstream stream(doc);
+        UBJsonReader reader(stream, options);
+        Y_ASSERT(reader.nextValue());
+        std::span<const char> data;
+        Y_THROWS(reader.readArrayData(data), YsonReaderException);
+    }
+
+    void test_ReadItem_OptimizedArrayWithBadCount()
+    {
+        std::string doc("[$L#L\0\0\0\x40\0\0\0\0" "abc", 16);
+        for (size_t maxTokenSize : {size_t(0), size_t(1) << 20})
+        {
+            ReaderOptions options;
+            options.maxTokenSize = maxTokenSize;
+            std::istringstream stream(doc);
+            UBJsonReader reader(stream, options);
+            Y_THROWS(reader.readItem(), YsonReaderException);
+        }
+    }
+
+    void test_Stats()
+    {
+        std::string doc("{i\x01" "a[$i#i\x03" "\x01\x02\x03"
+                        "i\x01" "b[SU\x01" "xZ]}");
+        ReaderStats stats;
+        ReaderOptions options;
+        options.stats = &stats;
+        UBJsonReader reader(doc.data(), doc.size(), options);
+        auto item = reader.readItem();
+        Y_ASSERT(item.isObject());
+        Y_ASSERT(!reader.nextValue());
+
+        Y_EQUAL(stats.bytesRead, doc.size());
+        Y_EQUAL(stats.objectTokens, 1);
+        Y_EQUAL(stats.arrayTokens, 2);
+        Y_EQUAL(stats.stringTokens, 3);
+        Y_EQUAL(stats.valueTokens, 4);
+        Y_EQUAL(stats.maxScopeDepth, 2);
+    }
+
+    void test_ReadItem_OptimizedStructures()
+    {
+        std::string doc("[[$I#i\x03\x00\x01\xFF\xFE\x7F\xFF"
+                        "[#i\x02i\x05SU\x01" "a"
+                        "{$i#i\x02U\x01" "a\x01U\x01" "b\x02]", 38);
+        UBJsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        Y_EQUAL(item[0].array().size(), 3);
+        Y_EQUAL(get<int>(item[0][0]), 1);
+        Y_EQUAL(get<int>(item[0][1]), -2);
+        Y_EQUAL(get<int>(item[0][2]), 32767);
+        Y_EQUAL(item[1].array().size(), 2);
+        Y_EQUAL(get<int>(item[1][0]), 5);
+        Y_EQUAL(get<std::string>(item[1][1]), "a");
+        Y_EQUAL(get<int>(item[2]["b"]), 2);
+        Y_ASSERT(!reader.nextValue());
+    }
+
     Y_TEST(test_Basics,
            test_NextDocumentValue,
            test_Read,
            test_OptimizedArray,
            test_OptimizedObject,
            test_SkipSubstructures,
-           test_MultiBufferValue);
+           test_MultiBufferValue,
+           test_Reset,
+           test_MaxTokenSize,
+           test_MaxTokenSize_ArrayData,
+           test_ReadItem_OptimizedArrayWithBadCount,
+           test_Stats,
+           test_ReadItem_OptimizedStructures);
 }
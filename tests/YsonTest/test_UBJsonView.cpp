@@ -0,0 +1,139 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/UBJsonView.hpp"
+
+#include <vector>
+#include "Yson/UBJsonWriter.hpp"
+
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    std::string makeDocument()
+    {
+        UBJsonWriter writer;
+        writer.beginObject()
+            .key("name").value("Snorre")
+            .key("values")
+            .beginArray(UBJsonParameters(3, UBJsonValueType::INT_16))
+            .value(1).value(-2).value(1000)
+            .endArray()
+            .key("list").beginArray()
+            .value(1).value("x").null().beginArray().boolean(true).endArray()
+            .endArray()
+            .key("pi").value(3.5)
+            .key("big").value(int64_t(1) << 40)
+            .endObject();
+        auto [buffer, size] = writer.buffer();
+        return {static_cast<const char*>(buffer), size};
+    }
+
+    void test_Values()
+    {
+        auto doc = makeDocument();
+        UBJsonView view(doc.data(), doc.size());
+        Y_EQUAL(view.valueType(), ValueType::OBJECT);
+        Y_EQUAL(view.size(), 5);
+        auto name = get<std::string_view>(view["name"]);
+        Y_EQUAL(name, "Snorre");
+        // Strings are views of the buffer.
+        Y_ASSERT(name.data() > doc.data()
+                 && name.data() < doc.data() + doc.size());
+        Y_EQUAL(get<double>(view["pi"]), 3.5);
+        Y_EQUAL(get<int64_t>(view["big"]), int64_t(1) << 40);
+        Y_THROWS(get<int32_t>(view["big"]), YsonException);
+        Y_EQUAL(get<int>(view["values"][1]), -2);
+        Y_EQUAL(get<int>(view["values"][2]), 1000);
+        Y_EQUAL(view["values"].arrayData().size(), 6);
+        Y_EQUAL(get<std::string_view>(view["list"][1]), "x");
+        Y_ASSERT(view["list"][2].isNull());
+        Y_EQUAL(get<bool>(view["list"][3][0]), true);
+        Y_EQUAL(view.encodedSize(), doc.size() - 1);
+    }
+
+    void test_Iteration()
+    {
+        auto doc = makeDocument();
+        UBJsonView view(doc.data(), doc.size());
+        std::vector<std::string_view> keys;
+        for (const auto& value : view)
+            keys.push_back(value.key());
+        Y_EQUAL(keys.size(), 5);
+        Y_EQUAL(keys[0], "name");
+        Y_EQUAL(keys[4], "big");
+
+        std::vector<ValueType> types;
+        for (const auto& value : view["list"])
+            types.push_back(value.valueType());
+        Y_EQUAL(types.size(), 4);
+        Y_EQUAL(types[1], ValueType::STRING);
+        Y_EQUAL(types[3], ValueType::ARRAY);
+    }
+
+    void test_OptimizedObjectAndNoOps()
+    {
+        std::string doc("[N{$i#i\x02U\x01" "a\x01U\x01" "b\x02" "NSU\x01" "cN]",
+                        23);
+        UBJsonView view(doc.data(), doc.size());
+        Y_EQUAL(view.size(), 2);
+        Y_EQUAL(get<int>(view[0]["b"]), 2);
+        Y_EQUAL(get<std::string_view>(view[1]), "c");
+        Y_EQUAL(view.encodedSize(), doc.size() - 1);
+    }
+
+    void test_MissingValues()
+    {
+        auto doc = makeDocument();
+        UBJsonView view(doc.data(), doc.size());
+        Y_ASSERT(!view.find("nothing"));
+        Y_ASSERT(!view["values"].find(3));
+        Y_THROWS(view["nothing"], YsonException);
+        Y_THROWS(view["list"][4], YsonException);
+        Y_THROWS(view[0], YsonException);
+    }
+
+    void test_TruncatedData()
+    {
+        auto doc = makeDocument();
+        UBJsonView view(doc.data(), doc.size() - 2);
+        Y_EQUAL(get<std::string_view>(view["name"]), "Snorre");
+        Y_THROWS(get<int64_t>(view["big"]), YsonException);
+        Y_THROWS(static_cast<void>(view.encodedSize()), YsonException);
+    }
+
+    void test_TruncatedOptimizedArray()
+    {
+        std::string doc("[$i#i\x05\x01\x02", 8);
+        UBJsonView view(doc.data(), doc.size());
+        Y_THROWS(static_cast<void>(view.size()), YsonException);
+        Y_THROWS(view[4], YsonException);
+        Y_THROWS(static_cast<void>(view.encodedSize()), YsonException);
+    }
+
+    void test_OptimizedArrayOfNulls()
+    {
+        // The values take up no space, the count must not be mistaken
+        // for a number of bytes.
+        std::string doc("[$Z#i\x05", 6);
+        UBJsonView view(doc.data(), doc.size());
+        Y_EQUAL(view.size(), 5);
+        Y_ASSERT(view[4].isNull());
+        Y_ASSERT(!view.find(5));
+        Y_EQUAL(view.encodedSize(), 5);
+    }
+
+    Y_TEST(test_Values,
+           test_Iteration,
+           test_OptimizedObjectAndNoOps,
+           test_MissingValues,
+           test_TruncatedData,
+           test_TruncatedOptimizedArray,
+           test_OptimizedArrayOfNulls);
+}
@@ -6,6 +6,9 @@
 // License text is included with the source distribution.
 //****************************************************************************
 #include "Yson/UBJsonWriter.hpp"
+#include "Yson/JsonReader.hpp"
+#include "Yson/UBJsonReader.hpp"
+#include "Yson/YsonException.hpp"
 #include "Ytest/Ytest.hpp"
 
 namespace
@@ -77,6 +80,16 @@ namespace
         Y_EQUAL(stream.str(), S("[$U#i\x06" "\x01\x02\x03\x05\x08\x0E"));
     }
 
+    void test_WriteBinary_NoStream()
+    {
+        UBJsonWriter writer;
+        int8_t data[] = {1, 2, 3};
+        writer.binary(data, sizeof(data));
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("[$U#i\x03" "\x01\x02\x03"));
+    }
+
     void test_WriteString()
     {
         std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
@@ -85,11 +98,245 @@ namespace
         Y_EQUAL(stream.str(), S("SU\x06Snorre"));
     }
 
+    void test_Stats()
+    {
+        std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
+        WriterStats stats;
+        UBJsonWriter writer(stream);
+        writer.setStats(&stats);
+        writer.beginArray().beginArray().value(int8_t(1)).endArray()
+                .endArray().flush();
+        Y_EQUAL(stream.str(), S("[[i\x01]]"));
+        Y_EQUAL(stats.flushes, 1);
+        Y_EQUAL(stats.bytesFlushed, 6);
+        Y_EQUAL(stats.maxScopeDepth, 2);
+    }
+
+    void test_WriteJsonItem()
+    {
+        auto doc = S("{U\x01" "aI\x00\x05"
+                     "U\x01" "b[CxH" "U\x03" "1.5d\x3F\xC0\x00\x00]"
+                     "U\x01" "dSU\x02" "hi}");
+        UBJsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        UBJsonWriter writer;
+        writer.write(item);
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("{U\x01" "aI\x00\x05"
+                  "U\x01" "b[CxH" "U\x03" "1.5d\x3F\xC0\x00\x00]"
+                  "U\x01" "dSU\x02" "hi}"));
+    }
+
+    std::string compactArray(const std::vector<double>& values)
+    {
+        UBJsonWriter writer;
+        writer.setCompactModeEnabled(true);
+        writer.beginArray();
+        for (auto value : values)
+            writer.value(value);
+        writer.endArray();
+        auto [buffer, size] = writer.buffer();
+        return {static_cast<const char*>(buffer), size};
+    }
+
+    void test_CompactMode_Integers()
+    {
+        UBJsonWriter writer;
+        writer.setCompactModeEnabled(true);
+        writer.beginArray();
+        for (int i = 1; i <= 6; ++i)
+            writer.value(i * 40);
+        writer.endArray();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("[$U#i\x06" "\x28\x50\x78\xA0\xC8\xF0"));
+    }
+
+    void test_CompactMode_Floats()
+    {
+        Y_EQUAL(compactArray({0.5, 1.5, 2, 2.5, -2}),
+                S("[$d#i\x05" "\x3F\x00\x00\x00" "\x3F\xC0\x00\x00"
+                  "\x40\x00\x00\x00" "\x40\x20\x00\x00"
+                  "\xC0\x00\x00\x00"));
+        Y_EQUAL(compactArray({0.1, 0.2, 0.3, 0.4, 0.6}).substr(0, 6),
+                S("[$D#i\x05"));
+        // Too small to benefit from compaction.
+        Y_EQUAL(compactArray({1}), S("[d\x3F\x80\x00\x00]"));
+    }
+
+    void test_CompactMode_Object()
+    {
+        UBJsonWriter writer;
+        writer.setCompactModeEnabled(true);
+        writer.beginObject()
+            .key("a").value(1).key("b").value(-2)
+            .key("c").value(3).key("d").value(4).key("e").value(5)
+            .endObject();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("{$i#i\x05" "U\x01" "a\x01" "U\x01" "b\xFE"
+                  "U\x01" "c\x03" "U\x01" "d\x04" "U\x01" "e\x05"));
+    }
+
+    void test_CompactMode_MixedAndNested()
+    {
+        UBJsonWriter writer;
+        writer.setCompactModeEnabled(true);
+        writer.beginArray()
+            .beginArray()
+                .value("ab").value("cd").value("ef").value("gh").value("ij")
+                .endArray()
+            .beginArray().value(1).value("a").endArray()
+            .endArray();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("[[$S#i\x05" "U\x02" "abU\x02" "cdU\x02" "ef"
+                  "U\x02" "ghU\x02" "ij"
+                  "[i\x01SU\x01" "a]]"));
+    }
+
+    void test_CompactMode_IntegersAndFloats()
+    {
+        UBJsonWriter writer;
+        writer.setCompactModeEnabled(true);
+        writer.beginArray()
+            .value(1).value(2.5).value(3).value(4).value(5)
+            .endArray();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("[i\x01" "d\x40\x20\x00\x00" "i\x03" "i\x04" "i\x05]"));
+    }
+
+    void test_CompactMode_Stream()
+    {
+        std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
+        {
+            UBJsonWriter writer(stream);
+            writer.setCompactModeEnabled(true);
+            writer.beginArray();
+            for (int i = 0; i < 100000; ++i)
+                writer.value(i % 1000);
+            writer.endArray();
+        }
+        auto doc = stream.str();
+        Y_EQUAL(doc.size(), 9 + 2 * 100000);
+        UBJsonReader reader(doc.data(), doc.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        int64_t sum = 0;
+        while (reader.nextValue())
+            sum += read<int>(reader);
+        Y_EQUAL(sum, int64_t(100) * 999 * 1000 / 2);
+    }
+
+    void test_CountPatching()
+    {
+        UBJsonWriter writer;
+        writer.setCountPatchingEnabled(true);
+        writer.beginObject()
+            .key("a").beginArray().value(1).boolean(true).endArray()
+            .key("b").beginArray().endArray()
+            .endObject();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("{#L\0\0\0\0\0\0\0\x02"
+                  "U\x01" "a[#L\0\0\0\0\0\0\0\x02" "i\x01T"
+                  "U\x01" "b[#L\0\0\0\0\0\0\0\0"));
+    }
+
+    void test_CountPatching_Stream()
+    {
+        std::ostringstream stream(std::ios_base::out | std::ios_base::binary);
+        {
+            UBJsonWriter writer(stream);
+            writer.setCountPatchingEnabled(true);
+            writer.beginArray().beginArray();
+            for (int i = 0; i < 100000; ++i)
+                writer.value(i);
+            writer.endArray().value("end").endArray();
+        }
+        auto doc = stream.str();
+        Y_EQUAL(doc.substr(0, 12), S("[#L\0\0\0\0\0\0\0\x02["));
+        UBJsonReader reader(doc.data(), doc.size());
+        Y_ASSERT(reader.nextValue());
+        reader.enter();
+        Y_ASSERT(reader.nextValue());
+        Y_ASSERT(reader.nextValue());
+        Y_EQUAL(read<std::string>(reader), "end");
+        Y_ASSERT(!reader.nextValue());
+    }
+
+    void test_CountPatching_Compact()
+    {
+        UBJsonWriter writer;
+        writer.setCountPatchingEnabled(true).setCompactModeEnabled(true);
+        writer.beginArray();
+        for (int i = 0; i < 4; ++i)
+            writer.value(i);
+        writer.endArray();
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size),
+                S("[$i#i\x04" "\x00\x01\x02\x03"));
+    }
+
+    void test_CountPatching_NonSeekableStream()
+    {
+        struct NonSeekableBuffer : std::streambuf
+        {} buffer;
+        std::ostream stream(&buffer);
+        UBJsonWriter writer(stream);
+        Y_THROWS(writer.setCountPatchingEnabled(true), YsonException);
+    }
+
+    void testWriteOptimizedByteArray(const std::string& doc)
+    {
+        UBJsonReader reader(doc.data(), doc.size());
+        reader.setExpandOptimizedByteArraysEnabled(false);
+        auto item = reader.readItem();
+        Y_ASSERT(item.isValue());
+        UBJsonWriter writer;
+        writer.write(item);
+        auto [buffer, size] = writer.buffer();
+        Y_EQUAL(std::string(static_cast<const char*>(buffer), size), doc);
+    }
+
+    void test_WriteOptimizedByteArrays()
+    {
+        Y_CALL(testWriteOptimizedByteArray(S("[$i#i\x02\xFF\x01")));
+        Y_CALL(testWriteOptimizedByteArray(S("[$U#i\x02\xFF\x01")));
+        Y_CALL(testWriteOptimizedByteArray(S("[$C#i\x02" "ab")));
+    }
+
+    void test_WriteUnconvertibleNumber()
+    {
+        std::string doc = "[1e400]";
+        JsonReader reader(doc.data(), doc.size());
+        auto item = reader.readItem();
+        UBJsonWriter writer;
+        Y_THROWS(writer.write(item), YsonException);
+    }
+
     Y_TEST(test_Integer,
            test_Array,
            test_Object,
            test_Object_NoStream,
            test_OptimizedArray,
            test_WriteBinary,
-           test_WriteString);
+           test_WriteBinary_NoStream,
+           test_WriteString,
+           test_Stats,
+           test_WriteJsonItem,
+           test_CompactMode_Integers,
+           test_CompactMode_Floats,
+           test_CompactMode_Object,
+           test_CompactMode_MixedAndNested,
+           test_CompactMode_IntegersAndFloats,
+           test_CompactMode_Stream,
+           test_CountPatching,
+           test_CountPatching_Stream,
+           test_CountPatching_Compact,
+           test_CountPatching_NonSeekableStream,
+           test_WriteUnconvertibleNumber,
+           test_WriteOptimizedByteArrays);
 }
@@ -0,0 +1,98 @@
+//****************************************************************************
+// Copyright © 2026 Jan Erik Breimo. All rights reserved.
+// Created by Jan Erik Breimo on 2026-10-18.
+//
+// This file is distributed under the Zero-Clause BSD License.
+// License text is included with the source distribution.
+//****************************************************************************
+#include "Yson/Validate.hpp"
+
+#include <sstream>
+#include "Ytest/Ytest.hpp"
+
+namespace
+{
+    using namespace Yson;
+
+    void doValidateJson(std::string_view json, bool expectedValid,
+                        size_t expectedOffset = 0)
+    {
+        auto result = validateJson(json.data(), json.size());
+        Y_EQUAL(result.isValid, expectedValid);
+        if (!expectedValid)
+            Y_EQUAL(result.offset, expectedOffset);
+    }
+
+    void test_validateJson()
+    {
+        Y_CALL(doValidateJson("", true));
+        Y_CALL(doValidateJson(R"({"a": [1, 2.5, true, null], "b": {}})", true));
+        Y_CALL(doValidateJson(R"([0x1F, Infinity, -1e10, "æ\n"])", true));
+        Y_CALL(doValidateJson("{key: 'value', /* comment */ b: [1, 2,],}", true));
+        Y_CALL(doValidateJson("[1] {\"a\": 2} 3", true));
+        Y_CALL(doValidateJson("[1, 2", false, 5));
+        Y_CALL(doValidateJson("[1 2]", false, 3));
+        Y_CALL(doValidateJson("[1, 2}", false, 5));
+        Y_CALL(doValidateJson("{\"a\" 1}", false, 5));
+        Y_CALL(doValidateJson("{\"a\": 1, [2]: 3}", false, 9));
+        Y_CALL(doValidateJson("[1, 1.2.3]", false, 4));
+        Y_CALL(doValidateJson("[1, tru]", false, 4));
+        Y_CALL(doValidateJson("{1a: 2}", false, 1));
+        Y_CALL(doValidateJson(R"(["ab\u12G4"])", false, 4));
+        Y_CALL(doValidateJson("[]]", false, 2));
+    }
+
+    void test_validateJson_stream()
+    {
+        ReaderOptions options;
+        options.chunkSize = 4;
+        options.validateUtf8 = true;
+        std::istringstream valid(R"({"abc": ["defghijkl", 123456]})");
+        Y_ASSERT(validateJson(valid, options));
+        std::istringstream invalid("[\"abcdefg\xFF\"]");
+        auto result = validateJson(invalid, options);
+        Y_ASSERT(!result);
+        Y_EQUAL(result.offset, 9);
+    }
+
+    void test_validateUBJson()
+    {
+        std::string valid("{i\x03KeySi\x0CHello world!"
+                          "i\x01" "a[$i#i\x02\x01\x02}", 33);
+        Y_ASSERT(validateUBJson(valid.data(), valid.size()));
+        std::string invalid("[i\x01i", 5);
+        auto result = validateUBJson(invalid.data(), invalid.size());
+        Y_ASSERT(!result);
+        Y_EQUAL(result.offset, 5);
+        std::string unbalanced("[i\x01}", 4);
+        Y_ASSERT(!validateUBJson(unbalanced.data(), unbalanced.size()));
+    }
+
+    void test_deeply_nested()
+    {
+        // Nested deeper than the scopes ScopeStack stores inline.
+        std::string json;
+        for (int i = 0; i < 1500; ++i)
+            json += i % 2 == 0 ? "[" : "{\"a\":";
+        std::string end;
+        for (int i = 1500; i-- > 0;)
+            end += i % 2 == 0 ? "]" : "}";
+        auto valid = json + "1" + end;
+        Y_ASSERT(validateJson(valid.data(), valid.size()));
+        auto invalid = json + "1" + end.substr(1);
+        Y_ASSERT(!validateJson(invalid.data(), invalid.size()));
+
+        std::string ubjson;
+        for (int i = 0; i < 1500; ++i)
+            ubjson += i % 2 == 0 ? "[" : "{i\x01" "a";
+        valid = ubjson + "Z" + end;
+        Y_ASSERT(validateUBJson(valid.data(), valid.size()));
+        invalid = ubjson + "Z" + end.substr(1);
+        Y_ASSERT(!validateUBJson(invalid.data(), invalid.size()));
+    }
+
+    Y_TEST(test_validateJson,
+           test_validateJson_stream,
+           test_validateUBJson,
+           test_deeply_nested);
+}